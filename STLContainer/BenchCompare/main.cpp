@@ -0,0 +1,111 @@
+#include "BenchmarkCompare.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compares a benchmark run against a baseline and fails when something got slower
+// usage: BenchCompare <baseline.json> <current.json> [--threshold percent] [--alpha p] [--confidence percent]
+// exit code 0 when nothing regressed, 1 when at least one benchmark did and 2 when the arguments or files are wrong
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cerr << "usage: BenchCompare <baseline.json> <current.json> [--threshold percent] [--alpha p] [--confidence percent]\n"
+			<< "\t--threshold   smallest change that counts as a regression or improvement, default 5 (%)\n"
+			<< "\t--alpha       significance level of the Mann-Whitney U test, default 0.01\n"
+			<< "\t--confidence  confidence of the interval around the change, default 95 (%)\n";
+	}
+
+	bool ParseDouble(const char* pText, double& value)
+	{
+		char* pEnd{};
+		value = std::strtod(pText, &pEnd);
+		return pEnd != pText && *pEnd == '\0';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> files{};
+	Benchmark::CompareOptions options{};
+	for (int i{ 1 }; i < argc; ++i)
+	{
+		const std::string argument{ argv[i] };
+		if (argument.rfind("--", 0) != 0)
+		{
+			files.push_back(argument);
+			continue;
+		}
+
+		double value{};
+		if (i + 1 >= argc || !ParseDouble(argv[++i], value))
+		{
+			PrintUsage();
+			return 2;
+		}
+		if (argument == "--threshold")
+		{
+			options.threshold = value / 100.0;
+		}
+		else if (argument == "--alpha")
+		{
+			options.alpha = value;
+		}
+		else if (argument == "--confidence")
+		{
+			options.confidence = value / 100.0;
+		}
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+	if (files.size() != 2 || options.confidence <= 0.0 || options.confidence >= 1.0)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	std::vector<Benchmark::Result> baseline{};
+	std::vector<Benchmark::Result> current{};
+	std::string error{};
+	if (!Benchmark::ReadJsonFile(files[0], baseline, error) || !Benchmark::ReadJsonFile(files[1], current, error))
+	{
+		std::cerr << error << std::endl;
+		return 2;
+	}
+
+	const std::vector<Benchmark::Comparison> comparisons = Benchmark::Compare(baseline, current, options);
+	uint32_t regressions{};
+	uint32_t improvements{};
+	std::cout << std::left << std::setw(56) << "benchmark" << std::right << std::setw(14) << "baseline ns" << std::setw(14) << "current ns"
+		<< std::setw(10) << "change" << std::setw(22) << "interval" << std::setw(10) << "p" << "  verdict\n";
+	std::cout << std::fixed;
+	for (const Benchmark::Comparison& comparison : comparisons)
+	{
+		std::cout << std::left << std::setw(56) << comparison.name << std::right << std::setprecision(1);
+		if (comparison.verdict == Benchmark::Verdict::Added || comparison.verdict == Benchmark::Verdict::Removed)
+		{
+			std::cout << std::setw(14) << comparison.baselineMedian << std::setw(14) << comparison.currentMedian << std::setw(42) << ""
+				<< "  " << Benchmark::VerdictName(comparison.verdict) << "\n";
+			continue;
+		}
+
+		std::ostringstream interval{};
+		interval << std::fixed << std::setprecision(1) << std::showpos << "[" << comparison.changeLower * 100.0 << "%, " << comparison.changeUpper * 100.0 << "%]";
+		std::cout << std::setw(14) << comparison.baselineMedian << std::setw(14) << comparison.currentMedian
+			<< std::showpos << std::setw(9) << comparison.change * 100.0 << "%" << std::noshowpos << std::setw(22) << interval.str()
+			<< std::setprecision(4) << std::setw(10) << comparison.pValue << "  " << Benchmark::VerdictName(comparison.verdict) << "\n";
+		regressions += comparison.verdict == Benchmark::Verdict::Regressed ? 1 : 0;
+		improvements += comparison.verdict == Benchmark::Verdict::Improved ? 1 : 0;
+	}
+
+	std::cout << "\n" << comparisons.size() << " benchmarks, " << regressions << " regressed, " << improvements << " improved"
+		<< " (p < " << std::setprecision(3) << options.alpha << " and more than " << std::setprecision(1) << options.threshold * 100.0 << "% change)" << std::endl;
+	return regressions == 0 ? 0 : 1;
+}
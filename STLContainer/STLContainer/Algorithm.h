@@ -0,0 +1,122 @@
+#pragma once
+#include "SimdKernels.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Container
+{
+	// Index of the first element in the sorted range that isn't less than value
+	// The loop has no data dependent branch, the compiler turns the select into a cmov
+	// so a lookup costs log2(size) loads instead of log2(size) mispredicted branches
+	template<typename type, typename compare>
+	inline uint32_t LowerBound(const type* pData, uint32_t size, const type& value, compare comp)
+	{
+		if (size == 0)
+		{
+			return 0;
+		}
+
+		const type* pBase = pData;
+		uint32_t length = size;
+		while (length > 1)
+		{
+			const uint32_t half = length / 2;
+			pBase = comp(pBase[half], value) ? pBase + half : pBase;
+			length -= half;
+		}
+		return static_cast<uint32_t>(pBase - pData) + (comp(*pBase, value) ? 1 : 0);
+	}
+
+	// Types whose == compares the bits and nothing else: integers, enums and pointers. Floats don't count, 0.0 == -0.0 and NaN != NaN
+	template<typename type>
+	inline constexpr bool IsBitwiseComparable = std::is_scalar_v<type> && std::has_unique_object_representations_v<type>;
+
+	// Sets count elements from pDest on to value
+	// Trivially copyable types of 1, 2, 4 or 8 bytes go through the fill kernel of the active SimdTier
+	template<typename type>
+	constexpr void Fill(type* pDest, uint32_t count, const type& value);
+	// Index of the first element equal to value, size when there is none
+	// Bitwise comparable types of 1, 2, 4 or 8 bytes go through the find kernel of the active SimdTier
+	template<typename type>
+	_NODISCARD constexpr uint32_t Find(const type* pData, uint32_t size, const type& value);
+	// Whether both ranges of size elements are equal, bitwise comparable types go through the compare kernel of the active SimdTier
+	template<typename type>
+	_NODISCARD constexpr bool Equal(const type* pLhs, const type* pRhs, uint32_t size);
+
+	namespace Detail
+	{
+		template<typename type>
+		inline constexpr bool HasKernelSize = sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8;
+
+		template<size_t size>
+		using UnsignedOfSize = std::conditional_t<size == 1, uint8_t, std::conditional_t<size == 2, uint16_t, std::conditional_t<size == 4, uint32_t, uint64_t>>>;
+
+		// the bytes of value repeated until they fill 8 bytes, the multiplication copies them into every slot
+		template<typename type>
+		inline uint64_t RepeatPattern(const type& value)
+		{
+			UnsignedOfSize<sizeof(type)> bits;
+			std::memcpy(&bits, &value, sizeof(type));
+			constexpr uint64_t repeat = sizeof(type) == 1 ? 0x0101010101010101ull : sizeof(type) == 2 ? 0x0001000100010001ull : sizeof(type) == 4 ? 0x0000000100000001ull : 1ull;
+			return static_cast<uint64_t>(bits) * repeat;
+		}
+	}
+
+	template<typename type>
+	constexpr void Fill(type* pDest, uint32_t count, const type& value)
+	{
+		if constexpr (std::is_trivially_copyable_v<type> && Detail::HasKernelSize<type>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				Detail::BoundFillKernel()(pDest, Detail::RepeatPattern(value), static_cast<size_t>(count) * sizeof(type));
+				return;
+			}
+		}
+		for (uint32_t i{}; i < count; ++i)
+		{
+			pDest[i] = value;
+		}
+	}
+
+	template<typename type>
+	constexpr uint32_t Find(const type* pData, uint32_t size, const type& value)
+	{
+		if constexpr (IsBitwiseComparable<type> && Detail::HasKernelSize<type>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				return static_cast<uint32_t>(Detail::BoundFindKernel<Detail::UnsignedOfSize<sizeof(type)>>()(pData, Detail::RepeatPattern(value), size));
+			}
+		}
+		for (uint32_t i{}; i < size; ++i)
+		{
+			if (pData[i] == value)
+			{
+				return i;
+			}
+		}
+		return size;
+	}
+
+	template<typename type>
+	constexpr bool Equal(const type* pLhs, const type* pRhs, uint32_t size)
+	{
+		if constexpr (IsBitwiseComparable<type>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				return Detail::BoundEqualKernel()(pLhs, pRhs, static_cast<size_t>(size) * sizeof(type));
+			}
+		}
+		for (uint32_t i{}; i < size; ++i)
+		{
+			if (!(pLhs[i] == pRhs[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
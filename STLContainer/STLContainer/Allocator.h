@@ -1,7 +1,1005 @@
 #pragma once
-class Allocator final
+#include "Platform.h"
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace Container
 {
-public:
-	
-private:
-};
\ No newline at end of file
+	// Memory shared by all copies and rebinds of a PoolAllocator
+	// Every size class carves its slots out of blockSize byte slabs, freed slots go on an intrusive free list that
+	// the next allocation of that class pops, so both allocate and deallocate are O(1). Slabs only go back to the
+	// heap when the last allocator using the pool is destroyed. Not thread safe
+	template<size_t blockSize>
+	class PoolState final
+	{
+	public:
+#pragma region Deleted Functions
+		PoolState(const PoolState& other) = delete;
+		PoolState& operator=(const PoolState& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		PoolState();
+		~PoolState();
+#pragma endregion
+
+		// slots are multiples of Granularity bytes up to MaxSlotSize, bigger requests don't come from the pool
+		static constexpr size_t Granularity = 16;
+		static constexpr size_t MaxSlotSize = 512;
+
+		_NODISCARD void* Allocate(size_t size);
+		void Deallocate(void* pSlot, size_t size);
+		_NODISCARD uint32_t SlabCount() const;
+
+	private:
+		struct FreeSlot
+		{
+			FreeSlot* pNext;
+		};
+
+		struct SizeClass
+		{
+			FreeSlot* pFree;
+			char* pBump; // next never used slot of the newest slab
+			char* pBumpEnd;
+		};
+
+		static constexpr size_t m_ClassCount = MaxSlotSize / Granularity;
+		// the first bytes of every slab link it to the previous slab
+		static constexpr size_t m_SlabHeader = Granularity;
+		static_assert(blockSize >= m_SlabHeader + MaxSlotSize, "a slab has to fit at least one slot of every size class");
+
+		void NewSlab(SizeClass& sizeClass, size_t slotSize);
+
+		SizeClass m_Classes[m_ClassCount];
+		void* m_pSlabs;
+		uint32_t m_SlabCount;
+	};
+
+	// Allocator for node based containers: single objects come from a slab pool shared between all copies and rebinds,
+	// arrays and over aligned types fall back to operator new so Vector and the hash maps can use it too
+	// blockSize is the size of one slab in bytes
+	template<typename type, size_t blockSize = 64 * 1024>
+	class PoolAllocator
+	{
+	public:
+#pragma region member types
+		using value_type = type;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = PoolAllocator<otherType, blockSize>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		// every default constructed allocator starts its own pool
+		PoolAllocator();
+		PoolAllocator(const PoolAllocator& other) = default;
+		template<typename otherType>
+		PoolAllocator(const PoolAllocator<otherType, blockSize>& other);
+		PoolAllocator& operator=(const PoolAllocator& other) = default;
+		~PoolAllocator() = default;
+#pragma endregion
+
+		_NODISCARD type* allocate(size_t count);
+		void deallocate(type* pData, size_t count);
+
+		_NODISCARD const std::shared_ptr<PoolState<blockSize>>& State() const;
+
+		template<typename otherType>
+		bool operator==(const PoolAllocator<otherType, blockSize>& rhs) const;
+		template<typename otherType>
+		bool operator!=(const PoolAllocator<otherType, blockSize>& rhs) const;
+
+	private:
+		static constexpr bool m_FromPool = sizeof(type) <= PoolState<blockSize>::MaxSlotSize && alignof(type) <= PoolState<blockSize>::Granularity;
+
+		std::shared_ptr<PoolState<blockSize>> m_pState;
+	};
+
+	// Bump pointer allocator over a chain of blocks, for memory that all dies at the same time
+	// Deallocating does nothing, GetMarker and Rewind release everything allocated after a checkpoint at once
+	// Blocks past the current one are kept after a rewind and reused, they only go back to the heap in the destructor
+	// Not thread safe
+	class Arena final
+	{
+	public:
+		struct Marker
+		{
+			void* pBlock;
+			char* pTop;
+		};
+#pragma region Deleted Functions
+		Arena(const Arena& other) = delete;
+		Arena(Arena&& other) = delete;
+		Arena& operator=(const Arena& other) = delete;
+		Arena& operator=(Arena&& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		explicit Arena(size_t blockSize = 64 * 1024);
+		~Arena();
+#pragma endregion
+
+		_NODISCARD void* Allocate(size_t size, size_t alignment);
+		// Resizes the allocation at pData to newSize when it's the newest one and still fits in its block
+		bool TryExpand(void* pData, size_t oldSize, size_t newSize);
+		_NODISCARD Marker GetMarker() const;
+		// Everything allocated after marker was taken becomes free memory again, containers still using it are left dangling
+		void Rewind(const Marker& marker);
+		void Reset();
+		_NODISCARD uint32_t BlockCount() const;
+
+	private:
+		struct Block
+		{
+			Block* pNext;
+			size_t size; // bytes after the header
+		};
+		// keeps the first allocation of a block aligned to 16
+		static constexpr size_t m_HeaderSize = (sizeof(Block) + 15) & ~size_t{ 15 };
+
+		void NextBlock(size_t minSize);
+		static char* BlockData(Block* pBlock);
+		static char* AlignUp(char* pAddress, size_t alignment);
+
+		Block* m_pFirst;
+		Block* m_pCurrent;
+		char* m_pTop;
+		char* m_pEnd;
+		size_t m_BlockSize;
+		uint32_t m_BlockCount;
+	};
+
+	// Rewinds an arena to where it was when the scope started, for per request or per frame allocations
+	class ArenaScope final
+	{
+	public:
+#pragma region Deleted Functions
+		ArenaScope(const ArenaScope& other) = delete;
+		ArenaScope& operator=(const ArenaScope& other) = delete;
+#pragma endregion
+		explicit ArenaScope(Arena& arena);
+		~ArenaScope();
+
+	private:
+		Arena& m_Arena;
+		Arena::Marker m_Marker;
+	};
+
+	// Allocator that hands out memory from an Arena it doesn't own, the arena has to outlive the containers using it
+	template<typename type>
+	class ArenaAllocator
+	{
+	public:
+#pragma region member types
+		using value_type = type;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = ArenaAllocator<otherType>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		ArenaAllocator(Arena& arena);
+		ArenaAllocator(const ArenaAllocator& other) = default;
+		template<typename otherType>
+		ArenaAllocator(const ArenaAllocator<otherType>& other);
+		ArenaAllocator& operator=(const ArenaAllocator& other) = default;
+		~ArenaAllocator() = default;
+#pragma endregion
+
+		_NODISCARD type* allocate(size_t count);
+		// the memory comes back when the arena rewinds
+		void deallocate(type* pData, size_t count);
+		// Lets Vector grow its buffer without moving it when it's the newest allocation in the arena
+		bool TryExpand(type* pData, size_t oldCount, size_t newCount);
+
+		_NODISCARD Arena& GetArena() const;
+
+		template<typename otherType>
+		bool operator==(const ArenaAllocator<otherType>& rhs) const;
+		template<typename otherType>
+		bool operator!=(const ArenaAllocator<otherType>& rhs) const;
+
+	private:
+		Arena* m_pArena;
+	};
+
+	namespace ThreadCaching
+	{
+		// slots are powers of 2 from MinSlotSize to MaxSlotSize, which is also what a doubling Vector asks for
+		inline constexpr size_t MinSlotSize = 16;
+		inline constexpr size_t MaxSlotSize = 4096;
+		inline constexpr size_t ClassCount = 9;
+		static_assert(MinSlotSize << (ClassCount - 1) == MaxSlotSize);
+
+		_NODISCARD constexpr size_t ClassIndex(size_t size);
+		_NODISCARD constexpr size_t SlotSize(size_t classIdx);
+		// how many slots move between a thread and the central pool at once
+		_NODISCARD constexpr uint32_t BatchSize(size_t classIdx);
+
+		struct FreeSlot
+		{
+			FreeSlot* pNext;
+			FreeSlot* pNextBatch; // only used by the first slot of a batch in the central pool
+		};
+
+		// Slots that aren't cached by any thread, guarded by one lock per size class
+		// Never destroyed, so containers with static or thread storage can still give their memory back at exit
+		class CentralPool final
+		{
+		public:
+#pragma region Deleted Functions
+			CentralPool(const CentralPool& other) = delete;
+			CentralPool& operator=(const CentralPool& other) = delete;
+#pragma endregion
+			_NODISCARD static CentralPool& Get();
+
+			// Returns a list of up to BatchSize(classIdx) slots and their count, carves a new slab when the pool is empty
+			_NODISCARD FreeSlot* TakeBatch(size_t classIdx, uint32_t& countOut);
+			// pBatch has to be a full batch
+			void GiveBatch(size_t classIdx, FreeSlot* pBatch);
+			// for whatever a thread still has cached when it exits
+			void GiveLoose(size_t classIdx, FreeSlot* pFirst, FreeSlot* pLast);
+			_NODISCARD uint32_t SlabCount() const;
+
+		private:
+			CentralPool() = default;
+
+			struct alignas(CONTAINER_CACHE_LINE) SizeClass
+			{
+				std::mutex mutex;
+				FreeSlot* pBatches = nullptr;
+				FreeSlot* pLoose = nullptr;
+			};
+
+			static constexpr size_t m_SlabSize = 64 * 1024;
+
+			_NODISCARD FreeSlot* NewSlab(size_t classIdx);
+
+			SizeClass m_Classes[ClassCount];
+			std::atomic<uint32_t> m_SlabCount{ 0 };
+		};
+
+		// The free lists of one thread, allocating and deallocating only take a lock when a whole batch has to move
+		// A thread_local container constructed before its first allocation is destroyed after the cache, so once the cache
+		// is gone TryGet returns nullptr and the slots go straight through the central pool
+		class LocalCache final
+		{
+		public:
+#pragma region Deleted Functions
+			LocalCache(const LocalCache& other) = delete;
+			LocalCache& operator=(const LocalCache& other) = delete;
+#pragma endregion
+			_NODISCARD static LocalCache* TryGet();
+			~LocalCache();
+
+			// use the cache of the calling thread, or the central pool when that cache is already destroyed
+			_NODISCARD static void* AllocateSlot(size_t classIdx);
+			static void DeallocateSlot(void* pSlot, size_t classIdx);
+
+			_NODISCARD void* Allocate(size_t classIdx);
+			void Deallocate(void* pSlot, size_t classIdx);
+
+		private:
+			LocalCache() = default;
+
+			// plain thread_local bool, so it is still there after the cache got destroyed
+			_NODISCARD static bool& Destroyed();
+
+			struct SizeClass
+			{
+				FreeSlot* pFree = nullptr;
+				uint32_t count = 0;
+			};
+
+			SizeClass m_Classes[ClassCount];
+		};
+	}
+
+	// Stateless allocator for many threads that each make lots of small containers
+	// Every thread keeps its own free lists per size class and refills or drains them a batch at a time from a central pool.
+	// All slots come from the same pool, so memory freed on another thread than it was allocated on simply joins the cache
+	// of the freeing thread. Requests over ThreadCaching::MaxSlotSize bytes and over aligned types go to operator new
+	template<typename type>
+	class ThreadCachingAllocator
+	{
+	public:
+#pragma region member types
+		using value_type = type;
+		using is_always_equal = std::true_type;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = ThreadCachingAllocator<otherType>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		constexpr ThreadCachingAllocator() = default;
+		template<typename otherType>
+		constexpr ThreadCachingAllocator(const ThreadCachingAllocator<otherType>& other);
+#pragma endregion
+
+		_NODISCARD type* allocate(size_t count);
+		void deallocate(type* pData, size_t count);
+
+		template<typename otherType>
+		constexpr bool operator==(const ThreadCachingAllocator<otherType>& rhs) const;
+		template<typename otherType>
+		constexpr bool operator!=(const ThreadCachingAllocator<otherType>& rhs) const;
+
+	private:
+		static constexpr bool m_Cachable = alignof(type) <= ThreadCaching::MinSlotSize;
+	};
+
+	// Allocator that aligns every allocation to alignment bytes (a cache line by default), for data that SIMD code
+	// reads with aligned loads. Vector also asks it to round its capacity up, so a buffer always covers whole
+	// alignment sized chunks and a kernel can run over the tail of the last one without a scalar remainder loop
+	template<typename type, size_t alignment = CONTAINER_CACHE_LINE>
+	class AlignedAllocator
+	{
+	public:
+		static_assert(std::has_single_bit(alignment), "alignment has to be a power of 2");
+#pragma region member types
+		using value_type = type;
+		using is_always_equal = std::true_type;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = AlignedAllocator<otherType, alignment>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		constexpr AlignedAllocator() = default;
+		template<typename otherType>
+		constexpr AlignedAllocator(const AlignedAllocator<otherType, alignment>& other);
+#pragma endregion
+
+		// never less than the natural alignment of type
+		static constexpr size_t Alignment = alignment < alignof(type) ? alignof(type) : alignment;
+
+		_NODISCARD type* allocate(size_t count);
+		void deallocate(type* pData, size_t count);
+		// The most elements that fit in the whole Alignment sized chunks count elements need
+		_NODISCARD static constexpr size_t RoundCapacity(size_t count);
+
+		template<typename otherType>
+		constexpr bool operator==(const AlignedAllocator<otherType, alignment>& rhs) const;
+		template<typename otherType>
+		constexpr bool operator!=(const AlignedAllocator<otherType, alignment>& rhs) const;
+	};
+
+#pragma region PoolState
+	template<size_t blockSize>
+	inline PoolState<blockSize>::PoolState()
+		: m_Classes{}
+		, m_pSlabs{ nullptr }
+		, m_SlabCount{ 0 }
+	{
+	}
+
+	template<size_t blockSize>
+	inline PoolState<blockSize>::~PoolState()
+	{
+		while (m_pSlabs)
+		{
+			void* pPrevious = *static_cast<void**>(m_pSlabs);
+			::operator delete(m_pSlabs);
+			m_pSlabs = pPrevious;
+		}
+	}
+
+	template<size_t blockSize>
+	inline void* PoolState<blockSize>::Allocate(size_t size)
+	{
+		assert(size > 0 && size <= MaxSlotSize);
+		const size_t classIdx = (size - 1) / Granularity;
+		SizeClass& sizeClass = m_Classes[classIdx];
+		if (sizeClass.pFree)
+		{
+			FreeSlot* pSlot = sizeClass.pFree;
+			sizeClass.pFree = pSlot->pNext;
+			return pSlot;
+		}
+
+		const size_t slotSize = (classIdx + 1) * Granularity;
+		if (sizeClass.pBump == sizeClass.pBumpEnd)
+		{
+			NewSlab(sizeClass, slotSize);
+		}
+		void* pSlot = sizeClass.pBump;
+		sizeClass.pBump += slotSize;
+		return pSlot;
+	}
+
+	template<size_t blockSize>
+	inline void PoolState<blockSize>::Deallocate(void* pSlot, size_t size)
+	{
+		assert(size > 0 && size <= MaxSlotSize);
+		SizeClass& sizeClass = m_Classes[(size - 1) / Granularity];
+		FreeSlot* pFree = static_cast<FreeSlot*>(pSlot);
+		pFree->pNext = sizeClass.pFree;
+		sizeClass.pFree = pFree;
+	}
+
+	template<size_t blockSize>
+	inline uint32_t PoolState<blockSize>::SlabCount() const
+	{
+		return m_SlabCount;
+	}
+
+	template<size_t blockSize>
+	inline void PoolState<blockSize>::NewSlab(SizeClass& sizeClass, size_t slotSize)
+	{
+		// operator new aligns to at least 16 on x64, the header keeps the slots at that alignment
+		char* pSlab = static_cast<char*>(::operator new(blockSize));
+		*reinterpret_cast<void**>(pSlab) = m_pSlabs;
+		m_pSlabs = pSlab;
+		++m_SlabCount;
+
+		const size_t slotCount = (blockSize - m_SlabHeader) / slotSize;
+		sizeClass.pBump = pSlab + m_SlabHeader;
+		sizeClass.pBumpEnd = sizeClass.pBump + slotCount * slotSize;
+	}
+#pragma endregion
+
+#pragma region PoolAllocator
+	template<typename type, size_t blockSize>
+	inline PoolAllocator<type, blockSize>::PoolAllocator()
+		: m_pState{ std::make_shared<PoolState<blockSize>>() }
+	{
+	}
+
+	template<typename type, size_t blockSize>
+	template<typename otherType>
+	inline PoolAllocator<type, blockSize>::PoolAllocator(const PoolAllocator<otherType, blockSize>& other)
+		: m_pState{ other.State() }
+	{
+	}
+
+	template<typename type, size_t blockSize>
+	inline type* PoolAllocator<type, blockSize>::allocate(size_t count)
+	{
+		if constexpr (m_FromPool)
+		{
+			if (count == 1)
+			{
+				return static_cast<type*>(m_pState->Allocate(sizeof(type)));
+			}
+		}
+		return std::allocator<type>{}.allocate(count);
+	}
+
+	template<typename type, size_t blockSize>
+	inline void PoolAllocator<type, blockSize>::deallocate(type* pData, size_t count)
+	{
+		if constexpr (m_FromPool)
+		{
+			if (count == 1)
+			{
+				m_pState->Deallocate(pData, sizeof(type));
+				return;
+			}
+		}
+		std::allocator<type>{}.deallocate(pData, count);
+	}
+
+	template<typename type, size_t blockSize>
+	inline const std::shared_ptr<PoolState<blockSize>>& PoolAllocator<type, blockSize>::State() const
+	{
+		return m_pState;
+	}
+
+	template<typename type, size_t blockSize>
+	template<typename otherType>
+	inline bool PoolAllocator<type, blockSize>::operator==(const PoolAllocator<otherType, blockSize>& rhs) const
+	{
+		return m_pState == rhs.State();
+	}
+
+	template<typename type, size_t blockSize>
+	template<typename otherType>
+	inline bool PoolAllocator<type, blockSize>::operator!=(const PoolAllocator<otherType, blockSize>& rhs) const
+	{
+		return m_pState != rhs.State();
+	}
+#pragma endregion
+
+#pragma region Arena
+	inline Arena::Arena(size_t blockSize)
+		: m_pFirst{ nullptr }
+		, m_pCurrent{ nullptr }
+		, m_pTop{ nullptr }
+		, m_pEnd{ nullptr }
+		, m_BlockSize{ blockSize }
+		, m_BlockCount{ 0 }
+	{
+	}
+
+	inline Arena::~Arena()
+	{
+		while (m_pFirst)
+		{
+			Block* pNext = m_pFirst->pNext;
+			::operator delete(m_pFirst);
+			m_pFirst = pNext;
+		}
+	}
+
+	inline void* Arena::Allocate(size_t size, size_t alignment)
+	{
+		char* pData = AlignUp(m_pTop, alignment);
+		if (m_pCurrent == nullptr || pData > m_pEnd || size > static_cast<size_t>(m_pEnd - pData))
+		{
+			NextBlock(size + alignment);
+			pData = AlignUp(m_pTop, alignment);
+		}
+		m_pTop = pData + size;
+		return pData;
+	}
+
+	inline bool Arena::TryExpand(void* pData, size_t oldSize, size_t newSize)
+	{
+		char* pBytes = static_cast<char*>(pData);
+		if (pBytes + oldSize != m_pTop || newSize > static_cast<size_t>(m_pEnd - pBytes))
+		{
+			return false;
+		}
+		m_pTop = pBytes + newSize;
+		return true;
+	}
+
+	inline Arena::Marker Arena::GetMarker() const
+	{
+		return Marker{ m_pCurrent, m_pTop };
+	}
+
+	inline void Arena::Rewind(const Marker& marker)
+	{
+		m_pCurrent = static_cast<Block*>(marker.pBlock);
+		m_pTop = marker.pTop;
+		m_pEnd = m_pCurrent ? BlockData(m_pCurrent) + m_pCurrent->size : nullptr;
+	}
+
+	inline void Arena::Reset()
+	{
+		Rewind(Marker{ nullptr, nullptr });
+	}
+
+	inline uint32_t Arena::BlockCount() const
+	{
+		return m_BlockCount;
+	}
+
+	inline void Arena::NextBlock(size_t minSize)
+	{
+		// the block after the current one is left over from a rewind, it gets reused when it's big enough
+		Block*& pNextLink = m_pCurrent ? m_pCurrent->pNext : m_pFirst;
+		Block* pBlock = pNextLink;
+		if (pBlock == nullptr || pBlock->size < minSize)
+		{
+			const size_t size = minSize > m_BlockSize ? minSize : m_BlockSize;
+			pBlock = static_cast<Block*>(::operator new(m_HeaderSize + size));
+			pBlock->pNext = pNextLink;
+			pBlock->size = size;
+			pNextLink = pBlock;
+			++m_BlockCount;
+		}
+		m_pCurrent = pBlock;
+		m_pTop = BlockData(pBlock);
+		m_pEnd = m_pTop + pBlock->size;
+	}
+
+	inline char* Arena::BlockData(Block* pBlock)
+	{
+		return reinterpret_cast<char*>(pBlock) + m_HeaderSize;
+	}
+
+	inline char* Arena::AlignUp(char* pAddress, size_t alignment)
+	{
+		const uintptr_t address = reinterpret_cast<uintptr_t>(pAddress);
+		return pAddress + (((address + alignment - 1) & ~(uintptr_t{ alignment } - 1)) - address);
+	}
+#pragma endregion
+
+#pragma region ArenaScope
+	inline ArenaScope::ArenaScope(Arena& arena)
+		: m_Arena{ arena }
+		, m_Marker{ arena.GetMarker() }
+	{
+	}
+
+	inline ArenaScope::~ArenaScope()
+	{
+		m_Arena.Rewind(m_Marker);
+	}
+#pragma endregion
+
+#pragma region ArenaAllocator
+	template<typename type>
+	inline ArenaAllocator<type>::ArenaAllocator(Arena& arena)
+		: m_pArena{ &arena }
+	{
+	}
+
+	template<typename type>
+	template<typename otherType>
+	inline ArenaAllocator<type>::ArenaAllocator(const ArenaAllocator<otherType>& other)
+		: m_pArena{ &other.GetArena() }
+	{
+	}
+
+	template<typename type>
+	inline type* ArenaAllocator<type>::allocate(size_t count)
+	{
+		return static_cast<type*>(m_pArena->Allocate(count * sizeof(type), alignof(type)));
+	}
+
+	template<typename type>
+	inline void ArenaAllocator<type>::deallocate(type*, size_t)
+	{
+	}
+
+	template<typename type>
+	inline bool ArenaAllocator<type>::TryExpand(type* pData, size_t oldCount, size_t newCount)
+	{
+		return m_pArena->TryExpand(pData, oldCount * sizeof(type), newCount * sizeof(type));
+	}
+
+	template<typename type>
+	inline Arena& ArenaAllocator<type>::GetArena() const
+	{
+		return *m_pArena;
+	}
+
+	template<typename type>
+	template<typename otherType>
+	inline bool ArenaAllocator<type>::operator==(const ArenaAllocator<otherType>& rhs) const
+	{
+		return m_pArena == &rhs.GetArena();
+	}
+
+	template<typename type>
+	template<typename otherType>
+	inline bool ArenaAllocator<type>::operator!=(const ArenaAllocator<otherType>& rhs) const
+	{
+		return m_pArena != &rhs.GetArena();
+	}
+#pragma endregion
+
+#pragma region ThreadCaching
+	namespace ThreadCaching
+	{
+		constexpr size_t ClassIndex(size_t size)
+		{
+			return size <= MinSlotSize ? 0 : std::bit_width(size - 1) - std::bit_width(MinSlotSize - 1);
+		}
+
+		constexpr size_t SlotSize(size_t classIdx)
+		{
+			return MinSlotSize << classIdx;
+		}
+
+		constexpr uint32_t BatchSize(size_t classIdx)
+		{
+			// around 8 KB per batch, but at least a few slots for the big classes
+			const size_t count = 8 * 1024 / SlotSize(classIdx);
+			return static_cast<uint32_t>(count < 4 ? 4 : count > 64 ? 64 : count);
+		}
+
+		inline CentralPool& CentralPool::Get()
+		{
+			static CentralPool* pPool = new CentralPool{};
+			return *pPool;
+		}
+
+		inline FreeSlot* CentralPool::TakeBatch(size_t classIdx, uint32_t& countOut)
+		{
+			SizeClass& sizeClass = m_Classes[classIdx];
+			const uint32_t batchSize = BatchSize(classIdx);
+			{
+				std::lock_guard lock{ sizeClass.mutex };
+				if (sizeClass.pBatches)
+				{
+					FreeSlot* pBatch = sizeClass.pBatches;
+					sizeClass.pBatches = pBatch->pNextBatch;
+					countOut = batchSize;
+					return pBatch;
+				}
+				if (sizeClass.pLoose)
+				{
+					FreeSlot* pFirst = sizeClass.pLoose;
+					FreeSlot* pLast = pFirst;
+					countOut = 1;
+					while (pLast->pNext && countOut < batchSize)
+					{
+						pLast = pLast->pNext;
+						++countOut;
+					}
+					sizeClass.pLoose = pLast->pNext;
+					pLast->pNext = nullptr;
+					return pFirst;
+				}
+			}
+
+			// carving the slab happens outside the lock, only the batches the caller doesn't take go back under it
+			FreeSlot* pBatches = NewSlab(classIdx);
+			FreeSlot* pBatch = pBatches;
+			pBatches = pBatch->pNextBatch;
+			if (pBatches)
+			{
+				FreeSlot* pLastBatch = pBatches;
+				while (pLastBatch->pNextBatch)
+				{
+					pLastBatch = pLastBatch->pNextBatch;
+				}
+				std::lock_guard lock{ sizeClass.mutex };
+				pLastBatch->pNextBatch = sizeClass.pBatches;
+				sizeClass.pBatches = pBatches;
+			}
+			countOut = batchSize;
+			return pBatch;
+		}
+
+		inline void CentralPool::GiveBatch(size_t classIdx, FreeSlot* pBatch)
+		{
+			SizeClass& sizeClass = m_Classes[classIdx];
+			std::lock_guard lock{ sizeClass.mutex };
+			pBatch->pNextBatch = sizeClass.pBatches;
+			sizeClass.pBatches = pBatch;
+		}
+
+		inline void CentralPool::GiveLoose(size_t classIdx, FreeSlot* pFirst, FreeSlot* pLast)
+		{
+			SizeClass& sizeClass = m_Classes[classIdx];
+			std::lock_guard lock{ sizeClass.mutex };
+			pLast->pNext = sizeClass.pLoose;
+			sizeClass.pLoose = pFirst;
+		}
+
+		inline uint32_t CentralPool::SlabCount() const
+		{
+			return m_SlabCount.load(std::memory_order_relaxed);
+		}
+
+		inline FreeSlot* CentralPool::NewSlab(size_t classIdx)
+		{
+			// operator new aligns to at least 16, slots are multiples of 16 so they all keep that alignment
+			const size_t slotSize = SlotSize(classIdx);
+			const uint32_t batchSize = BatchSize(classIdx);
+			const size_t batchCount = m_SlabSize / (slotSize * batchSize);
+			char* pSlab = static_cast<char*>(::operator new(m_SlabSize));
+			m_SlabCount.fetch_add(1, std::memory_order_relaxed);
+
+			// links the slab up as batchCount full batches
+			FreeSlot* pFirstBatch = nullptr;
+			for (size_t batchIdx = batchCount; batchIdx-- > 0;)
+			{
+				char* pBatchStart = pSlab + batchIdx * batchSize * slotSize;
+				FreeSlot* pNext = nullptr;
+				for (uint32_t slotIdx = batchSize; slotIdx-- > 0;)
+				{
+					FreeSlot* pSlot = reinterpret_cast<FreeSlot*>(pBatchStart + slotIdx * slotSize);
+					pSlot->pNext = pNext;
+					pNext = pSlot;
+				}
+				pNext->pNextBatch = pFirstBatch;
+				pFirstBatch = pNext;
+			}
+			return pFirstBatch;
+		}
+
+		inline LocalCache* LocalCache::TryGet()
+		{
+			if (Destroyed())
+			{
+				return nullptr;
+			}
+			thread_local LocalCache cache{};
+			return &cache;
+		}
+
+		inline bool& LocalCache::Destroyed()
+		{
+			thread_local bool destroyed{ false };
+			return destroyed;
+		}
+
+		inline LocalCache::~LocalCache()
+		{
+			CentralPool& central = CentralPool::Get();
+			for (size_t classIdx{}; classIdx < ClassCount; ++classIdx)
+			{
+				SizeClass& sizeClass = m_Classes[classIdx];
+				if (sizeClass.pFree == nullptr)
+				{
+					continue;
+				}
+				FreeSlot* pLast = sizeClass.pFree;
+				while (pLast->pNext)
+				{
+					pLast = pLast->pNext;
+				}
+				central.GiveLoose(classIdx, sizeClass.pFree, pLast);
+				sizeClass.pFree = nullptr;
+				sizeClass.count = 0;
+			}
+			Destroyed() = true;
+		}
+
+		inline void* LocalCache::AllocateSlot(size_t classIdx)
+		{
+			if (LocalCache* pCache = TryGet())
+			{
+				return pCache->Allocate(classIdx);
+			}
+
+			// take a batch for the one slot and give the rest back loose
+			CentralPool& central = CentralPool::Get();
+			uint32_t count{};
+			FreeSlot* pSlot = central.TakeBatch(classIdx, count);
+			if (FreeSlot* pRest = pSlot->pNext)
+			{
+				FreeSlot* pLast = pRest;
+				while (pLast->pNext)
+				{
+					pLast = pLast->pNext;
+				}
+				central.GiveLoose(classIdx, pRest, pLast);
+			}
+			return pSlot;
+		}
+
+		inline void LocalCache::DeallocateSlot(void* pSlot, size_t classIdx)
+		{
+			if (LocalCache* pCache = TryGet())
+			{
+				pCache->Deallocate(pSlot, classIdx);
+				return;
+			}
+
+			FreeSlot* pFree = static_cast<FreeSlot*>(pSlot);
+			pFree->pNext = nullptr;
+			CentralPool::Get().GiveLoose(classIdx, pFree, pFree);
+		}
+
+		inline void* LocalCache::Allocate(size_t classIdx)
+		{
+			SizeClass& sizeClass = m_Classes[classIdx];
+			if (sizeClass.pFree == nullptr)
+			{
+				sizeClass.pFree = CentralPool::Get().TakeBatch(classIdx, sizeClass.count);
+			}
+			FreeSlot* pSlot = sizeClass.pFree;
+			sizeClass.pFree = pSlot->pNext;
+			--sizeClass.count;
+			return pSlot;
+		}
+
+		inline void LocalCache::Deallocate(void* pSlot, size_t classIdx)
+		{
+			SizeClass& sizeClass = m_Classes[classIdx];
+			FreeSlot* pFree = static_cast<FreeSlot*>(pSlot);
+			pFree->pNext = sizeClass.pFree;
+			sizeClass.pFree = pFree;
+
+			// keeps one batch after draining, so a thread going back and forth over the limit doesn't hit the lock every time
+			const uint32_t batchSize = BatchSize(classIdx);
+			if (++sizeClass.count < 2 * batchSize)
+			{
+				return;
+			}
+			FreeSlot* pBatch = sizeClass.pFree;
+			FreeSlot* pLast = pBatch;
+			for (uint32_t i = 1; i < batchSize; ++i)
+			{
+				pLast = pLast->pNext;
+			}
+			sizeClass.pFree = pLast->pNext;
+			sizeClass.count -= batchSize;
+			pLast->pNext = nullptr;
+			CentralPool::Get().GiveBatch(classIdx, pBatch);
+		}
+	}
+#pragma endregion
+
+#pragma region ThreadCachingAllocator
+	template<typename type>
+	template<typename otherType>
+	constexpr ThreadCachingAllocator<type>::ThreadCachingAllocator(const ThreadCachingAllocator<otherType>&)
+	{
+	}
+
+	template<typename type>
+	inline type* ThreadCachingAllocator<type>::allocate(size_t count)
+	{
+		if constexpr (m_Cachable)
+		{
+			const size_t size = count * sizeof(type);
+			if (size <= ThreadCaching::MaxSlotSize && count > 0)
+			{
+				return static_cast<type*>(ThreadCaching::LocalCache::AllocateSlot(ThreadCaching::ClassIndex(size)));
+			}
+		}
+		return std::allocator<type>{}.allocate(count);
+	}
+
+	template<typename type>
+	inline void ThreadCachingAllocator<type>::deallocate(type* pData, size_t count)
+	{
+		if constexpr (m_Cachable)
+		{
+			const size_t size = count * sizeof(type);
+			if (size <= ThreadCaching::MaxSlotSize && count > 0)
+			{
+				ThreadCaching::LocalCache::DeallocateSlot(pData, ThreadCaching::ClassIndex(size));
+				return;
+			}
+		}
+		std::allocator<type>{}.deallocate(pData, count);
+	}
+
+	template<typename type>
+	template<typename otherType>
+	constexpr bool ThreadCachingAllocator<type>::operator==(const ThreadCachingAllocator<otherType>&) const
+	{
+		return true;
+	}
+
+	template<typename type>
+	template<typename otherType>
+	constexpr bool ThreadCachingAllocator<type>::operator!=(const ThreadCachingAllocator<otherType>&) const
+	{
+		return false;
+	}
+#pragma endregion
+
+#pragma region AlignedAllocator
+	template<typename type, size_t alignment>
+	template<typename otherType>
+	constexpr AlignedAllocator<type, alignment>::AlignedAllocator(const AlignedAllocator<otherType, alignment>&)
+	{
+	}
+
+	template<typename type, size_t alignment>
+	inline type* AlignedAllocator<type, alignment>::allocate(size_t count)
+	{
+		return static_cast<type*>(::operator new(count * sizeof(type), std::align_val_t{ Alignment }));
+	}
+
+	template<typename type, size_t alignment>
+	inline void AlignedAllocator<type, alignment>::deallocate(type* pData, size_t count)
+	{
+		::operator delete(pData, count * sizeof(type), std::align_val_t{ Alignment });
+	}
+
+	template<typename type, size_t alignment>
+	constexpr size_t AlignedAllocator<type, alignment>::RoundCapacity(size_t count)
+	{
+		const size_t bytes = (count * sizeof(type) + Alignment - 1) & ~(Alignment - 1);
+		return bytes / sizeof(type);
+	}
+
+	template<typename type, size_t alignment>
+	template<typename otherType>
+	constexpr bool AlignedAllocator<type, alignment>::operator==(const AlignedAllocator<otherType, alignment>&) const
+	{
+		return true;
+	}
+
+	template<typename type, size_t alignment>
+	template<typename otherType>
+	constexpr bool AlignedAllocator<type, alignment>::operator!=(const AlignedAllocator<otherType, alignment>&) const
+	{
+		return false;
+	}
+#pragma endregion
+}
@@ -0,0 +1,425 @@
+#pragma once
+#include "Platform.h"
+#include "PerfCounters.h"
+#include "StreamFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Small benchmark harness: every benchmark gets warmed up, its iteration count calibrated so one sample takes long enough
+// to time accurately, and then a number of samples are taken. Results are kept as nanoseconds per iteration so they
+// can be printed, summarized and written to CSV or JSON for collecting and comparing runs
+namespace Benchmark
+{
+#pragma region Optimization Barriers
+#if defined(_MSC_VER) && !defined(__clang__)
+	// MSVC has no inline asm on x64, storing the address in a volatile makes the value escape just the same
+	inline const volatile void* g_pSink{ nullptr };
+#endif
+
+	// Makes the compiler believe value is read, so the computation that produced it can't be thrown away
+	template<typename type>
+	CONTAINER_FORCEINLINE void DoNotOptimize(const type& value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		g_pSink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	// Makes the compiler believe all memory is read and written, so stores before it can't be left out
+	CONTAINER_FORCEINLINE void ClobberMemory()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+#pragma endregion
+
+	// written into the JSON files, goes up when their layout changes in a way older readers can't handle
+	inline constexpr uint32_t ResultFormatVersion = 1;
+
+	struct Options
+	{
+		uint32_t sampleCount = 25;
+		// the iteration count is picked so one sample takes about this long
+		double minSampleMs = 10.0;
+		// runs the benchmark for at least this long before calibrating, to get caches and branch predictors going
+		double warmupMs = 50.0;
+		uint64_t maxIterations = uint64_t{ 1 } << 32;
+		// reads the hardware counters around every sample when the platform allows it
+		bool readCounters = true;
+	};
+
+	// all in nanoseconds per iteration
+	struct Statistics
+	{
+		double min = 0.0;
+		double median = 0.0;
+		double p90 = 0.0;
+		double p99 = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double stddev = 0.0;
+	};
+
+	struct Result
+	{
+		std::string name;
+		uint64_t iterationsPerSample = 0;
+		std::vector<double> samples; // nanoseconds per iteration, in the order they were taken
+		Statistics stats;
+		CounterValues counters; // per iteration, over all samples
+	};
+
+	// Linear interpolation between the closest ranks, sorted has to be sorted
+	_NODISCARD double Percentile(const std::vector<double>& sorted, double percentile);
+	_NODISCARD Statistics Summarize(std::vector<double> samples);
+
+	class Runner final
+	{
+	public:
+		explicit Runner(Options options = Options{}, std::ostream* pLog = &std::cout);
+
+		// Runs body(iterations) until it has options.sampleCount samples, body has to do its work iterations times
+		// Work body needs but that shouldn't be timed has to happen outside of it, everything inside gets timed
+		template<typename benchmark>
+		const Result& Run(const std::string& name, benchmark body);
+
+		_NODISCARD const std::vector<Result>& Results() const;
+		void WriteCsv(std::ostream& out) const;
+		// includes the raw samples, so two runs can be compared with a statistical test later
+		void WriteJson(std::ostream& out) const;
+		// writes baseName.csv and baseName.json, returns false when a file couldn't be opened
+		bool WriteFiles(const std::string& baseName) const;
+
+	private:
+		template<typename benchmark>
+		static double TimeNs(benchmark& body, uint64_t iterations);
+		template<typename benchmark>
+		uint64_t Calibrate(benchmark& body) const;
+		void Print(const Result& result) const;
+		static void WriteJsonString(std::ostream& out, const std::string& text);
+
+		Options m_Options;
+		std::ostream* m_pLog;
+		std::vector<Result> m_Results;
+		std::unique_ptr<PerfCounters> m_pCounters;
+	};
+
+#pragma region Statistics
+	inline double Percentile(const std::vector<double>& sorted, double percentile)
+	{
+		if (sorted.empty())
+		{
+			return 0.0;
+		}
+		const double rank = percentile / 100.0 * static_cast<double>(sorted.size() - 1);
+		const size_t lower = static_cast<size_t>(rank);
+		const size_t upper = std::min(lower + 1, sorted.size() - 1);
+		return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+	}
+
+	inline Statistics Summarize(std::vector<double> samples)
+	{
+		Statistics stats{};
+		if (samples.empty())
+		{
+			return stats;
+		}
+
+		std::sort(samples.begin(), samples.end());
+		stats.min = samples.front();
+		stats.max = samples.back();
+		stats.median = Percentile(samples, 50.0);
+		stats.p90 = Percentile(samples, 90.0);
+		stats.p99 = Percentile(samples, 99.0);
+
+		double sum{};
+		for (double sample : samples)
+		{
+			sum += sample;
+		}
+		stats.mean = sum / static_cast<double>(samples.size());
+		double squares{};
+		for (double sample : samples)
+		{
+			squares += (sample - stats.mean) * (sample - stats.mean);
+		}
+		stats.stddev = samples.size() > 1 ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0;
+		return stats;
+	}
+#pragma endregion
+
+#pragma region Runner
+	inline Runner::Runner(Options options, std::ostream* pLog)
+		: m_Options{ options }
+		, m_pLog{ pLog }
+		, m_Results{}
+		, m_pCounters{}
+	{
+		if (!m_Options.readCounters)
+		{
+			return;
+		}
+		m_pCounters = std::make_unique<PerfCounters>();
+		if (m_pLog && !m_pCounters->Error().empty())
+		{
+			*m_pLog << (m_pCounters->Available() ? "Some hardware counters are missing (" : "Hardware counters are not available (")
+				<< m_pCounters->Error() << "), timing only where they are missing" << std::endl;
+		}
+		if (!m_pCounters->Available())
+		{
+			m_pCounters.reset();
+		}
+	}
+
+	template<typename benchmark>
+	inline const Result& Runner::Run(const std::string& name, benchmark body)
+	{
+		const uint64_t iterations = Calibrate(body);
+
+		Result result{};
+		result.name = name;
+		result.iterationsPerSample = iterations;
+		result.samples.reserve(m_Options.sampleCount);
+		// a counter that got multiplexed out or failed to read in a sample only averages over the samples it counted in
+		uint32_t countedSamples[CounterCount]{};
+		for (uint32_t sample{}; sample < m_Options.sampleCount; ++sample)
+		{
+			if (m_pCounters)
+			{
+				m_pCounters->Start();
+			}
+			result.samples.push_back(TimeNs(body, iterations) / static_cast<double>(iterations));
+			if (m_pCounters)
+			{
+				const CounterValues sampleCounters = m_pCounters->Stop();
+				for (uint32_t i{}; i < CounterCount; ++i)
+				{
+					if (sampleCounters.valid[i])
+					{
+						result.counters.values[i] += sampleCounters.values[i];
+						++countedSamples[i];
+					}
+				}
+			}
+		}
+		result.stats = Summarize(result.samples);
+		for (uint32_t i{}; i < CounterCount; ++i)
+		{
+			// stays invalid, so it gets reported as unavailable, when no sample counted it
+			result.counters.valid[i] = countedSamples[i] > 0;
+			if (result.counters.valid[i])
+			{
+				result.counters.values[i] /= static_cast<double>(iterations) * countedSamples[i];
+			}
+		}
+
+		Print(result);
+		m_Results.push_back(std::move(result));
+		return m_Results.back();
+	}
+
+	inline const std::vector<Result>& Runner::Results() const
+	{
+		return m_Results;
+	}
+
+	inline void Runner::WriteCsv(std::ostream& out) const
+	{
+		out << "name,iterations,samples,min_ns,median_ns,p90_ns,p99_ns,max_ns,mean_ns,stddev_ns";
+		for (const char* pCounter : CounterNames)
+		{
+			out << ',' << pCounter << "_per_iteration";
+		}
+		out << '\n';
+		for (const Result& result : m_Results)
+		{
+			// names with a comma or quote get quoted, with quotes doubled
+			if (result.name.find_first_of(",\"") != std::string::npos)
+			{
+				out << '"';
+				for (char c : result.name)
+				{
+					out << (c == '"' ? "\"\"" : std::string(1, c));
+				}
+				out << '"';
+			}
+			else
+			{
+				out << result.name;
+			}
+			const Statistics& stats = result.stats;
+			out << ',' << result.iterationsPerSample << ',' << result.samples.size() << ',' << stats.min << ',' << stats.median
+				<< ',' << stats.p90 << ',' << stats.p99 << ',' << stats.max << ',' << stats.mean << ',' << stats.stddev;
+			// missing counters stay empty
+			for (uint32_t i{}; i < CounterCount; ++i)
+			{
+				out << ',';
+				if (result.counters.valid[i])
+				{
+					out << result.counters.values[i];
+				}
+			}
+			out << '\n';
+		}
+	}
+
+	inline void Runner::WriteJson(std::ostream& out) const
+	{
+		out << "{\n\t\"version\": " << ResultFormatVersion << ",\n\t\"benchmarks\": [\n";
+		for (size_t i{}; i < m_Results.size(); ++i)
+		{
+			const Result& result = m_Results[i];
+			const Statistics& stats = result.stats;
+			out << "\t\t{ \"name\": ";
+			WriteJsonString(out, result.name);
+			out << ", \"iterations\": " << result.iterationsPerSample
+				<< ", \"min_ns\": " << stats.min << ", \"median_ns\": " << stats.median << ", \"p90_ns\": " << stats.p90
+				<< ", \"p99_ns\": " << stats.p99 << ", \"max_ns\": " << stats.max << ", \"mean_ns\": " << stats.mean
+				<< ", \"stddev_ns\": " << stats.stddev << ", \"counters\": {";
+			bool first = true;
+			for (uint32_t counter{}; counter < CounterCount; ++counter)
+			{
+				if (result.counters.valid[counter])
+				{
+					out << (first ? " \"" : ", \"") << CounterNames[counter] << "\": " << result.counters.values[counter];
+					first = false;
+				}
+			}
+			out << (first ? "}" : " }") << ", \"samples_ns\": [";
+			for (size_t sample{}; sample < result.samples.size(); ++sample)
+			{
+				out << (sample == 0 ? "" : ", ") << result.samples[sample];
+			}
+			out << "] }" << (i + 1 < m_Results.size() ? "," : "") << "\n";
+		}
+		out << "\t]\n}\n";
+	}
+
+	inline bool Runner::WriteFiles(const std::string& baseName) const
+	{
+		std::ofstream csv{ baseName + ".csv" };
+		std::ofstream json{ baseName + ".json" };
+		if (!csv || !json)
+		{
+			return false;
+		}
+		csv << std::setprecision(10);
+		json << std::setprecision(10);
+		WriteCsv(csv);
+		WriteJson(json);
+		return true;
+	}
+
+	template<typename benchmark>
+	inline double Runner::TimeNs(benchmark& body, uint64_t iterations)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		body(iterations);
+		ClobberMemory();
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	template<typename benchmark>
+	inline uint64_t Runner::Calibrate(benchmark& body) const
+	{
+		// doubles the iterations until a run takes long enough, the runs up to then are the warmup
+		const double minSampleNs = m_Options.minSampleMs * 1e6;
+		double warmedUpNs{};
+		uint64_t iterations = 1;
+		while (true)
+		{
+			const double timeNs = TimeNs(body, iterations);
+			warmedUpNs += timeNs;
+			if (iterations >= m_Options.maxIterations)
+			{
+				return m_Options.maxIterations;
+			}
+			if (timeNs >= minSampleNs && warmedUpNs >= m_Options.warmupMs * 1e6)
+			{
+				return iterations;
+			}
+			if (timeNs >= minSampleNs)
+			{
+				continue; // long enough but still warming up
+			}
+			// jumps straight to the estimate when the run was long enough to trust, so slow bodies don't run for ages
+			const double estimate = timeNs > minSampleNs / 10.0 ? std::ceil(static_cast<double>(iterations) * minSampleNs / timeNs) : 0.0;
+			iterations = std::min(m_Options.maxIterations, std::max(iterations * 2, static_cast<uint64_t>(estimate)));
+		}
+	}
+
+	inline void Runner::Print(const Result& result) const
+	{
+		if (m_pLog == nullptr)
+		{
+			return;
+		}
+		const StreamFormatGuard formatGuard{ *m_pLog };
+		const Statistics& stats = result.stats;
+		*m_pLog << std::left << std::setw(56) << result.name << std::right << std::fixed << std::setprecision(1)
+			<< " median " << std::setw(12) << stats.median << " ns"
+			<< "  min " << std::setw(12) << stats.min
+			<< "  p90 " << std::setw(12) << stats.p90
+			<< "  p99 " << std::setw(12) << stats.p99
+			<< "  max " << std::setw(12) << stats.max
+			<< "  (" << result.iterationsPerSample << " x " << result.samples.size() << ")" << std::endl;
+
+		const CounterValues& counters = result.counters;
+		if (counters.Any())
+		{
+			*m_pLog << "\tper iteration:" << std::setprecision(2);
+			for (uint32_t i{}; i < CounterCount; ++i)
+			{
+				if (counters.valid[i])
+				{
+					*m_pLog << "  " << CounterNames[i] << " " << counters.values[i];
+				}
+			}
+			const uint32_t cycles = static_cast<uint32_t>(Counter::Cycles);
+			const uint32_t instructions = static_cast<uint32_t>(Counter::Instructions);
+			if (counters.valid[cycles] && counters.valid[instructions] && counters.values[cycles] > 0.0)
+			{
+				*m_pLog << "  IPC " << counters.values[instructions] / counters.values[cycles];
+			}
+			*m_pLog << std::endl;
+		}
+	}
+
+	inline void Runner::WriteJsonString(std::ostream& out, const std::string& text)
+	{
+		out << '"';
+		for (char c : text)
+		{
+			switch (c)
+			{
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\t': out << "\\t"; break;
+			default: out << c; break;
+			}
+		}
+		out << '"';
+	}
+#pragma endregion
+}
@@ -0,0 +1,572 @@
+#pragma once
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Reading result files back in and comparing two runs of the same benchmarks
+// A baseline is just the JSON file a Runner wrote, kept around from a run everybody agreed on. Benchmarks get paired
+// by name, and the raw samples of each pair go through a Mann-Whitney U test, so a difference only counts when it is
+// bigger than the noise of both runs. The shift between them is estimated with Hodges-Lehmann, which comes with a
+// confidence interval from the same ranks
+namespace Benchmark
+{
+	// Reads what Runner::WriteJson wrote, returns false and sets error when in doesn't hold a result file
+	// Only names, iteration counts, counters and samples are read, the statistics are recomputed from the samples
+	bool ReadJson(std::istream& in, std::vector<Result>& results, std::string& error);
+	bool ReadJsonFile(const std::string& path, std::vector<Result>& results, std::string& error);
+
+	struct MannWhitneyResult
+	{
+		double u = 0.0; // U of the current samples, n1 * n2 / 2 when both are the same
+		double z = 0.0; // normal approximation, corrected for ties
+		double pValue = 1.0; // two sided
+	};
+
+	// Tests whether the samples of current tend to be bigger or smaller than the samples of baseline
+	// Uses the normal approximation, which is good from about 8 samples per side, the Runner takes 25 by default
+	_NODISCARD MannWhitneyResult MannWhitneyU(const std::vector<double>& baseline, const std::vector<double>& current);
+
+	struct ShiftEstimate
+	{
+		double estimate = 0.0; // median of all differences current - baseline
+		double lower = 0.0;
+		double upper = 0.0;
+	};
+
+	// Hodges-Lehmann estimate of how much current is shifted from baseline, with a confidence interval
+	_NODISCARD ShiftEstimate HodgesLehmann(const std::vector<double>& baseline, const std::vector<double>& current, double confidence);
+
+	enum class Verdict
+	{
+		Unchanged,
+		Improved,
+		Regressed,
+		Removed, // only in the baseline
+		Added // only in the current run
+	};
+
+	_NODISCARD const char* VerdictName(Verdict verdict);
+
+	struct CompareOptions
+	{
+		// a difference is significant when the p value is below alpha
+		double alpha = 0.01;
+		// and only counts as a regression or improvement when the estimated change is bigger than this, relative to the baseline median
+		double threshold = 0.05;
+		double confidence = 0.95;
+	};
+
+	struct Comparison
+	{
+		std::string name;
+		Verdict verdict = Verdict::Unchanged;
+		double baselineMedian = 0.0; // ns per iteration
+		double currentMedian = 0.0;
+		// the Hodges-Lehmann shift and its confidence interval relative to the baseline median, 0.1 is 10% slower
+		double change = 0.0;
+		double changeLower = 0.0;
+		double changeUpper = 0.0;
+		double pValue = 1.0;
+	};
+
+	// Pairs the benchmarks by name, in the order of the current run followed by the ones that were removed
+	_NODISCARD std::vector<Comparison> Compare(const std::vector<Result>& baseline, const std::vector<Result>& current,
+		const CompareOptions& options = CompareOptions{});
+
+#pragma region Reading
+	// Just enough of a JSON parser for the result files, values it doesn't need get skipped
+	class ResultReader final
+	{
+	public:
+		explicit ResultReader(std::string_view text);
+
+		bool Read(std::vector<Result>& results, std::string& error);
+
+	private:
+		bool ReadResult(Result& result);
+		bool ReadCounters(CounterValues& counters);
+		bool ReadNumberArray(std::vector<double>& values);
+		bool ReadString(std::string& value);
+		bool ReadNumber(double& value);
+		bool SkipValue();
+		void SkipWhitespace();
+		bool Expect(char c);
+		bool Peek(char c);
+		bool Fail(const char* pMessage);
+
+		std::string_view m_Text;
+		size_t m_Pos;
+		std::string m_Error;
+	};
+
+	inline ResultReader::ResultReader(std::string_view text)
+		: m_Text{ text }
+		, m_Pos{ 0 }
+		, m_Error{}
+	{
+	}
+
+	inline bool ResultReader::Read(std::vector<Result>& results, std::string& error)
+	{
+		results.clear();
+		bool foundBenchmarks = false;
+		bool ok = Expect('{');
+		while (ok && !Peek('}'))
+		{
+			std::string key{};
+			ok = ReadString(key) && Expect(':');
+			if (ok && key == "version")
+			{
+				double version{};
+				ok = ReadNumber(version) && (version <= ResultFormatVersion || Fail("written by a newer version of the harness"));
+			}
+			else if (ok && key == "benchmarks")
+			{
+				foundBenchmarks = true;
+				ok = Expect('[');
+				// benchmarks get paired by name, so a name that shows up twice can't be compared
+				std::unordered_set<std::string> names{};
+				while (ok && !Peek(']'))
+				{
+					results.emplace_back();
+					ok = ReadResult(results.back())
+						&& (names.insert(results.back().name).second || Fail("a benchmark name appears twice"))
+						&& (Peek(']') || Expect(','));
+				}
+				ok = ok && Expect(']');
+			}
+			else if (ok)
+			{
+				ok = SkipValue();
+			}
+			ok = ok && (Peek('}') || Expect(','));
+		}
+		ok = ok && Expect('}');
+
+		if (ok && !foundBenchmarks)
+		{
+			ok = Fail("no \"benchmarks\" array");
+		}
+		if (!ok)
+		{
+			error = m_Error + " at offset " + std::to_string(m_Pos);
+			results.clear();
+		}
+		return ok;
+	}
+
+	inline bool ResultReader::ReadResult(Result& result)
+	{
+		bool ok = Expect('{');
+		while (ok && !Peek('}'))
+		{
+			std::string key{};
+			ok = ReadString(key) && Expect(':');
+			if (!ok)
+			{
+				break;
+			}
+
+			if (key == "name")
+			{
+				ok = ReadString(result.name);
+			}
+			else if (key == "iterations")
+			{
+				double iterations{};
+				ok = ReadNumber(iterations);
+				result.iterationsPerSample = static_cast<uint64_t>(iterations);
+			}
+			else if (key == "counters")
+			{
+				ok = ReadCounters(result.counters);
+			}
+			else if (key == "samples_ns")
+			{
+				ok = ReadNumberArray(result.samples);
+			}
+			else
+			{
+				ok = SkipValue();
+			}
+			ok = ok && (Peek('}') || Expect(','));
+		}
+		ok = ok && Expect('}');
+
+		if (ok && (result.name.empty() || result.samples.empty()))
+		{
+			return Fail("benchmark without a name or samples");
+		}
+		result.stats = Summarize(result.samples);
+		return ok;
+	}
+
+	inline bool ResultReader::ReadCounters(CounterValues& counters)
+	{
+		bool ok = Expect('{');
+		while (ok && !Peek('}'))
+		{
+			std::string key{};
+			double value{};
+			ok = ReadString(key) && Expect(':') && ReadNumber(value);
+			for (uint32_t i{}; ok && i < CounterCount; ++i)
+			{
+				if (key == CounterNames[i])
+				{
+					counters.values[i] = value;
+					counters.valid[i] = true;
+				}
+			}
+			ok = ok && (Peek('}') || Expect(','));
+		}
+		return ok && Expect('}');
+	}
+
+	inline bool ResultReader::ReadNumberArray(std::vector<double>& values)
+	{
+		values.clear();
+		bool ok = Expect('[');
+		while (ok && !Peek(']'))
+		{
+			double value{};
+			ok = ReadNumber(value);
+			values.push_back(value);
+			ok = ok && (Peek(']') || Expect(','));
+		}
+		return ok && Expect(']');
+	}
+
+	inline bool ResultReader::ReadString(std::string& value)
+	{
+		if (!Expect('"'))
+		{
+			return false;
+		}
+		value.clear();
+		while (m_Pos < m_Text.size() && m_Text[m_Pos] != '"')
+		{
+			char c = m_Text[m_Pos++];
+			if (c == '\\')
+			{
+				if (m_Pos >= m_Text.size())
+				{
+					break;
+				}
+				c = m_Text[m_Pos++];
+				switch (c)
+				{
+				case 'n': c = '\n'; break;
+				case 't': c = '\t'; break;
+				case 'r': c = '\r'; break;
+				case 'b': c = '\b'; break;
+				case 'f': c = '\f'; break;
+				case 'u': return Fail("\\u escapes aren't supported");
+				default: break; // \" \\ and \/ are the character itself
+				}
+			}
+			value += c;
+		}
+		if (m_Pos >= m_Text.size())
+		{
+			return Fail("unterminated string");
+		}
+		++m_Pos;
+		return true;
+	}
+
+	inline bool ResultReader::ReadNumber(double& value)
+	{
+		SkipWhitespace();
+		const std::string number{ m_Text.substr(m_Pos, m_Text.find_first_not_of("+-0123456789.eE", m_Pos) - m_Pos) };
+		char* pEnd{};
+		value = std::strtod(number.c_str(), &pEnd);
+		if (number.empty() || pEnd != number.c_str() + number.size())
+		{
+			return Fail("expected a number");
+		}
+		m_Pos += number.size();
+		return true;
+	}
+
+	inline bool ResultReader::SkipValue()
+	{
+		SkipWhitespace();
+		if (m_Pos >= m_Text.size())
+		{
+			return Fail("unexpected end");
+		}
+
+		const char c = m_Text[m_Pos];
+		if (c == '"')
+		{
+			std::string ignored{};
+			return ReadString(ignored);
+		}
+		if (c == '{' || c == '[')
+		{
+			const char close = c == '{' ? '}' : ']';
+			bool ok = Expect(c);
+			while (ok && !Peek(close))
+			{
+				if (c == '{')
+				{
+					std::string ignored{};
+					ok = ReadString(ignored) && Expect(':');
+				}
+				ok = ok && SkipValue() && (Peek(close) || Expect(','));
+			}
+			return ok && Expect(close);
+		}
+		for (std::string_view literal : { std::string_view{ "true" }, std::string_view{ "false" }, std::string_view{ "null" } })
+		{
+			if (m_Text.substr(m_Pos, literal.size()) == literal)
+			{
+				m_Pos += literal.size();
+				return true;
+			}
+		}
+		double ignored{};
+		return ReadNumber(ignored);
+	}
+
+	inline void ResultReader::SkipWhitespace()
+	{
+		while (m_Pos < m_Text.size() && (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\t' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r'))
+		{
+			++m_Pos;
+		}
+	}
+
+	inline bool ResultReader::Expect(char c)
+	{
+		SkipWhitespace();
+		if (m_Pos >= m_Text.size() || m_Text[m_Pos] != c)
+		{
+			m_Error = std::string{ "expected '" } + c + "'";
+			return false;
+		}
+		++m_Pos;
+		return true;
+	}
+
+	inline bool ResultReader::Peek(char c)
+	{
+		SkipWhitespace();
+		return m_Pos < m_Text.size() && m_Text[m_Pos] == c;
+	}
+
+	inline bool ResultReader::Fail(const char* pMessage)
+	{
+		m_Error = pMessage;
+		return false;
+	}
+
+	inline bool ReadJson(std::istream& in, std::vector<Result>& results, std::string& error)
+	{
+		const std::string text{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+		ResultReader reader{ text };
+		return reader.Read(results, error);
+	}
+
+	inline bool ReadJsonFile(const std::string& path, std::vector<Result>& results, std::string& error)
+	{
+		std::ifstream in{ path, std::ios::binary };
+		if (!in)
+		{
+			error = "couldn't open " + path;
+			return false;
+		}
+		if (!ReadJson(in, results, error))
+		{
+			error = path + ": " + error;
+			return false;
+		}
+		return true;
+	}
+#pragma endregion
+
+#pragma region Statistics
+	inline MannWhitneyResult MannWhitneyU(const std::vector<double>& baseline, const std::vector<double>& current)
+	{
+		MannWhitneyResult result{};
+		const size_t n1 = baseline.size();
+		const size_t n2 = current.size();
+		if (n1 == 0 || n2 == 0)
+		{
+			return result;
+		}
+
+		// ranks over both runs together, ties get the average of the ranks they span
+		struct Sample
+		{
+			double value;
+			bool isCurrent;
+		};
+		std::vector<Sample> combined{};
+		combined.reserve(n1 + n2);
+		for (double value : baseline)
+		{
+			combined.push_back({ value, false });
+		}
+		for (double value : current)
+		{
+			combined.push_back({ value, true });
+		}
+		std::sort(combined.begin(), combined.end(), [](const Sample& lhs, const Sample& rhs) { return lhs.value < rhs.value; });
+
+		const double n = static_cast<double>(n1 + n2);
+		double currentRankSum{};
+		double tieCorrection{};
+		for (size_t first{}; first < combined.size();)
+		{
+			size_t last = first + 1;
+			while (last < combined.size() && combined[last].value == combined[first].value)
+			{
+				++last;
+			}
+			const double averageRank = (static_cast<double>(first + 1) + static_cast<double>(last)) / 2.0;
+			for (size_t i = first; i < last; ++i)
+			{
+				currentRankSum += combined[i].isCurrent ? averageRank : 0.0;
+			}
+			const double tieCount = static_cast<double>(last - first);
+			tieCorrection += tieCount * tieCount * tieCount - tieCount;
+			first = last;
+		}
+
+		const double product = static_cast<double>(n1) * static_cast<double>(n2);
+		result.u = currentRankSum - static_cast<double>(n2) * static_cast<double>(n2 + 1) / 2.0;
+		const double mean = product / 2.0;
+		const double variance = product / 12.0 * ((n + 1.0) - tieCorrection / (n * (n - 1.0)));
+		if (variance <= 0.0)
+		{
+			return result; // every sample is the same value
+		}
+
+		// continuity correction towards the mean
+		const double distance = std::abs(result.u - mean);
+		result.z = (result.u > mean ? 1.0 : -1.0) * std::max(distance - 0.5, 0.0) / std::sqrt(variance);
+		result.pValue = std::erfc(std::abs(result.z) / std::sqrt(2.0));
+		return result;
+	}
+
+	inline ShiftEstimate HodgesLehmann(const std::vector<double>& baseline, const std::vector<double>& current, double confidence)
+	{
+		ShiftEstimate shift{};
+		if (baseline.empty() || current.empty())
+		{
+			return shift;
+		}
+
+		std::vector<double> differences{};
+		differences.reserve(baseline.size() * current.size());
+		for (double currentValue : current)
+		{
+			for (double baselineValue : baseline)
+			{
+				differences.push_back(currentValue - baselineValue);
+			}
+		}
+		std::sort(differences.begin(), differences.end());
+		shift.estimate = Percentile(differences, 50.0);
+
+		// the interval is the k-th smallest and k-th largest difference, with k from the normal approximation of U
+		// the quantile of the normal distribution is found by bisecting erfc, it doesn't need to be fast
+		const double tail = (1.0 - confidence) / 2.0;
+		double low{ 0.0 };
+		double high{ 10.0 };
+		for (uint32_t step{}; step < 64; ++step)
+		{
+			const double middle = (low + high) / 2.0;
+			(0.5 * std::erfc(middle / std::sqrt(2.0)) > tail ? low : high) = middle;
+		}
+		const double n1 = static_cast<double>(baseline.size());
+		const double n2 = static_cast<double>(current.size());
+		const double k = std::floor(n1 * n2 / 2.0 - low * std::sqrt(n1 * n2 * (n1 + n2 + 1.0) / 12.0));
+		// k is a 1 based rank
+		const size_t index = static_cast<size_t>(std::clamp(k - 1.0, 0.0, static_cast<double>(differences.size() - 1)));
+		shift.lower = differences[index];
+		shift.upper = differences[differences.size() - 1 - index];
+		return shift;
+	}
+#pragma endregion
+
+#pragma region Comparing
+	inline const char* VerdictName(Verdict verdict)
+	{
+		switch (verdict)
+		{
+		case Verdict::Improved: return "improved";
+		case Verdict::Regressed: return "REGRESSED";
+		case Verdict::Removed: return "removed";
+		case Verdict::Added: return "added";
+		default: return "unchanged";
+		}
+	}
+
+	inline std::vector<Comparison> Compare(const std::vector<Result>& baseline, const std::vector<Result>& current, const CompareOptions& options)
+	{
+		std::unordered_map<std::string, const Result*> baselineByName{};
+		for (const Result& result : baseline)
+		{
+			baselineByName.emplace(result.name, &result);
+		}
+
+		std::vector<Comparison> comparisons{};
+		for (const Result& result : current)
+		{
+			Comparison comparison{};
+			comparison.name = result.name;
+			comparison.currentMedian = result.stats.median;
+			const auto it = baselineByName.find(result.name);
+			if (it == baselineByName.end())
+			{
+				comparison.verdict = Verdict::Added;
+				comparisons.push_back(comparison);
+				continue;
+			}
+
+			const Result& before = *it->second;
+			baselineByName.erase(it);
+			comparison.baselineMedian = before.stats.median;
+			comparison.pValue = MannWhitneyU(before.samples, result.samples).pValue;
+			const ShiftEstimate shift = HodgesLehmann(before.samples, result.samples, options.confidence);
+			if (comparison.baselineMedian > 0.0)
+			{
+				comparison.change = shift.estimate / comparison.baselineMedian;
+				comparison.changeLower = shift.lower / comparison.baselineMedian;
+				comparison.changeUpper = shift.upper / comparison.baselineMedian;
+			}
+			if (comparison.pValue < options.alpha && std::abs(comparison.change) > options.threshold)
+			{
+				comparison.verdict = comparison.change > 0.0 ? Verdict::Regressed : Verdict::Improved;
+			}
+			comparisons.push_back(comparison);
+		}
+
+		for (const Result& result : baseline)
+		{
+			// erasing makes a name that is in the baseline twice show up as removed only once
+			if (baselineByName.erase(result.name) != 0)
+			{
+				Comparison comparison{};
+				comparison.name = result.name;
+				comparison.verdict = Verdict::Removed;
+				comparison.baselineMedian = result.stats.median;
+				comparisons.push_back(comparison);
+			}
+		}
+		return comparisons;
+	}
+#pragma endregion
+}
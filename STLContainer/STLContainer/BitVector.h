@@ -0,0 +1,514 @@
+#pragma once
+#include "Vector.h"
+#include "Platform.h"
+#include <bit>
+
+namespace Container
+{
+	// Stores one bit per element in 64 bit words
+	// Bits past Size() in the last word are always kept at 0, this way Count and the Find functions never have to mask them out
+	template<typename allocator = std::allocator<uint64_t>>
+	class BitVector final
+	{
+	public:
+#pragma region member types
+		using word = uint64_t;
+		static constexpr uint32_t BitsPerWord = 64;
+		static constexpr uint32_t NoBit = UINT32_MAX;
+#pragma endregion
+#pragma region De/Constructors
+		BitVector();
+		BitVector(uint32_t size, bool value = false);
+		BitVector(const BitVector& other) = default;
+		BitVector(BitVector&& other) = default;
+		BitVector& operator=(const BitVector& other) = default;
+		BitVector& operator=(BitVector&& other) = default;
+		~BitVector() = default;
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD bool Test(uint32_t pos) const;
+		_NODISCARD bool operator[](uint32_t pos) const;
+		_NODISCARD word* Data();
+		_NODISCARD const word* Data() const;
+		_NODISCARD uint32_t WordCount() const;
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		void Reserve(uint32_t newCapacity);
+		_NODISCARD uint32_t Capacity() const;
+#pragma endregion
+#pragma region Modifiers
+		void Set(uint32_t pos);
+		void Set(uint32_t pos, bool value);
+		void Reset(uint32_t pos);
+		void Flip(uint32_t pos);
+		// Range versions work on [first, last) and touch whole words wherever they can
+		void SetRange(uint32_t first, uint32_t last);
+		void ResetRange(uint32_t first, uint32_t last);
+		void FlipRange(uint32_t first, uint32_t last);
+		void SetAll();
+		void ResetAll();
+		void FlipAll();
+		void PushBack(bool value);
+		void PopBack();
+		void Resize(uint32_t newSize, bool value = false);
+		void Clear();
+		void Swap(BitVector& other);
+#pragma endregion
+#pragma region Queries
+		_NODISCARD uint32_t Count() const;
+		_NODISCARD bool Any() const;
+		_NODISCARD bool All() const;
+		_NODISCARD uint32_t FindFirstSet() const;
+		// Returns the first set bit after pos, or NoBit
+		_NODISCARD uint32_t FindNextSet(uint32_t pos) const;
+#pragma endregion
+#pragma region Bulk Operations
+		// Both bitvectors need the same size
+		BitVector& operator&=(const BitVector& other);
+		BitVector& operator|=(const BitVector& other);
+		BitVector& operator^=(const BitVector& other);
+		BitVector& AndNot(const BitVector& other);
+		_NODISCARD bool operator==(const BitVector& other) const;
+		_NODISCARD bool operator!=(const BitVector& other) const;
+#pragma endregion
+
+	private:
+		enum class BulkOp
+		{
+			And,
+			Or,
+			Xor,
+			AndNot
+		};
+
+		template<BulkOp op>
+		void ApplyBulk(const BitVector& other);
+		template<BulkOp op>
+		static word ApplyWord(word lhs, word rhs);
+		template<BulkOp op>
+		void ApplyRange(uint32_t first, uint32_t last);
+		void ClearUnusedBits();
+
+		static uint32_t WordsFor(uint32_t bits);
+		static word Mask(uint32_t pos);
+
+		Vector<word, allocator> m_Words;
+		uint32_t m_Size;
+	};
+
+	template<typename allocator>
+	inline BitVector<allocator>::BitVector()
+		: m_Words{}
+		, m_Size{ 0 }
+	{
+	}
+
+	template<typename allocator>
+	inline BitVector<allocator>::BitVector(uint32_t size, bool value)
+		: m_Words{ WordsFor(size), value ? ~word{} : word{} }
+		, m_Size{ size }
+	{
+		ClearUnusedBits();
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::Test(uint32_t pos) const
+	{
+		assert(pos < m_Size);
+		return (m_Words[pos / BitsPerWord] & Mask(pos)) != 0;
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::operator[](uint32_t pos) const
+	{
+		return (m_Words[pos / BitsPerWord] & Mask(pos)) != 0;
+	}
+
+	template<typename allocator>
+	inline typename BitVector<allocator>::word* BitVector<allocator>::Data()
+	{
+		return m_Words.Data();
+	}
+
+	template<typename allocator>
+	inline const typename BitVector<allocator>::word* BitVector<allocator>::Data() const
+	{
+		return m_Words.Data();
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::WordCount() const
+	{
+		return m_Words.Size();
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Reserve(uint32_t newCapacity)
+	{
+		m_Words.Reserve(WordsFor(newCapacity));
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::Capacity() const
+	{
+		return m_Words.Capacity() * BitsPerWord;
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Set(uint32_t pos)
+	{
+		assert(pos < m_Size);
+		m_Words[pos / BitsPerWord] |= Mask(pos);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Set(uint32_t pos, bool value)
+	{
+		assert(pos < m_Size);
+		// branchless, value either keeps or clears the bit after it got cleared
+		word& target = m_Words[pos / BitsPerWord];
+		target = (target & ~Mask(pos)) | (word{ value } << (pos % BitsPerWord));
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Reset(uint32_t pos)
+	{
+		assert(pos < m_Size);
+		m_Words[pos / BitsPerWord] &= ~Mask(pos);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Flip(uint32_t pos)
+	{
+		assert(pos < m_Size);
+		m_Words[pos / BitsPerWord] ^= Mask(pos);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::SetRange(uint32_t first, uint32_t last)
+	{
+		ApplyRange<BulkOp::Or>(first, last);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::ResetRange(uint32_t first, uint32_t last)
+	{
+		ApplyRange<BulkOp::AndNot>(first, last);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::FlipRange(uint32_t first, uint32_t last)
+	{
+		ApplyRange<BulkOp::Xor>(first, last);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::SetAll()
+	{
+		for (uint32_t i{}; i < m_Words.Size(); ++i)
+		{
+			m_Words[i] = ~word{};
+		}
+		ClearUnusedBits();
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::ResetAll()
+	{
+		std::memset(m_Words.Data(), 0, m_Words.Size() * sizeof(word));
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::FlipAll()
+	{
+		for (uint32_t i{}; i < m_Words.Size(); ++i)
+		{
+			m_Words[i] = ~m_Words[i];
+		}
+		ClearUnusedBits();
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::PushBack(bool value)
+	{
+		if (m_Size % BitsPerWord == 0)
+		{
+			m_Words.PushBack(word{});
+		}
+		++m_Size;
+		Set(m_Size - 1, value);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::PopBack()
+	{
+		assert(m_Size > 0);
+		Reset(m_Size - 1);
+		--m_Size;
+		if (m_Size % BitsPerWord == 0)
+		{
+			m_Words.PopBack();
+		}
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Resize(uint32_t newSize, bool value)
+	{
+		const uint32_t oldSize = m_Size;
+		m_Words.Resize(WordsFor(newSize));
+		m_Size = newSize;
+		if (newSize > oldSize && value)
+		{
+			SetRange(oldSize, newSize);
+		}
+		ClearUnusedBits();
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Clear()
+	{
+		m_Words.Clear();
+		m_Size = 0;
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::Swap(BitVector& other)
+	{
+		m_Words.Swap(other.m_Words);
+		std::swap(m_Size, other.m_Size);
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::Count() const
+	{
+		uint32_t count{};
+		const word* pWords = m_Words.Data();
+		for (uint32_t i{}; i < m_Words.Size(); ++i)
+		{
+			count += static_cast<uint32_t>(std::popcount(pWords[i]));
+		}
+		return count;
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::Any() const
+	{
+		return FindFirstSet() != NoBit;
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::All() const
+	{
+		return Count() == m_Size;
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::FindFirstSet() const
+	{
+		const word* pWords = m_Words.Data();
+		for (uint32_t i{}; i < m_Words.Size(); ++i)
+		{
+			if (pWords[i] != 0)
+			{
+				return i * BitsPerWord + static_cast<uint32_t>(std::countr_zero(pWords[i]));
+			}
+		}
+		return NoBit;
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::FindNextSet(uint32_t pos) const
+	{
+		++pos;
+		if (pos >= m_Size)
+		{
+			return NoBit;
+		}
+
+		const word* pWords = m_Words.Data();
+		uint32_t wordIdx = pos / BitsPerWord;
+		// drop the bits before pos in the first word, the rest can be scanned whole
+		word current = pWords[wordIdx] & (~word{} << (pos % BitsPerWord));
+		while (current == 0)
+		{
+			++wordIdx;
+			if (wordIdx >= m_Words.Size())
+			{
+				return NoBit;
+			}
+			current = pWords[wordIdx];
+		}
+		return wordIdx * BitsPerWord + static_cast<uint32_t>(std::countr_zero(current));
+	}
+
+	template<typename allocator>
+	inline BitVector<allocator>& BitVector<allocator>::operator&=(const BitVector& other)
+	{
+		ApplyBulk<BulkOp::And>(other);
+		return *this;
+	}
+
+	template<typename allocator>
+	inline BitVector<allocator>& BitVector<allocator>::operator|=(const BitVector& other)
+	{
+		ApplyBulk<BulkOp::Or>(other);
+		return *this;
+	}
+
+	template<typename allocator>
+	inline BitVector<allocator>& BitVector<allocator>::operator^=(const BitVector& other)
+	{
+		ApplyBulk<BulkOp::Xor>(other);
+		return *this;
+	}
+
+	template<typename allocator>
+	inline BitVector<allocator>& BitVector<allocator>::AndNot(const BitVector& other)
+	{
+		ApplyBulk<BulkOp::AndNot>(other);
+		return *this;
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::operator==(const BitVector& other) const
+	{
+		// unused bits are always 0 so whole words can be compared
+		return m_Size == other.m_Size && Equal(m_Words.Data(), other.m_Words.Data(), m_Words.Size());
+	}
+
+	template<typename allocator>
+	inline bool BitVector<allocator>::operator!=(const BitVector& other) const
+	{
+		return !(*this == other);
+	}
+
+	template<typename allocator>
+	template<typename BitVector<allocator>::BulkOp op>
+	inline void BitVector<allocator>::ApplyBulk(const BitVector& other)
+	{
+		assert(m_Size == other.m_Size);
+		word* pDest = m_Words.Data();
+		const word* pSrc = other.m_Words.Data();
+		const uint32_t wordCount = m_Words.Size();
+		uint32_t i{};
+
+#if CONTAINER_SSE2
+		// 2 words per instruction, andnot in SSE2 negates the first operand so the arguments get swapped
+		for (; i + 2 <= wordCount; i += 2)
+		{
+			const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDest + i));
+			const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+			__m128i result;
+			if constexpr (op == BulkOp::And)
+			{
+				result = _mm_and_si128(lhs, rhs);
+			}
+			else if constexpr (op == BulkOp::Or)
+			{
+				result = _mm_or_si128(lhs, rhs);
+			}
+			else if constexpr (op == BulkOp::Xor)
+			{
+				result = _mm_xor_si128(lhs, rhs);
+			}
+			else
+			{
+				result = _mm_andnot_si128(rhs, lhs);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + i), result);
+		}
+#endif
+
+		for (; i < wordCount; ++i)
+		{
+			pDest[i] = ApplyWord<op>(pDest[i], pSrc[i]);
+		}
+	}
+
+	template<typename allocator>
+	template<typename BitVector<allocator>::BulkOp op>
+	inline typename BitVector<allocator>::word BitVector<allocator>::ApplyWord(word lhs, word rhs)
+	{
+		if constexpr (op == BulkOp::And)
+		{
+			return lhs & rhs;
+		}
+		else if constexpr (op == BulkOp::Or)
+		{
+			return lhs | rhs;
+		}
+		else if constexpr (op == BulkOp::Xor)
+		{
+			return lhs ^ rhs;
+		}
+		else
+		{
+			return lhs & ~rhs;
+		}
+	}
+
+	template<typename allocator>
+	template<typename BitVector<allocator>::BulkOp op>
+	inline void BitVector<allocator>::ApplyRange(uint32_t first, uint32_t last)
+	{
+		assert(first <= last && last <= m_Size);
+		if (first == last)
+		{
+			return;
+		}
+
+		const uint32_t firstWord = first / BitsPerWord;
+		const uint32_t lastWord = (last - 1) / BitsPerWord;
+		const word firstMask = ~word{} << (first % BitsPerWord);
+		const word lastMask = ~word{} >> (BitsPerWord - 1 - (last - 1) % BitsPerWord);
+
+		if (firstWord == lastWord)
+		{
+			m_Words[firstWord] = ApplyWord<op>(m_Words[firstWord], firstMask & lastMask);
+			return;
+		}
+
+		m_Words[firstWord] = ApplyWord<op>(m_Words[firstWord], firstMask);
+		for (uint32_t i{ firstWord + 1 }; i < lastWord; ++i)
+		{
+			m_Words[i] = ApplyWord<op>(m_Words[i], ~word{});
+		}
+		m_Words[lastWord] = ApplyWord<op>(m_Words[lastWord], lastMask);
+	}
+
+	template<typename allocator>
+	inline void BitVector<allocator>::ClearUnusedBits()
+	{
+		const uint32_t usedInLast = m_Size % BitsPerWord;
+		if (usedInLast != 0)
+		{
+			m_Words.Back() &= ~word{} >> (BitsPerWord - usedInLast);
+		}
+	}
+
+	template<typename allocator>
+	inline uint32_t BitVector<allocator>::WordsFor(uint32_t bits)
+	{
+		return (bits + BitsPerWord - 1) / BitsPerWord;
+	}
+
+	template<typename allocator>
+	inline typename BitVector<allocator>::word BitVector<allocator>::Mask(uint32_t pos)
+	{
+		return word{ 1 } << (pos % BitsPerWord);
+	}
+}
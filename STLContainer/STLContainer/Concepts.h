@@ -1,9 +1,25 @@
 #pragma once
 #include <cstddef>
-//
-//template<typename T, typename a>
-//concept IsAllocator = requires(a allocator, size_t size)
-//{
-//	{ allocator.allocate(size) } -> T*;
-//};
-//
+#include <cstdint>
+#include <concepts>
+
+namespace Container
+{
+	// What the containers need from their allocator parameter, the rest goes through std::allocator_traits
+	template<typename a, typename T>
+	concept IsAllocator = requires(a allocator, T* pData, size_t size)
+	{
+		{ allocator.allocate(size) } -> std::same_as<T*>;
+		allocator.deallocate(pData, size);
+	};
+
+	// The callbacks Vector makes on its hooks policy, see NoHooks in VectorHooks.h
+	template<typename h>
+	concept IsVectorHooks = requires(uint32_t value, size_t bytes)
+	{
+		h::OnReallocate(value, value, value, bytes);
+		h::OnShrink(value, value, value, bytes);
+		h::OnInsertShift(value, value, bytes);
+		h::OnEraseShift(value, value, bytes);
+	};
+}
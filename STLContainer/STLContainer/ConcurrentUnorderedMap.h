@@ -0,0 +1,267 @@
+#pragma once
+#include "UnorderedMap.h"
+#include "Platform.h"
+#include "Hash.h"
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+namespace Container
+{
+	// Hash map that many threads can use at once: the keys are split over independent shards by the high bits of their
+	// hash and every shard has its own reader/writer lock, so threads only wait on each other when they hit the same shard
+	// Lookups copy the value out or visit it under the lock, references into a shard would dangle after the next rehash
+	template<typename key, typename value, typename hash = std::hash<key>, typename keyEqual = std::equal_to<key>,
+		typename allocator = std::allocator<std::pair<key, value>>>
+	class ConcurrentUnorderedMap final
+	{
+	public:
+#pragma region member types
+		using map_type = UnorderedMap<key, value, hash, keyEqual, allocator>;
+#pragma endregion
+#pragma region Deleted Functions
+		ConcurrentUnorderedMap(const ConcurrentUnorderedMap& other) = delete;
+		ConcurrentUnorderedMap(ConcurrentUnorderedMap&& other) = delete;
+		ConcurrentUnorderedMap& operator=(const ConcurrentUnorderedMap& other) = delete;
+		ConcurrentUnorderedMap& operator=(ConcurrentUnorderedMap&& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		// shardCount gets rounded up to a power of 2, a few times the amount of threads keeps collisions between writers rare
+		explicit ConcurrentUnorderedMap(uint32_t shardCount = 64);
+		~ConcurrentUnorderedMap() = default;
+#pragma endregion
+#pragma region Capacity
+		// Every shard is locked on its own, with concurrent writers the result can be outdated by the time it returns
+		_NODISCARD uint32_t Size() const;
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t ShardCount() const;
+		// Makes room for count elements spread evenly over the shards
+		void Reserve(uint32_t count);
+#pragma endregion
+#pragma region Lookup
+		// Copies the value to valueOut when k is found
+		bool Find(const key& k, value& valueOut) const;
+		_NODISCARD bool Contains(const key& k) const;
+		// Calls visitor(const value&) under a shared lock when k is found, it must not call back into the map
+		template<typename visitor>
+		bool Visit(const key& k, visitor visit) const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		// Returns false and leaves the map unchanged when k is already in there
+		bool Insert(const key& k, const value& v);
+		// Inserts or overwrites, returns true when k was new
+		bool InsertOrAssign(const key& k, const value& v);
+		// Inserts insertValue when k is missing or calls update(value&) on the existing value, with a single lookup
+		// Returns true when k was new, update must not call back into the map
+		template<typename updater>
+		bool Upsert(const key& k, const value& insertValue, updater update);
+		// Returns the value of k, creating it with makeValue() first when k is missing. makeValue only runs when it's needed
+		// and no other thread can insert k in the meantime
+		template<typename factory>
+		value ComputeIfAbsent(const key& k, factory makeValue);
+		bool Erase(const key& k);
+#pragma endregion
+
+	private:
+		// own cache line per shard, otherwise locking one shard invalidates the lock of its neighbour on other cores
+		struct alignas(CONTAINER_CACHE_LINE) Shard
+		{
+			mutable std::shared_mutex mutex;
+			map_type map;
+		};
+
+		// lets TryEmplace construct the value straight from the factory, only when the key turns out to be missing
+		template<typename factory>
+		struct LazyValue
+		{
+			factory& makeValue;
+			operator value() const { return makeValue(); }
+		};
+
+		Shard& ShardFor(const key& k);
+		const Shard& ShardFor(const key& k) const;
+
+		std::unique_ptr<Shard[]> m_pShards;
+		uint32_t m_ShardCount;
+		uint32_t m_ShardShift;
+		hash m_Hash;
+	};
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::ConcurrentUnorderedMap(uint32_t shardCount)
+		: m_pShards{}
+		, m_ShardCount{ std::bit_ceil(shardCount > 0 ? shardCount : 1) }
+		, m_ShardShift{ 0 }
+		, m_Hash{}
+	{
+		m_pShards = std::make_unique<Shard[]>(m_ShardCount);
+		// the shard comes from the top bits, the maps in the shards bucket on the lower bits
+		m_ShardShift = 64 - static_cast<uint32_t>(std::countr_zero(m_ShardCount));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Size() const
+	{
+		uint32_t size{};
+		for (uint32_t i{}; i < m_ShardCount; ++i)
+		{
+			std::shared_lock lock{ m_pShards[i].mutex };
+			size += m_pShards[i].map.Size();
+		}
+		return size;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Empty() const
+	{
+		return Size() == 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::ShardCount() const
+	{
+		return m_ShardCount;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Reserve(uint32_t count)
+	{
+		// a little headroom since the keys never spread perfectly evenly
+		const uint32_t perShard = count / m_ShardCount + count / m_ShardCount / 8 + 1;
+		for (uint32_t i{}; i < m_ShardCount; ++i)
+		{
+			std::unique_lock lock{ m_pShards[i].mutex };
+			m_pShards[i].map.Reserve(perShard);
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Find(const key& k, value& valueOut) const
+	{
+		const Shard& shard = ShardFor(k);
+		std::shared_lock lock{ shard.mutex };
+		const auto it = shard.map.Find(k);
+		if (it == shard.map.CEnd())
+		{
+			return false;
+		}
+		valueOut = it->second;
+		return true;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Contains(const key& k) const
+	{
+		const Shard& shard = ShardFor(k);
+		std::shared_lock lock{ shard.mutex };
+		return shard.map.Contains(k);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<typename visitor>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Visit(const key& k, visitor visit) const
+	{
+		const Shard& shard = ShardFor(k);
+		std::shared_lock lock{ shard.mutex };
+		const auto it = shard.map.Find(k);
+		if (it == shard.map.CEnd())
+		{
+			return false;
+		}
+		visit(static_cast<const value&>(it->second));
+		return true;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Clear()
+	{
+		for (uint32_t i{}; i < m_ShardCount; ++i)
+		{
+			std::unique_lock lock{ m_pShards[i].mutex };
+			m_pShards[i].map.Clear();
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Insert(const key& k, const value& v)
+	{
+		Shard& shard = ShardFor(k);
+		std::unique_lock lock{ shard.mutex };
+		return shard.map.TryEmplace(k, v).second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::InsertOrAssign(const key& k, const value& v)
+	{
+		Shard& shard = ShardFor(k);
+		std::unique_lock lock{ shard.mutex };
+		const auto result = shard.map.TryEmplace(k, v);
+		if (!result.second)
+		{
+			result.first->second = v;
+		}
+		return result.second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<typename updater>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Upsert(const key& k, const value& insertValue, updater update)
+	{
+		Shard& shard = ShardFor(k);
+		std::unique_lock lock{ shard.mutex };
+		const auto result = shard.map.TryEmplace(k, insertValue);
+		if (!result.second)
+		{
+			update(result.first->second);
+		}
+		return result.second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<typename factory>
+	inline value ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::ComputeIfAbsent(const key& k, factory makeValue)
+	{
+		Shard& shard = ShardFor(k);
+		{
+			// most calls find the value, those don't need to block the other readers
+			std::shared_lock lock{ shard.mutex };
+			const map_type& map = shard.map;
+			const auto it = map.Find(k);
+			if (it != map.CEnd())
+			{
+				return it->second;
+			}
+		}
+
+		std::unique_lock lock{ shard.mutex };
+		return shard.map.TryEmplace(k, LazyValue<factory>{ makeValue }).first->second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Erase(const key& k)
+	{
+		Shard& shard = ShardFor(k);
+		std::unique_lock lock{ shard.mutex };
+		return shard.map.Erase(k);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Shard& ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::ShardFor(const key& k)
+	{
+		return const_cast<Shard&>(static_cast<const ConcurrentUnorderedMap*>(this)->ShardFor(k));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline const typename ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::Shard& ConcurrentUnorderedMap<key, value, hash, keyEqual, allocator>::ShardFor(const key& k) const
+	{
+		// shifting a 64 bit value by 64 is undefined, a single shard has nothing to select
+		if (m_ShardCount == 1)
+		{
+			return m_pShards[0];
+		}
+		return m_pShards[MixHash(static_cast<uint64_t>(m_Hash(k))) >> m_ShardShift];
+	}
+}
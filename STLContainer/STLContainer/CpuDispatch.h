@@ -0,0 +1,103 @@
+#pragma once
+#include "CpuFeatures.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Runtime dispatch for the SIMD kernels, so one binary runs on every x64 CPU and still uses the widest instructions it has
+// Every kernel family (fill, find, compare, copy) has a table with one kernel per SimdTier. The first call of a family
+// binds the kernel of ActiveTier to a function pointer, every call after that goes straight through the pointer
+namespace Container
+{
+	// Instruction set levels the kernels come in, every tier includes the ones below it
+	enum class SimdTier : uint32_t
+	{
+		Scalar,
+		Sse42,
+		Avx2,
+		// F and BW
+		Avx512,
+		Count
+	};
+
+	inline constexpr uint32_t SimdTierCount = static_cast<uint32_t>(SimdTier::Count);
+	inline constexpr const char* SimdTierNames[SimdTierCount]{ "scalar", "sse4.2", "avx2", "avx512" };
+
+	// The highest tier the CPU and the OS support
+	_NODISCARD SimdTier SupportedTier();
+	// The tier the kernels get bound to: SupportedTier, unless the environment variable CONTAINER_SIMD_TIER names a lower one.
+	// It takes the names in SimdTierNames and is read once, asking for more than the CPU supports gets SupportedTier
+	_NODISCARD SimdTier ActiveTier();
+	// false for names that aren't in SimdTierNames
+	_NODISCARD bool ParseTier(const char* pName, SimdTier& tier);
+
+	// The kernel of ActiveTier out of a family's table, families without a kernel of their own for a tier repeat the one below
+	template<typename function>
+	_NODISCARD function BindKernel(const function (&kernels)[SimdTierCount]);
+
+#pragma region CpuDispatch
+	inline SimdTier SupportedTier()
+	{
+		const CpuFeatures& features = GetCpuFeatures();
+		if (features.avx512)
+		{
+			return SimdTier::Avx512;
+		}
+		if (features.avx2)
+		{
+			return SimdTier::Avx2;
+		}
+		return features.sse42 ? SimdTier::Sse42 : SimdTier::Scalar;
+	}
+
+	inline bool ParseTier(const char* pName, SimdTier& tier)
+	{
+		for (uint32_t i{}; i < SimdTierCount; ++i)
+		{
+			if (std::strcmp(pName, SimdTierNames[i]) == 0)
+			{
+				tier = static_cast<SimdTier>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	inline SimdTier ActiveTier()
+	{
+		static const SimdTier activeTier = []()
+			{
+				std::string name{};
+#if defined(_MSC_VER)
+				char* pValue{ nullptr };
+				size_t length{};
+				if (_dupenv_s(&pValue, &length, "CONTAINER_SIMD_TIER") == 0 && pValue)
+				{
+					name = pValue;
+					free(pValue);
+				}
+#else
+				if (const char* pValue = std::getenv("CONTAINER_SIMD_TIER"))
+				{
+					name = pValue;
+				}
+#endif
+				const SimdTier supported = SupportedTier();
+				SimdTier requested{ supported };
+				if (name.empty() || !ParseTier(name.c_str(), requested))
+				{
+					return supported;
+				}
+				return static_cast<uint32_t>(requested) < static_cast<uint32_t>(supported) ? requested : supported;
+			}();
+		return activeTier;
+	}
+
+	template<typename function>
+	inline function BindKernel(const function (&kernels)[SimdTierCount])
+	{
+		return kernels[static_cast<uint32_t>(ActiveTier())];
+	}
+#pragma endregion
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+#if CONTAINER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Container
+{
+	// What the CPU the program runs on can do, as opposed to what the compile flags allow
+	// Instruction sets that need OS support for their registers (AVX2, AVX-512) only count when the OS saves them
+	struct CpuFeatures
+	{
+		bool sse42{};
+		bool avx2{};
+		// F and BW, the foundation plus byte and word compares
+		bool avx512{};
+		// Enhanced rep movsb: the microcode copies whole cache lines, so rep movsb beats a vector loop on big copies
+		bool erms{};
+		// Fast short rep movsb, rep movsb is cheap to start even for short copies
+		bool fsrm{};
+		// the part of the last level cache one core gets, 0 when CPUID doesn't say
+		size_t lastLevelCachePerCore{};
+	};
+
+	// Asks CPUID the first time it is called, every call after that returns the same features
+	_NODISCARD const CpuFeatures& GetCpuFeatures();
+
+#pragma region CpuFeatures
+	namespace Detail
+	{
+#if CONTAINER_X86
+		struct CpuidRegisters
+		{
+			uint32_t eax{};
+			uint32_t ebx{};
+			uint32_t ecx{};
+			uint32_t edx{};
+		};
+
+		inline CpuidRegisters Cpuid(uint32_t leaf, uint32_t subLeaf = 0)
+		{
+			CpuidRegisters registers{};
+#if defined(_MSC_VER)
+			int values[4]{};
+			__cpuidex(values, static_cast<int>(leaf), static_cast<int>(subLeaf));
+			registers = { static_cast<uint32_t>(values[0]), static_cast<uint32_t>(values[1]), static_cast<uint32_t>(values[2]), static_cast<uint32_t>(values[3]) };
+#else
+			__cpuid_count(leaf, subLeaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif
+			return registers;
+		}
+
+		// the register state the OS saves on a context switch, only valid when CPUID reports OSXSAVE
+		inline uint64_t ReadXcr0()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t low{};
+			uint32_t high{};
+			__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+		}
+
+		// the last level in one of the cache description leaves, 0 when the leaf describes no caches
+		inline size_t LastLevelCacheFromLeaf(uint32_t cacheLeaf)
+		{
+			size_t perCore{};
+			uint32_t highestLevel{};
+			for (uint32_t index{}; index < 16; ++index)
+			{
+				const CpuidRegisters cache = Cpuid(cacheLeaf, index);
+				const uint32_t type = cache.eax & 0x1F;
+				if (type == 0)
+				{
+					break;
+				}
+				const uint32_t level = (cache.eax >> 5) & 0x7;
+				// instruction caches don't hold the data a copy goes through
+				if (type == 2 || level < highestLevel)
+				{
+					continue;
+				}
+				const size_t ways = ((cache.ebx >> 22) & 0x3FF) + 1;
+				const size_t partitions = ((cache.ebx >> 12) & 0x3FF) + 1;
+				const size_t lineSize = (cache.ebx & 0xFFF) + 1;
+				const size_t sets = static_cast<size_t>(cache.ecx) + 1;
+				const size_t sharedBy = ((cache.eax >> 14) & 0xFFF) + 1;
+				highestLevel = level;
+				perCore = ways * partitions * lineSize * sets / sharedBy;
+			}
+			return perCore;
+		}
+
+		inline size_t LastLevelCachePerCore(uint32_t maxLeaf, uint32_t maxExtendedLeaf)
+		{
+			// Intel describes every cache level in leaf 4, AMD in 0x8000001D with the same layout
+			// AMD CPUs report leaf 4 as well but leave it empty, so an empty leaf 4 falls through to the AMD one
+			size_t perCore = maxLeaf >= 4 ? LastLevelCacheFromLeaf(4) : 0;
+			if (perCore == 0 && maxExtendedLeaf >= 0x8000001D)
+			{
+				perCore = LastLevelCacheFromLeaf(0x8000001D);
+			}
+			return perCore;
+		}
+#endif
+	}
+
+	inline const CpuFeatures& GetCpuFeatures()
+	{
+		static const CpuFeatures features = []()
+			{
+				CpuFeatures detected{};
+#if CONTAINER_X86
+				const uint32_t maxLeaf = Detail::Cpuid(0).eax;
+				const uint32_t maxExtendedLeaf = Detail::Cpuid(0x80000000).eax;
+				if (maxLeaf < 1)
+				{
+					return detected;
+				}
+
+				const Detail::CpuidRegisters leaf1 = Detail::Cpuid(1);
+				detected.sse42 = (leaf1.ecx & (1u << 20)) != 0;
+				const bool osxsave = (leaf1.ecx & (1u << 27)) != 0;
+				const uint64_t xcr0 = osxsave ? Detail::ReadXcr0() : 0;
+				// XMM and YMM state for AVX, plus the opmask and both halves of the ZMM registers for AVX-512
+				const bool osAvx = (xcr0 & 0x6) == 0x6;
+				const bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+
+				if (maxLeaf >= 7)
+				{
+					const Detail::CpuidRegisters leaf7 = Detail::Cpuid(7);
+					detected.avx2 = osAvx && (leaf7.ebx & (1u << 5)) != 0;
+					detected.avx512 = osAvx512 && (leaf7.ebx & (1u << 16)) != 0 && (leaf7.ebx & (1u << 30)) != 0;
+					detected.erms = (leaf7.ebx & (1u << 9)) != 0;
+					detected.fsrm = (leaf7.edx & (1u << 4)) != 0;
+				}
+				detected.lastLevelCachePerCore = Detail::LastLevelCachePerCore(maxLeaf, maxExtendedLeaf);
+#endif
+				return detected;
+			}();
+		return features;
+	}
+#pragma endregion
+}
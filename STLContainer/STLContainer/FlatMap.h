@@ -0,0 +1,324 @@
+#pragma once
+#include "Vector.h"
+#include "Algorithm.h"
+#include <algorithm>
+#include <functional>
+
+namespace Container
+{
+	// Sorted map that keeps keys and values in two separate Vectors
+	// A lookup only binary searches the key array, so the values never pollute the cache until they are actually needed
+	template<typename key, typename value, typename compare = std::less<key>,
+		typename keyAllocator = std::allocator<key>, typename valueAllocator = std::allocator<value>>
+	class FlatMap final
+	{
+	public:
+#pragma region member types
+		using key_container = Vector<key, keyAllocator>;
+		using value_container = Vector<value, valueAllocator>;
+		static constexpr uint32_t NoIndex = UINT32_MAX;
+#pragma endregion
+#pragma region De/Constructors
+		FlatMap();
+		FlatMap(const FlatMap& other) = default;
+		FlatMap(FlatMap&& other) = default;
+		FlatMap& operator=(const FlatMap& other) = default;
+		FlatMap& operator=(FlatMap&& other) = default;
+		~FlatMap() = default;
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD value& At(const key& k);
+		_NODISCARD const value& At(const key& k) const;
+		// Inserts a default constructed value if k is missing
+		value& operator[](const key& k);
+		_NODISCARD const key& KeyAt(uint32_t idx) const;
+		_NODISCARD value& ValueAt(uint32_t idx);
+		_NODISCARD const value& ValueAt(uint32_t idx) const;
+		_NODISCARD const key_container& Keys() const;
+		_NODISCARD const value_container& Values() const;
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		void Reserve(uint32_t newCapacity);
+		void ShrinkToFit();
+#pragma endregion
+#pragma region Lookup
+		_NODISCARD uint32_t LowerBound(const key& k) const;
+		// Returns the index of k or NoIndex
+		_NODISCARD uint32_t FindIndex(const key& k) const;
+		// Returns nullptr when k is missing
+		_NODISCARD value* Find(const key& k);
+		_NODISCARD const value* Find(const key& k) const;
+		_NODISCARD bool Contains(const key& k) const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		// Returns false and leaves the old value in place if k was already in the map
+		bool Insert(const key& k, const value& v);
+		// hint is the index the key is expected to land on, passing Size() makes sorted input an O(1) append
+		// A wrong hint falls back to a normal insert
+		bool Insert(uint32_t hint, const key& k, const value& v);
+		// Appends a range of key/value pairs and restores the order with a single sort and dedup pass
+		// Keys that already were in the map keep their value, the first duplicate in the range wins otherwise
+		template<class inIt>
+		void InsertUnsorted(inIt first, inIt last);
+		bool Erase(const key& k);
+		void EraseAt(uint32_t idx);
+		void Swap(FlatMap& other);
+#pragma endregion
+
+	private:
+		bool InsertAt(uint32_t idx, const key& k, const value& v);
+		bool Equivalent(const key& lhs, const key& rhs) const;
+
+		key_container m_Keys;
+		value_container m_Values;
+		compare m_Compare;
+	};
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline FlatMap<key, value, compare, keyAllocator, valueAllocator>::FlatMap()
+		: m_Keys{}
+		, m_Values{}
+		, m_Compare{}
+	{
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline value& FlatMap<key, value, compare, keyAllocator, valueAllocator>::At(const key& k)
+	{
+		const uint32_t idx = FindIndex(k);
+		assert(idx != NoIndex);
+		return m_Values[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const value& FlatMap<key, value, compare, keyAllocator, valueAllocator>::At(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k);
+		assert(idx != NoIndex);
+		return m_Values[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline value& FlatMap<key, value, compare, keyAllocator, valueAllocator>::operator[](const key& k)
+	{
+		const uint32_t idx = LowerBound(k);
+		if (idx == m_Keys.Size() || !Equivalent(m_Keys[idx], k))
+		{
+			InsertAt(idx, k, value{});
+		}
+		return m_Values[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const key& FlatMap<key, value, compare, keyAllocator, valueAllocator>::KeyAt(uint32_t idx) const
+	{
+		return m_Keys[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline value& FlatMap<key, value, compare, keyAllocator, valueAllocator>::ValueAt(uint32_t idx)
+	{
+		return m_Values[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const value& FlatMap<key, value, compare, keyAllocator, valueAllocator>::ValueAt(uint32_t idx) const
+	{
+		return m_Values[idx];
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const typename FlatMap<key, value, compare, keyAllocator, valueAllocator>::key_container&
+		FlatMap<key, value, compare, keyAllocator, valueAllocator>::Keys() const
+	{
+		return m_Keys;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const typename FlatMap<key, value, compare, keyAllocator, valueAllocator>::value_container&
+		FlatMap<key, value, compare, keyAllocator, valueAllocator>::Values() const
+	{
+		return m_Values;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Empty() const
+	{
+		return m_Keys.Empty();
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline uint32_t FlatMap<key, value, compare, keyAllocator, valueAllocator>::Size() const
+	{
+		return m_Keys.Size();
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::Reserve(uint32_t newCapacity)
+	{
+		m_Keys.Reserve(newCapacity);
+		m_Values.Reserve(newCapacity);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::ShrinkToFit()
+	{
+		m_Keys.ShrinkToFit();
+		m_Values.ShrinkToFit();
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline uint32_t FlatMap<key, value, compare, keyAllocator, valueAllocator>::LowerBound(const key& k) const
+	{
+		return Container::LowerBound(m_Keys.Data(), m_Keys.Size(), k, m_Compare);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline uint32_t FlatMap<key, value, compare, keyAllocator, valueAllocator>::FindIndex(const key& k) const
+	{
+		const uint32_t idx = LowerBound(k);
+		return idx < m_Keys.Size() && !m_Compare(k, m_Keys[idx]) ? idx : NoIndex;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline value* FlatMap<key, value, compare, keyAllocator, valueAllocator>::Find(const key& k)
+	{
+		const uint32_t idx = FindIndex(k);
+		return idx != NoIndex ? m_Values.Data() + idx : nullptr;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline const value* FlatMap<key, value, compare, keyAllocator, valueAllocator>::Find(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k);
+		return idx != NoIndex ? m_Values.Data() + idx : nullptr;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Contains(const key& k) const
+	{
+		return FindIndex(k) != NoIndex;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::Clear()
+	{
+		m_Keys.Clear();
+		m_Values.Clear();
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Insert(const key& k, const value& v)
+	{
+		// appending sorted data is common enough to check the back before searching
+		if (m_Keys.Empty() || m_Compare(m_Keys.Back(), k))
+		{
+			m_Keys.PushBack(k);
+			m_Values.PushBack(v);
+			return true;
+		}
+		return InsertAt(LowerBound(k), k, v);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Insert(uint32_t hint, const key& k, const value& v)
+	{
+		const uint32_t size = m_Keys.Size();
+		const bool afterPrevious = hint == 0 || (hint <= size && m_Compare(m_Keys[hint - 1], k));
+		const bool beforeNext = hint >= size || !m_Compare(m_Keys[hint], k);
+		if (afterPrevious && beforeNext)
+		{
+			return InsertAt(hint, k, v);
+		}
+		return Insert(k, v);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	template<class inIt>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::InsertUnsorted(inIt first, inIt last)
+	{
+		const uint32_t oldSize = m_Keys.Size();
+		for (; first != last; ++first)
+		{
+			m_Keys.PushBack((*first).first);
+			m_Values.PushBack((*first).second);
+		}
+		const uint32_t newSize = m_Keys.Size();
+
+		// keys and values live in different arrays, so we sort a permutation and gather both arrays with it afterwards
+		Vector<uint32_t> order{ newSize };
+		for (uint32_t i{}; i < newSize; ++i)
+		{
+			order.PushBack(i);
+		}
+		const key* pKeys = m_Keys.Data();
+		auto byKey = [this, pKeys](uint32_t lhs, uint32_t rhs) { return m_Compare(pKeys[lhs], pKeys[rhs]); };
+		uint32_t* pOrder = order.Data();
+		// the old part is sorted already, stable sorting and merging keeps equal keys in insertion order
+		std::stable_sort(pOrder + oldSize, pOrder + newSize, byKey);
+		std::inplace_merge(pOrder, pOrder + oldSize, pOrder + newSize, byKey);
+
+		key_container sortedKeys{ newSize };
+		value_container sortedValues{ newSize };
+		for (uint32_t i{}; i < newSize; ++i)
+		{
+			const uint32_t idx = pOrder[i];
+			if (!sortedKeys.Empty() && Equivalent(sortedKeys.Back(), m_Keys[idx]))
+			{
+				continue;
+			}
+			sortedKeys.PushBack(std::move(m_Keys[idx]));
+			sortedValues.PushBack(std::move(m_Values[idx]));
+		}
+		m_Keys.Swap(sortedKeys);
+		m_Values.Swap(sortedValues);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Erase(const key& k)
+	{
+		const uint32_t idx = FindIndex(k);
+		if (idx == NoIndex)
+		{
+			return false;
+		}
+		EraseAt(idx);
+		return true;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::EraseAt(uint32_t idx)
+	{
+		m_Keys.Erase(m_Keys.CBegin() + static_cast<int32_t>(idx));
+		m_Values.Erase(m_Values.CBegin() + static_cast<int32_t>(idx));
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline void FlatMap<key, value, compare, keyAllocator, valueAllocator>::Swap(FlatMap& other)
+	{
+		m_Keys.Swap(other.m_Keys);
+		m_Values.Swap(other.m_Values);
+		std::swap(m_Compare, other.m_Compare);
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::InsertAt(uint32_t idx, const key& k, const value& v)
+	{
+		if (idx < m_Keys.Size() && Equivalent(m_Keys[idx], k))
+		{
+			return false;
+		}
+		m_Keys.Insert(m_Keys.CBegin() + static_cast<int32_t>(idx), k);
+		m_Values.Insert(m_Values.CBegin() + static_cast<int32_t>(idx), v);
+		return true;
+	}
+
+	template<typename key, typename value, typename compare, typename keyAllocator, typename valueAllocator>
+	inline bool FlatMap<key, value, compare, keyAllocator, valueAllocator>::Equivalent(const key& lhs, const key& rhs) const
+	{
+		return !m_Compare(lhs, rhs) && !m_Compare(rhs, lhs);
+	}
+}
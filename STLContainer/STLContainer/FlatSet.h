@@ -0,0 +1,249 @@
+#pragma once
+#include "Vector.h"
+#include "Algorithm.h"
+#include <algorithm>
+#include <functional>
+
+namespace Container
+{
+	// Sorted set stored in one contiguous Vector, lookups are a binary search over the keys
+	// Inserting in the middle shifts the tail, so bulk loads should go through InsertUnsorted or hinted inserts
+	template<typename key, typename compare = std::less<key>, typename allocator = std::allocator<key>>
+	class FlatSet final
+	{
+	public:
+#pragma region member types
+		using const_iterator = ConstIterator<key>;
+		static constexpr uint32_t NoIndex = UINT32_MAX;
+#pragma endregion
+#pragma region Iterator Functions
+		_NODISCARD const_iterator CBegin() const;
+		_NODISCARD const_iterator CEnd() const;
+#pragma endregion
+#pragma region De/Constructors
+		FlatSet();
+		FlatSet(const FlatSet& other) = default;
+		FlatSet(FlatSet&& other) = default;
+		FlatSet& operator=(const FlatSet& other) = default;
+		FlatSet& operator=(FlatSet&& other) = default;
+		~FlatSet() = default;
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD const key& operator[](uint32_t idx) const;
+		_NODISCARD const key* Data() const;
+		_NODISCARD const Vector<key, allocator>& Keys() const;
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		void Reserve(uint32_t newCapacity);
+		_NODISCARD uint32_t Capacity() const;
+		void ShrinkToFit();
+#pragma endregion
+#pragma region Lookup
+		_NODISCARD uint32_t LowerBound(const key& value) const;
+		// Returns the index of value or NoIndex
+		_NODISCARD uint32_t Find(const key& value) const;
+		_NODISCARD bool Contains(const key& value) const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		// Returns false if the key was already in the set
+		bool Insert(const key& value);
+		// hint is the index the key is expected to land on, passing Size() makes sorted input an O(1) append
+		// A wrong hint falls back to a normal insert
+		bool Insert(uint32_t hint, const key& value);
+		// Appends the whole range and restores the order with a single sort and dedup pass
+		template<class inIt>
+		void InsertUnsorted(inIt first, inIt last);
+		bool Erase(const key& value);
+		void EraseAt(uint32_t idx);
+		void Swap(FlatSet& other);
+#pragma endregion
+
+	private:
+		bool InsertAt(uint32_t idx, const key& value);
+		bool Equivalent(const key& lhs, const key& rhs) const;
+
+		Vector<key, allocator> m_Keys;
+		compare m_Compare;
+	};
+
+	template<typename key, typename compare, typename allocator>
+	inline FlatSet<key, compare, allocator>::FlatSet()
+		: m_Keys{}
+		, m_Compare{}
+	{
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline typename FlatSet<key, compare, allocator>::const_iterator FlatSet<key, compare, allocator>::CBegin() const
+	{
+		return m_Keys.CBegin();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline typename FlatSet<key, compare, allocator>::const_iterator FlatSet<key, compare, allocator>::CEnd() const
+	{
+		return m_Keys.CEnd();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline const key& FlatSet<key, compare, allocator>::operator[](uint32_t idx) const
+	{
+		return m_Keys[idx];
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline const key* FlatSet<key, compare, allocator>::Data() const
+	{
+		return m_Keys.Data();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline const Vector<key, allocator>& FlatSet<key, compare, allocator>::Keys() const
+	{
+		return m_Keys;
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Empty() const
+	{
+		return m_Keys.Empty();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline uint32_t FlatSet<key, compare, allocator>::Size() const
+	{
+		return m_Keys.Size();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline void FlatSet<key, compare, allocator>::Reserve(uint32_t newCapacity)
+	{
+		m_Keys.Reserve(newCapacity);
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline uint32_t FlatSet<key, compare, allocator>::Capacity() const
+	{
+		return m_Keys.Capacity();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline void FlatSet<key, compare, allocator>::ShrinkToFit()
+	{
+		m_Keys.ShrinkToFit();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline uint32_t FlatSet<key, compare, allocator>::LowerBound(const key& value) const
+	{
+		return Container::LowerBound(m_Keys.Data(), m_Keys.Size(), value, m_Compare);
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline uint32_t FlatSet<key, compare, allocator>::Find(const key& value) const
+	{
+		const uint32_t idx = LowerBound(value);
+		return idx < m_Keys.Size() && !m_Compare(value, m_Keys[idx]) ? idx : NoIndex;
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Contains(const key& value) const
+	{
+		return Find(value) != NoIndex;
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline void FlatSet<key, compare, allocator>::Clear()
+	{
+		m_Keys.Clear();
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Insert(const key& value)
+	{
+		// appending sorted data is common enough to check the back before searching
+		if (m_Keys.Empty() || m_Compare(m_Keys.Back(), value))
+		{
+			m_Keys.PushBack(value);
+			return true;
+		}
+		return InsertAt(LowerBound(value), value);
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Insert(uint32_t hint, const key& value)
+	{
+		const uint32_t size = m_Keys.Size();
+		const bool afterPrevious = hint == 0 || (hint <= size && m_Compare(m_Keys[hint - 1], value));
+		const bool beforeNext = hint >= size || !m_Compare(m_Keys[hint], value);
+		if (afterPrevious && beforeNext)
+		{
+			return InsertAt(hint, value);
+		}
+		return Insert(value);
+	}
+
+	template<typename key, typename compare, typename allocator>
+	template<class inIt>
+	inline void FlatSet<key, compare, allocator>::InsertUnsorted(inIt first, inIt last)
+	{
+		const uint32_t oldSize = m_Keys.Size();
+		for (; first != last; ++first)
+		{
+			m_Keys.PushBack(*first);
+		}
+
+		key* pBegin = m_Keys.Data();
+		key* pEnd = pBegin + m_Keys.Size();
+		// the old keys are already sorted, so only the new part needs a full sort before merging
+		std::sort(pBegin + oldSize, pEnd, m_Compare);
+		std::inplace_merge(pBegin, pBegin + oldSize, pEnd, m_Compare);
+		key* pUniqueEnd = std::unique(pBegin, pEnd, [this](const key& lhs, const key& rhs) { return Equivalent(lhs, rhs); });
+		m_Keys.Erase(m_Keys.CBegin() + static_cast<int32_t>(pUniqueEnd - pBegin), m_Keys.CEnd());
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Erase(const key& value)
+	{
+		const uint32_t idx = Find(value);
+		if (idx == NoIndex)
+		{
+			return false;
+		}
+		EraseAt(idx);
+		return true;
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline void FlatSet<key, compare, allocator>::EraseAt(uint32_t idx)
+	{
+		m_Keys.Erase(m_Keys.CBegin() + static_cast<int32_t>(idx));
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline void FlatSet<key, compare, allocator>::Swap(FlatSet& other)
+	{
+		m_Keys.Swap(other.m_Keys);
+		std::swap(m_Compare, other.m_Compare);
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::InsertAt(uint32_t idx, const key& value)
+	{
+		if (idx < m_Keys.Size() && Equivalent(m_Keys[idx], value))
+		{
+			return false;
+		}
+		m_Keys.Insert(m_Keys.CBegin() + static_cast<int32_t>(idx), value);
+		return true;
+	}
+
+	template<typename key, typename compare, typename allocator>
+	inline bool FlatSet<key, compare, allocator>::Equivalent(const key& lhs, const key& rhs) const
+	{
+		return !m_Compare(lhs, rhs) && !m_Compare(rhs, lhs);
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace Container
+{
+	// std::hash is the identity for integers on most standard libraries, open addressing tables take their
+	// bucket from the high bits and a tag from the low bits, so both ends need to depend on every input bit
+	inline uint64_t MixHash(uint64_t hash)
+	{
+		hash ^= hash >> 32;
+		hash *= 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 29;
+		return hash;
+	}
+}
@@ -0,0 +1,274 @@
+#pragma once
+#include "Platform.h"
+#include "StreamFormat.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+#if CONTAINER_SSE2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// For timing single operations instead of loops of them, where what matters is the worst case and not the average
+namespace Benchmark
+{
+	// The time stamp counter where there is one, steady_clock everywhere else
+	// Reading the TSC takes a couple of nanoseconds, so it can time operations that take about as long as steady_clock::now().
+	// It assumes an invariant TSC, which every x64 CPU of the last decade has, and doesn't order itself with the
+	// surrounding instructions, so single readings are off by a few cycles either way
+	class CycleClock final
+	{
+	public:
+		CycleClock() = delete;
+
+		_NODISCARD static CONTAINER_FORCEINLINE uint64_t Now();
+		// measured against steady_clock the first time it is called, which takes about 20 ms
+		_NODISCARD static double NsPerTick();
+	};
+
+	// Log-linear histogram like HdrHistogram: every power of 2 range is split into SubBucketCount / 2 equal buckets,
+	// so a value is off by at most 1 / (SubBucketCount / 2) of itself, 0.8%, from 0 up to the whole uint64_t range.
+	// Recording is a bit scan and an increment, the buckets take about 60 KB
+	// Values are recorded in ticks and reported in nanoseconds
+	class LatencyHistogram final
+	{
+	public:
+		static constexpr uint32_t SubBucketBits = 8;
+		static constexpr uint32_t SubBucketCount = 1 << SubBucketBits;
+
+		explicit LatencyHistogram(double nsPerTick = 1.0);
+
+		CONTAINER_FORCEINLINE void Record(uint64_t ticks);
+		void Merge(const LatencyHistogram& other);
+		void Reset();
+
+		_NODISCARD uint64_t Count() const;
+		_NODISCARD double Min() const;
+		_NODISCARD double Max() const;
+		_NODISCARD double Mean() const;
+		_NODISCARD double StdDev() const;
+		// the highest value of the bucket that holds the percentile, like HdrHistogram reports it
+		_NODISCARD double Percentile(double percentile) const;
+
+		// One row per used bucket with the value, the percentile up to and including it, the count up to it and 1/(1-percentile),
+		// in the .hgrm layout HdrHistogram writes, so its plotting tools can read it
+		void WriteDistribution(std::ostream& out) const;
+		// Count, mean and the percentiles from p50 to p99.999 and the max in one line
+		void PrintSummary(std::ostream& out) const;
+
+	private:
+		_NODISCARD static uint32_t BucketIndex(uint64_t ticks);
+		_NODISCARD static uint64_t HighestTicksInBucket(uint32_t index);
+
+		std::vector<uint64_t> m_Counts;
+		uint64_t m_TotalCount;
+		uint64_t m_MinTicks;
+		uint64_t m_MaxTicks;
+		double m_NsPerTick;
+	};
+
+#pragma region CycleClock
+	inline uint64_t CycleClock::Now()
+	{
+#if CONTAINER_SSE2
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	inline double CycleClock::NsPerTick()
+	{
+#if CONTAINER_SSE2
+		static const double nsPerTick = []()
+			{
+				const auto startTime = std::chrono::steady_clock::now();
+				const uint64_t startTicks = Now();
+				while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds{ 20 })
+				{
+				}
+				const uint64_t ticks = Now() - startTicks;
+				const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+				return ns / static_cast<double>(ticks);
+			}();
+		return nsPerTick;
+#else
+		return 1.0;
+#endif
+	}
+#pragma endregion
+
+#pragma region LatencyHistogram
+	inline LatencyHistogram::LatencyHistogram(double nsPerTick)
+		: m_Counts((64 - SubBucketBits + 2) * (SubBucketCount / 2), 0)
+		, m_TotalCount{ 0 }
+		, m_MinTicks{ UINT64_MAX }
+		, m_MaxTicks{ 0 }
+		, m_NsPerTick{ nsPerTick }
+	{
+	}
+
+	inline uint32_t LatencyHistogram::BucketIndex(uint64_t ticks)
+	{
+		// values below SubBucketCount get a bucket each, above that the top SubBucketBits bits pick the bucket
+		const uint32_t width = static_cast<uint32_t>(std::bit_width(ticks));
+		const uint32_t shift = width > SubBucketBits ? width - SubBucketBits : 0;
+		return shift * (SubBucketCount / 2) + static_cast<uint32_t>(ticks >> shift);
+	}
+
+	inline uint64_t LatencyHistogram::HighestTicksInBucket(uint32_t index)
+	{
+		if (index < SubBucketCount)
+		{
+			return index;
+		}
+		const uint32_t shift = index / (SubBucketCount / 2) - 1;
+		const uint64_t subBucket = index - shift * (SubBucketCount / 2);
+		return ((subBucket + 1) << shift) - 1;
+	}
+
+	inline void LatencyHistogram::Record(uint64_t ticks)
+	{
+		++m_Counts[BucketIndex(ticks)];
+		++m_TotalCount;
+		m_MinTicks = ticks < m_MinTicks ? ticks : m_MinTicks;
+		m_MaxTicks = ticks > m_MaxTicks ? ticks : m_MaxTicks;
+	}
+
+	inline void LatencyHistogram::Merge(const LatencyHistogram& other)
+	{
+		for (size_t i{}; i < m_Counts.size(); ++i)
+		{
+			m_Counts[i] += other.m_Counts[i];
+		}
+		m_TotalCount += other.m_TotalCount;
+		m_MinTicks = std::min(m_MinTicks, other.m_MinTicks);
+		m_MaxTicks = std::max(m_MaxTicks, other.m_MaxTicks);
+	}
+
+	inline void LatencyHistogram::Reset()
+	{
+		std::fill(m_Counts.begin(), m_Counts.end(), 0);
+		m_TotalCount = 0;
+		m_MinTicks = UINT64_MAX;
+		m_MaxTicks = 0;
+	}
+
+	inline uint64_t LatencyHistogram::Count() const
+	{
+		return m_TotalCount;
+	}
+
+	inline double LatencyHistogram::Min() const
+	{
+		return m_TotalCount == 0 ? 0.0 : static_cast<double>(m_MinTicks) * m_NsPerTick;
+	}
+
+	inline double LatencyHistogram::Max() const
+	{
+		return static_cast<double>(m_MaxTicks) * m_NsPerTick;
+	}
+
+	inline double LatencyHistogram::Mean() const
+	{
+		if (m_TotalCount == 0)
+		{
+			return 0.0;
+		}
+		// the middle of every bucket stands in for the values in it
+		double sum{};
+		for (uint32_t i{}; i < m_Counts.size(); ++i)
+		{
+			if (m_Counts[i] != 0)
+			{
+				const double low = static_cast<double>(i == 0 ? 0 : HighestTicksInBucket(i - 1) + 1);
+				sum += (low + static_cast<double>(HighestTicksInBucket(i))) / 2.0 * static_cast<double>(m_Counts[i]);
+			}
+		}
+		return sum / static_cast<double>(m_TotalCount) * m_NsPerTick;
+	}
+
+	inline double LatencyHistogram::StdDev() const
+	{
+		if (m_TotalCount == 0)
+		{
+			return 0.0;
+		}
+		const double mean = Mean() / m_NsPerTick;
+		double squares{};
+		for (uint32_t i{}; i < m_Counts.size(); ++i)
+		{
+			if (m_Counts[i] != 0)
+			{
+				const double low = static_cast<double>(i == 0 ? 0 : HighestTicksInBucket(i - 1) + 1);
+				const double deviation = (low + static_cast<double>(HighestTicksInBucket(i))) / 2.0 - mean;
+				squares += deviation * deviation * static_cast<double>(m_Counts[i]);
+			}
+		}
+		return std::sqrt(squares / static_cast<double>(m_TotalCount)) * m_NsPerTick;
+	}
+
+	inline double LatencyHistogram::Percentile(double percentile) const
+	{
+		if (m_TotalCount == 0)
+		{
+			return 0.0;
+		}
+		const double wanted = std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(m_TotalCount));
+		const uint64_t target = std::max<uint64_t>(static_cast<uint64_t>(wanted), 1);
+		uint64_t count{};
+		for (uint32_t i{}; i < m_Counts.size(); ++i)
+		{
+			count += m_Counts[i];
+			if (count >= target)
+			{
+				return static_cast<double>(std::min(HighestTicksInBucket(i), m_MaxTicks)) * m_NsPerTick;
+			}
+		}
+		return Max();
+	}
+
+	inline void LatencyHistogram::WriteDistribution(std::ostream& out) const
+	{
+		const StreamFormatGuard formatGuard{ out };
+		out << std::fixed << std::setw(12) << "Value" << std::setw(15) << "Percentile" << std::setw(11) << "TotalCount" << std::setw(17) << "1/(1-Percentile)" << "\n\n";
+		uint64_t count{};
+		for (uint32_t i{}; i < m_Counts.size(); ++i)
+		{
+			if (m_Counts[i] == 0)
+			{
+				continue;
+			}
+			count += m_Counts[i];
+			const double fraction = static_cast<double>(count) / static_cast<double>(m_TotalCount);
+			out << std::setprecision(3) << std::setw(12) << static_cast<double>(std::min(HighestTicksInBucket(i), m_MaxTicks)) * m_NsPerTick
+				<< std::setprecision(12) << std::setw(15) << fraction << std::setw(11) << count;
+			if (count < m_TotalCount)
+			{
+				out << std::setprecision(2) << std::setw(17) << 1.0 / (1.0 - fraction);
+			}
+			out << "\n";
+		}
+		out << std::setprecision(3) << "#[Mean    = " << std::setw(12) << Mean() << ", StdDeviation   = " << std::setw(12) << StdDev() << "]\n"
+			<< "#[Max     = " << std::setw(12) << Max() << ", Total count    = " << std::setw(12) << m_TotalCount << "]\n"
+			<< "#[Buckets = " << std::setw(12) << m_Counts.size() << ", SubBuckets     = " << std::setw(12) << SubBucketCount << "]\n";
+	}
+
+	inline void LatencyHistogram::PrintSummary(std::ostream& out) const
+	{
+		const StreamFormatGuard formatGuard{ out };
+		out << std::fixed << std::setprecision(1) << "count " << m_TotalCount << "  mean " << Mean()
+			<< "  p50 " << Percentile(50.0) << "  p90 " << Percentile(90.0) << "  p99 " << Percentile(99.0)
+			<< "  p99.9 " << Percentile(99.9) << "  p99.99 " << Percentile(99.99) << "  p99.999 " << Percentile(99.999)
+			<< "  max " << Max() << " ns" << std::endl;
+	}
+#pragma endregion
+}
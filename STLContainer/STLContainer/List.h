@@ -0,0 +1,1031 @@
+#pragma once
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace Container
+{
+	// Links of a circular doubly linked list, List keeps one in every node and IntrusiveList expects its elements to
+	// derive from it, so the links live inside the user's object and linking never allocates
+	class ListHook
+	{
+	public:
+		ListHook();
+		// a copy isn't part of the original's list
+		ListHook(const ListHook& other);
+		ListHook& operator=(const ListHook& other);
+		~ListHook() = default;
+
+		_NODISCARD bool IsLinked() const;
+		_NODISCARD ListHook* Next() const;
+		_NODISCARD ListHook* Prev() const;
+		// Links this hook in right before pPos
+		void LinkBefore(ListHook* pPos);
+		// Moves [pFirst, pLast] (inclusive, in list order) right before this hook
+		void TransferBefore(ListHook* pFirst, ListHook* pLast);
+		void Unlink();
+		// makes this hook the sentinel of an empty list
+		void MakeSentinel();
+
+	private:
+		ListHook* m_pPrev;
+		ListHook* m_pNext;
+	};
+
+	// Bidirectional iterator over hooks, accessor turns a hook into the element it belongs to
+	template<typename valueType, typename accessor>
+	class ListIterator final
+	{
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = std::remove_const_t<valueType>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = valueType*;
+		using reference = valueType&;
+
+		ListIterator();
+		explicit ListIterator(ListHook* pHook);
+		// iterator to const_iterator
+		template<typename otherValueType> requires std::is_same<const otherValueType, valueType>::value && (!std::is_const<otherValueType>::value)
+		ListIterator(const ListIterator<otherValueType, accessor>& other);
+
+		_NODISCARD valueType& operator*() const;
+		_NODISCARD valueType* operator->() const;
+		ListIterator& operator++();
+		ListIterator operator++(int);
+		ListIterator& operator--();
+		ListIterator operator--(int);
+		bool operator==(const ListIterator& rhs) const;
+		bool operator!=(const ListIterator& rhs) const;
+
+		_NODISCARD ListHook* Hook() const;
+
+	private:
+		ListHook* m_pHook;
+	};
+
+	template<typename type>
+	class ListNode final : public ListHook
+	{
+	public:
+		ListNode() {}
+		~ListNode() {}
+		// only constructed while the node is in a list, the free list reuses nodes without a value
+		union
+		{
+			type value;
+		};
+	};
+
+	// Doubly linked list that keeps the nodes of erased elements on a free list and reuses them for the next inserts,
+	// so a list with a steady size stops allocating. Reserve fills the free list up front and ShrinkToFit releases it
+	template<typename type, typename allocator = std::allocator<type>>
+	class List final
+	{
+		struct NodeAccess
+		{
+			static type* Get(ListHook* pHook) { return &static_cast<ListNode<type>*>(pHook)->value; }
+		};
+	public:
+#pragma region member types
+		using value_type = type;
+		using iterator = ListIterator<type, NodeAccess>;
+		using const_iterator = ListIterator<const type, NodeAccess>;
+#pragma endregion
+#pragma region Iterator Functions
+		_NODISCARD iterator Begin();
+		_NODISCARD iterator End();
+		_NODISCARD const_iterator CBegin() const;
+		_NODISCARD const_iterator CEnd() const;
+#pragma endregion
+#pragma region De/Constructors
+		List();
+		explicit List(const allocator& alloc);
+		List(const List& other);
+		List(List&& other) noexcept;
+		List& operator=(const List& other);
+		// Only takes over the nodes of other when the allocator propagates or both are equal, otherwise moves the elements one by one
+		List& operator=(List&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+			|| std::allocator_traits<allocator>::is_always_equal::value);
+		~List();
+#pragma endregion
+#pragma region Element Access
+		_NODISCARD type& Front();
+		_NODISCARD const type& Front() const;
+		_NODISCARD type& Back();
+		_NODISCARD const type& Back() const;
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		// Makes sure count elements fit without allocating
+		void Reserve(uint32_t count);
+		// Releases the recycled nodes
+		void ShrinkToFit();
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		void PushBack(const type& value);
+		void PushBack(type&& value);
+		void PushFront(const type& value);
+		void PushFront(type&& value);
+		template<class... ARGS>
+		type& EmplaceBack(ARGS&&... args);
+		template<class... ARGS>
+		type& EmplaceFront(ARGS&&... args);
+		template<class... ARGS>
+		iterator Emplace(const_iterator pos, ARGS&&... args);
+		iterator Insert(const_iterator pos, const type& value);
+		iterator Insert(const_iterator pos, type&& value);
+		void PopBack();
+		void PopFront();
+		// Returns the element after pos
+		iterator Erase(const_iterator pos);
+		// Moves all elements of other before pos, other has to use an equal allocator
+		void Splice(const_iterator pos, List& other);
+		// Moves the element at it from other before pos, other can be this list
+		void Splice(const_iterator pos, List& other, const_iterator it);
+		void MoveToFront(const_iterator it);
+		void MoveToBack(const_iterator it);
+		// Only swaps the allocators when they propagate on swap, otherwise they have to be equal like with the std containers
+		void Swap(List& other) noexcept;
+#pragma endregion
+
+	private:
+		using node = ListNode<type>;
+		using nodeAllocator = typename std::allocator_traits<allocator>::template rebind_alloc<node>;
+		using nodeTraits = std::allocator_traits<nodeAllocator>;
+
+		node* AcquireNode();
+		void ReleaseNode(node* pNode);
+		void ReleaseFreeNodes();
+		void TakeFrom(List& other);
+		bool AllocatorEquals(const List& other) const;
+		static ListHook* Mutable(const_iterator pos);
+
+		ListHook m_Sentinel;
+		ListHook m_FreeNodes; // sentinel of the recycled nodes, they keep no value
+		uint32_t m_Size;
+		uint32_t m_FreeCount;
+		nodeAllocator m_Allocator;
+	};
+
+	// Doubly linked list of objects that derive from ListHook, it never owns, copies or allocates its elements
+	// An element can be in one IntrusiveList at a time and has to be removed before it's destroyed
+	template<typename type>
+	class IntrusiveList final
+	{
+		static_assert(std::is_base_of<ListHook, type>::value, "IntrusiveList elements have to derive from ListHook");
+		struct HookAccess
+		{
+			static type* Get(ListHook* pHook) { return static_cast<type*>(pHook); }
+		};
+	public:
+#pragma region member types
+		using value_type = type;
+		using iterator = ListIterator<type, HookAccess>;
+		using const_iterator = ListIterator<const type, HookAccess>;
+#pragma endregion
+#pragma region Deleted Functions
+		IntrusiveList(const IntrusiveList& other) = delete;
+		IntrusiveList& operator=(const IntrusiveList& other) = delete;
+#pragma endregion
+#pragma region Iterator Functions
+		_NODISCARD iterator Begin();
+		_NODISCARD iterator End();
+		_NODISCARD const_iterator CBegin() const;
+		_NODISCARD const_iterator CEnd() const;
+		_NODISCARD iterator IteratorTo(type& element);
+#pragma endregion
+#pragma region De/Constructors
+		IntrusiveList();
+		IntrusiveList(IntrusiveList&& other) noexcept;
+		IntrusiveList& operator=(IntrusiveList&& other) noexcept;
+		// unlinks the elements that are still in there
+		~IntrusiveList();
+#pragma endregion
+#pragma region Element Access
+		_NODISCARD type& Front();
+		_NODISCARD type& Back();
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		void PushBack(type& element);
+		void PushFront(type& element);
+		iterator Insert(const_iterator pos, type& element);
+		type& PopBack();
+		type& PopFront();
+		// Returns the element after pos
+		iterator Erase(const_iterator pos);
+		void Remove(type& element);
+		void Splice(const_iterator pos, IntrusiveList& other);
+		void Splice(const_iterator pos, IntrusiveList& other, const_iterator it);
+		void MoveToFront(type& element);
+		void MoveToBack(type& element);
+#pragma endregion
+
+	private:
+		static ListHook* Mutable(const_iterator pos);
+
+		ListHook m_Sentinel;
+		uint32_t m_Size;
+	};
+
+#pragma region ListHook
+	inline ListHook::ListHook()
+		: m_pPrev{ nullptr }
+		, m_pNext{ nullptr }
+	{
+	}
+
+	inline ListHook::ListHook(const ListHook&)
+		: ListHook()
+	{
+	}
+
+	inline ListHook& ListHook::operator=(const ListHook&)
+	{
+		return *this;
+	}
+
+	inline bool ListHook::IsLinked() const
+	{
+		return m_pNext != nullptr;
+	}
+
+	inline ListHook* ListHook::Next() const
+	{
+		return m_pNext;
+	}
+
+	inline ListHook* ListHook::Prev() const
+	{
+		return m_pPrev;
+	}
+
+	inline void ListHook::LinkBefore(ListHook* pPos)
+	{
+		assert(!IsLinked());
+		m_pNext = pPos;
+		m_pPrev = pPos->m_pPrev;
+		m_pPrev->m_pNext = this;
+		pPos->m_pPrev = this;
+	}
+
+	inline void ListHook::TransferBefore(ListHook* pFirst, ListHook* pLast)
+	{
+		if (pFirst == this || pLast->m_pNext == this)
+		{
+			return;
+		}
+
+		// cut [pFirst, pLast] out
+		pFirst->m_pPrev->m_pNext = pLast->m_pNext;
+		pLast->m_pNext->m_pPrev = pFirst->m_pPrev;
+		// and put it back in front of this
+		pFirst->m_pPrev = m_pPrev;
+		pLast->m_pNext = this;
+		m_pPrev->m_pNext = pFirst;
+		m_pPrev = pLast;
+	}
+
+	inline void ListHook::Unlink()
+	{
+		assert(IsLinked());
+		m_pPrev->m_pNext = m_pNext;
+		m_pNext->m_pPrev = m_pPrev;
+		m_pPrev = nullptr;
+		m_pNext = nullptr;
+	}
+
+	inline void ListHook::MakeSentinel()
+	{
+		m_pPrev = this;
+		m_pNext = this;
+	}
+#pragma endregion
+
+#pragma region ListIterator
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor>::ListIterator()
+		: m_pHook{ nullptr }
+	{
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor>::ListIterator(ListHook* pHook)
+		: m_pHook{ pHook }
+	{
+	}
+
+	template<typename valueType, typename accessor>
+	template<typename otherValueType> requires std::is_same<const otherValueType, valueType>::value && (!std::is_const<otherValueType>::value)
+	inline ListIterator<valueType, accessor>::ListIterator(const ListIterator<otherValueType, accessor>& other)
+		: m_pHook{ other.Hook() }
+	{
+	}
+
+	template<typename valueType, typename accessor>
+	inline valueType& ListIterator<valueType, accessor>::operator*() const
+	{
+		return *accessor::Get(m_pHook);
+	}
+
+	template<typename valueType, typename accessor>
+	inline valueType* ListIterator<valueType, accessor>::operator->() const
+	{
+		return accessor::Get(m_pHook);
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor>& ListIterator<valueType, accessor>::operator++()
+	{
+		m_pHook = m_pHook->Next();
+		return *this;
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor> ListIterator<valueType, accessor>::operator++(int)
+	{
+		ListIterator temp = *this;
+		m_pHook = m_pHook->Next();
+		return temp;
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor>& ListIterator<valueType, accessor>::operator--()
+	{
+		m_pHook = m_pHook->Prev();
+		return *this;
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListIterator<valueType, accessor> ListIterator<valueType, accessor>::operator--(int)
+	{
+		ListIterator temp = *this;
+		m_pHook = m_pHook->Prev();
+		return temp;
+	}
+
+	template<typename valueType, typename accessor>
+	inline bool ListIterator<valueType, accessor>::operator==(const ListIterator& rhs) const
+	{
+		return m_pHook == rhs.m_pHook;
+	}
+
+	template<typename valueType, typename accessor>
+	inline bool ListIterator<valueType, accessor>::operator!=(const ListIterator& rhs) const
+	{
+		return m_pHook != rhs.m_pHook;
+	}
+
+	template<typename valueType, typename accessor>
+	inline ListHook* ListIterator<valueType, accessor>::Hook() const
+	{
+		return m_pHook;
+	}
+#pragma endregion
+
+#pragma region List
+	template<typename type, typename allocator>
+	inline List<type, allocator>::List()
+		: List(allocator{})
+	{
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>::List(const allocator& alloc)
+		: m_Sentinel{}
+		, m_FreeNodes{}
+		, m_Size{ 0 }
+		, m_FreeCount{ 0 }
+		, m_Allocator{ alloc }
+	{
+		m_Sentinel.MakeSentinel();
+		m_FreeNodes.MakeSentinel();
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>::List(const List& other)
+		: List(allocator{ nodeTraits::select_on_container_copy_construction(other.m_Allocator) })
+	{
+		for (const_iterator it = other.CBegin(); it != other.CEnd(); ++it)
+		{
+			PushBack(*it);
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>::List(List&& other) noexcept
+		: m_Sentinel{}
+		, m_FreeNodes{}
+		, m_Size{ 0 }
+		, m_FreeCount{ 0 }
+		, m_Allocator{ std::move(other.m_Allocator) }
+	{
+		m_Sentinel.MakeSentinel();
+		m_FreeNodes.MakeSentinel();
+		TakeFrom(other);
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>& List<type, allocator>::operator=(const List& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		// reuses the nodes this list already has, unless they came from an allocator we are about to replace
+		Clear();
+		if constexpr (nodeTraits::propagate_on_container_copy_assignment::value)
+		{
+			if (!AllocatorEquals(other))
+			{
+				ReleaseFreeNodes();
+			}
+			m_Allocator = other.m_Allocator;
+		}
+		for (const_iterator it = other.CBegin(); it != other.CEnd(); ++it)
+		{
+			PushBack(*it);
+		}
+		return *this;
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>& List<type, allocator>::operator=(List&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+		|| std::allocator_traits<allocator>::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Clear();
+		if constexpr (!nodeTraits::propagate_on_container_move_assignment::value)
+		{
+			// we keep our allocator, so nodes that came from a different one can't be taken over
+			if (!AllocatorEquals(other))
+			{
+				for (iterator it = other.Begin(); it != other.End(); ++it)
+				{
+					EmplaceBack(std::move(*it));
+				}
+				other.Clear();
+				return *this;
+			}
+		}
+
+		ReleaseFreeNodes();
+		if constexpr (nodeTraits::propagate_on_container_move_assignment::value)
+		{
+			m_Allocator = std::move(other.m_Allocator);
+		}
+		TakeFrom(other);
+		return *this;
+	}
+
+	template<typename type, typename allocator>
+	inline List<type, allocator>::~List()
+	{
+		Clear();
+		ReleaseFreeNodes();
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::iterator List<type, allocator>::Begin()
+	{
+		return iterator{ m_Sentinel.Next() };
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::iterator List<type, allocator>::End()
+	{
+		return iterator{ &m_Sentinel };
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::const_iterator List<type, allocator>::CBegin() const
+	{
+		return const_iterator{ m_Sentinel.Next() };
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::const_iterator List<type, allocator>::CEnd() const
+	{
+		return const_iterator{ const_cast<ListHook*>(&m_Sentinel) };
+	}
+
+	template<typename type, typename allocator>
+	inline type& List<type, allocator>::Front()
+	{
+		assert(m_Size > 0);
+		return *Begin();
+	}
+
+	template<typename type, typename allocator>
+	inline const type& List<type, allocator>::Front() const
+	{
+		assert(m_Size > 0);
+		return *CBegin();
+	}
+
+	template<typename type, typename allocator>
+	inline type& List<type, allocator>::Back()
+	{
+		assert(m_Size > 0);
+		return *iterator{ m_Sentinel.Prev() };
+	}
+
+	template<typename type, typename allocator>
+	inline const type& List<type, allocator>::Back() const
+	{
+		assert(m_Size > 0);
+		return *const_iterator{ m_Sentinel.Prev() };
+	}
+
+	template<typename type, typename allocator>
+	inline bool List<type, allocator>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename type, typename allocator>
+	inline uint32_t List<type, allocator>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::Reserve(uint32_t count)
+	{
+		while (m_Size + m_FreeCount < count)
+		{
+			node* pNode = nodeTraits::allocate(m_Allocator, 1);
+			std::construct_at(pNode);
+			ReleaseNode(pNode);
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::ShrinkToFit()
+	{
+		ReleaseFreeNodes();
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::Clear()
+	{
+		if (m_Size == 0)
+		{
+			return;
+		}
+
+		for (ListHook* pHook = m_Sentinel.Next(); pHook != &m_Sentinel; pHook = pHook->Next())
+		{
+			std::destroy_at(&static_cast<node*>(pHook)->value);
+		}
+		// the nodes are still chained together, so they move to the free list in one go
+		m_FreeNodes.TransferBefore(m_Sentinel.Next(), m_Sentinel.Prev());
+		m_FreeCount += m_Size;
+		m_Size = 0;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PushBack(const type& value)
+	{
+		Emplace(CEnd(), value);
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PushBack(type&& value)
+	{
+		Emplace(CEnd(), std::move(value));
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PushFront(const type& value)
+	{
+		Emplace(CBegin(), value);
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PushFront(type&& value)
+	{
+		Emplace(CBegin(), std::move(value));
+	}
+
+	template<typename type, typename allocator>
+	template<class... ARGS>
+	inline type& List<type, allocator>::EmplaceBack(ARGS&&... args)
+	{
+		return *Emplace(CEnd(), std::forward<ARGS>(args)...);
+	}
+
+	template<typename type, typename allocator>
+	template<class... ARGS>
+	inline type& List<type, allocator>::EmplaceFront(ARGS&&... args)
+	{
+		return *Emplace(CBegin(), std::forward<ARGS>(args)...);
+	}
+
+	template<typename type, typename allocator>
+	template<class... ARGS>
+	inline typename List<type, allocator>::iterator List<type, allocator>::Emplace(const_iterator pos, ARGS&&... args)
+	{
+		node* pNode = AcquireNode();
+		try
+		{
+			std::construct_at(&pNode->value, std::forward<ARGS>(args)...);
+		}
+		catch (...)
+		{
+			ReleaseNode(pNode);
+			throw;
+		}
+		pNode->LinkBefore(Mutable(pos));
+		++m_Size;
+		return iterator{ pNode };
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::iterator List<type, allocator>::Insert(const_iterator pos, const type& value)
+	{
+		return Emplace(pos, value);
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::iterator List<type, allocator>::Insert(const_iterator pos, type&& value)
+	{
+		return Emplace(pos, std::move(value));
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PopBack()
+	{
+		assert(m_Size > 0);
+		Erase(const_iterator{ m_Sentinel.Prev() });
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::PopFront()
+	{
+		assert(m_Size > 0);
+		Erase(CBegin());
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::iterator List<type, allocator>::Erase(const_iterator pos)
+	{
+		assert(pos != CEnd());
+		node* pNode = static_cast<node*>(Mutable(pos));
+		iterator next{ pNode->Next() };
+		pNode->Unlink();
+		std::destroy_at(&pNode->value);
+		ReleaseNode(pNode);
+		--m_Size;
+		return next;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::Splice(const_iterator pos, List& other)
+	{
+		assert(this != &other && m_Allocator == other.m_Allocator);
+		if (other.m_Size == 0)
+		{
+			return;
+		}
+		Mutable(pos)->TransferBefore(other.m_Sentinel.Next(), other.m_Sentinel.Prev());
+		m_Size += other.m_Size;
+		other.m_Size = 0;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::Splice(const_iterator pos, List& other, const_iterator it)
+	{
+		assert(m_Allocator == other.m_Allocator && it != other.CEnd());
+		ListHook* pHook = Mutable(it);
+		Mutable(pos)->TransferBefore(pHook, pHook);
+		if (this != &other)
+		{
+			++m_Size;
+			--other.m_Size;
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::MoveToFront(const_iterator it)
+	{
+		Splice(CBegin(), *this, it);
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::MoveToBack(const_iterator it)
+	{
+		Splice(CEnd(), *this, it);
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::Swap(List& other) noexcept
+	{
+		if constexpr (nodeTraits::propagate_on_container_swap::value)
+		{
+			std::swap(m_Allocator, other.m_Allocator);
+		}
+		else
+		{
+			// without propagation each node stays with the allocator that has to free it
+			assert(AllocatorEquals(other));
+		}
+
+		// TakeFrom needs an empty list, so one chain waits in temp
+		List temp{ allocator{ m_Allocator } };
+		temp.TakeFrom(other);
+		other.TakeFrom(*this);
+		TakeFrom(temp);
+	}
+
+	template<typename type, typename allocator>
+	inline typename List<type, allocator>::node* List<type, allocator>::AcquireNode()
+	{
+		if (m_FreeCount == 0)
+		{
+			node* pNode = nodeTraits::allocate(m_Allocator, 1);
+			std::construct_at(pNode);
+			return pNode;
+		}
+
+		// the most recently freed node is the most likely to still be in cache
+		node* pNode = static_cast<node*>(m_FreeNodes.Prev());
+		pNode->Unlink();
+		--m_FreeCount;
+		return pNode;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::ReleaseNode(node* pNode)
+	{
+		pNode->LinkBefore(&m_FreeNodes);
+		++m_FreeCount;
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::ReleaseFreeNodes()
+	{
+		while (m_FreeCount > 0)
+		{
+			node* pNode = static_cast<node*>(m_FreeNodes.Next());
+			pNode->Unlink();
+			std::destroy_at(pNode);
+			nodeTraits::deallocate(m_Allocator, pNode, 1);
+			--m_FreeCount;
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void List<type, allocator>::TakeFrom(List& other)
+	{
+		// the nodes point at other's sentinels, so both chains get moved over as a whole
+		if (other.m_Size > 0)
+		{
+			m_Sentinel.TransferBefore(other.m_Sentinel.Next(), other.m_Sentinel.Prev());
+		}
+		if (other.m_FreeCount > 0)
+		{
+			m_FreeNodes.TransferBefore(other.m_FreeNodes.Next(), other.m_FreeNodes.Prev());
+		}
+		m_Size = other.m_Size;
+		m_FreeCount = other.m_FreeCount;
+		other.m_Size = 0;
+		other.m_FreeCount = 0;
+	}
+
+	template<typename type, typename allocator>
+	inline bool List<type, allocator>::AllocatorEquals(const List& other) const
+	{
+		if constexpr (nodeTraits::is_always_equal::value)
+		{
+			return true;
+		}
+		else
+		{
+			return m_Allocator == other.m_Allocator;
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline ListHook* List<type, allocator>::Mutable(const_iterator pos)
+	{
+		return pos.Hook();
+	}
+#pragma endregion
+
+#pragma region IntrusiveList
+	template<typename type>
+	inline IntrusiveList<type>::IntrusiveList()
+		: m_Sentinel{}
+		, m_Size{ 0 }
+	{
+		m_Sentinel.MakeSentinel();
+	}
+
+	template<typename type>
+	inline IntrusiveList<type>::IntrusiveList(IntrusiveList&& other) noexcept
+		: IntrusiveList()
+	{
+		Splice(CEnd(), other);
+	}
+
+	template<typename type>
+	inline IntrusiveList<type>& IntrusiveList<type>::operator=(IntrusiveList&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Clear();
+			Splice(CEnd(), other);
+		}
+		return *this;
+	}
+
+	template<typename type>
+	inline IntrusiveList<type>::~IntrusiveList()
+	{
+		Clear();
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::iterator IntrusiveList<type>::Begin()
+	{
+		return iterator{ m_Sentinel.Next() };
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::iterator IntrusiveList<type>::End()
+	{
+		return iterator{ &m_Sentinel };
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::const_iterator IntrusiveList<type>::CBegin() const
+	{
+		return const_iterator{ m_Sentinel.Next() };
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::const_iterator IntrusiveList<type>::CEnd() const
+	{
+		return const_iterator{ const_cast<ListHook*>(&m_Sentinel) };
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::iterator IntrusiveList<type>::IteratorTo(type& element)
+	{
+		assert(static_cast<ListHook&>(element).IsLinked());
+		return iterator{ &element };
+	}
+
+	template<typename type>
+	inline type& IntrusiveList<type>::Front()
+	{
+		assert(m_Size > 0);
+		return *Begin();
+	}
+
+	template<typename type>
+	inline type& IntrusiveList<type>::Back()
+	{
+		assert(m_Size > 0);
+		return *iterator{ m_Sentinel.Prev() };
+	}
+
+	template<typename type>
+	inline bool IntrusiveList<type>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename type>
+	inline uint32_t IntrusiveList<type>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::Clear()
+	{
+		while (m_Size > 0)
+		{
+			PopFront();
+		}
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::PushBack(type& element)
+	{
+		Insert(CEnd(), element);
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::PushFront(type& element)
+	{
+		Insert(CBegin(), element);
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::iterator IntrusiveList<type>::Insert(const_iterator pos, type& element)
+	{
+		ListHook& hook = element;
+		hook.LinkBefore(Mutable(pos));
+		++m_Size;
+		return iterator{ &hook };
+	}
+
+	template<typename type>
+	inline type& IntrusiveList<type>::PopBack()
+	{
+		assert(m_Size > 0);
+		type& element = Back();
+		Remove(element);
+		return element;
+	}
+
+	template<typename type>
+	inline type& IntrusiveList<type>::PopFront()
+	{
+		assert(m_Size > 0);
+		type& element = Front();
+		Remove(element);
+		return element;
+	}
+
+	template<typename type>
+	inline typename IntrusiveList<type>::iterator IntrusiveList<type>::Erase(const_iterator pos)
+	{
+		assert(pos != CEnd());
+		iterator next{ pos.Hook()->Next() };
+		Remove(*HookAccess::Get(pos.Hook()));
+		return next;
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::Remove(type& element)
+	{
+		static_cast<ListHook&>(element).Unlink();
+		--m_Size;
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::Splice(const_iterator pos, IntrusiveList& other)
+	{
+		assert(this != &other);
+		if (other.m_Size == 0)
+		{
+			return;
+		}
+		Mutable(pos)->TransferBefore(other.m_Sentinel.Next(), other.m_Sentinel.Prev());
+		m_Size += other.m_Size;
+		other.m_Size = 0;
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::Splice(const_iterator pos, IntrusiveList& other, const_iterator it)
+	{
+		assert(it != other.CEnd());
+		ListHook* pHook = Mutable(it);
+		Mutable(pos)->TransferBefore(pHook, pHook);
+		if (this != &other)
+		{
+			++m_Size;
+			--other.m_Size;
+		}
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::MoveToFront(type& element)
+	{
+		ListHook* pHook = &element;
+		m_Sentinel.Next()->TransferBefore(pHook, pHook);
+	}
+
+	template<typename type>
+	inline void IntrusiveList<type>::MoveToBack(type& element)
+	{
+		ListHook* pHook = &element;
+		m_Sentinel.TransferBefore(pHook, pHook);
+	}
+
+	template<typename type>
+	inline ListHook* IntrusiveList<type>::Mutable(const_iterator pos)
+	{
+		return pos.Hook();
+	}
+#pragma endregion
+}
@@ -0,0 +1,331 @@
+#pragma once
+#include "CpuDispatch.h"
+#include "Platform.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The copies behind Vector's Reallocate, Insert and Erase
+// Each size class gets the method that is fastest for it, libc has to make the same choices but can't inline the small ones:
+// up to 64 bytes:                 inline loads of the first and last bytes that overlap in the middle, no loop and no call
+// up to RepMovsbThreshold:        AVX2, up to 256 bytes without a loop and 128 bytes per iteration above that
+// up to NonTemporalThreshold():   rep movsb on CPUs with ERMS, the microcode moves whole cache lines without reading the destination first
+// beyond that:                    AVX2 streaming stores, they bypass the cache instead of evicting everything else from it
+// The kernel for everything above 64 bytes is bound to the ActiveTier from CpuDispatch.h, below AVX2 it goes to libc
+namespace Container
+{
+	inline constexpr size_t TinyCopyBytes = 64;
+	// below this starting rep movsb costs more than it saves
+	inline constexpr size_t RepMovsbThreshold = 4096;
+
+	// Three quarters of the last level cache one core gets, a copy bigger than that would only evict the data around it
+	_NODISCARD size_t NonTemporalThreshold();
+
+	// memcpy, the ranges must not overlap. It runs the same code as MoveBytes, telling the two cases apart is one compare
+	CONTAINER_FORCEINLINE void CopyBytes(void* pDest, const void* pSrc, size_t bytes);
+	// memmove, the ranges may overlap
+	CONTAINER_FORCEINLINE void MoveBytes(void* pDest, const void* pSrc, size_t bytes);
+
+#pragma region Size Classes
+	namespace Detail
+	{
+		// Loads everything before the first store, so overlapping ranges come out right too
+		CONTAINER_FORCEINLINE void CopyTiny(char* pDest, const char* pSrc, size_t bytes)
+		{
+			if (bytes >= 16)
+			{
+#if CONTAINER_SSE2
+				const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + bytes - 16));
+				if (bytes > 32)
+				{
+					const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 16));
+					const __m128i secondLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + bytes - 32));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + 16), second);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + bytes - 32), secondLast);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest), first);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + bytes - 16), last);
+#else
+				std::memmove(pDest, pSrc, bytes);
+#endif
+			}
+			else if (bytes >= 8)
+			{
+				uint64_t first;
+				uint64_t last;
+				std::memcpy(&first, pSrc, 8);
+				std::memcpy(&last, pSrc + bytes - 8, 8);
+				std::memcpy(pDest, &first, 8);
+				std::memcpy(pDest + bytes - 8, &last, 8);
+			}
+			else if (bytes >= 4)
+			{
+				uint32_t first;
+				uint32_t last;
+				std::memcpy(&first, pSrc, 4);
+				std::memcpy(&last, pSrc + bytes - 4, 4);
+				std::memcpy(pDest, &first, 4);
+				std::memcpy(pDest + bytes - 4, &last, 4);
+			}
+			else if (bytes >= 2)
+			{
+				uint16_t first;
+				uint16_t last;
+				std::memcpy(&first, pSrc, 2);
+				std::memcpy(&last, pSrc + bytes - 2, 2);
+				std::memcpy(pDest, &first, 2);
+				std::memcpy(pDest + bytes - 2, &last, 2);
+			}
+			else if (bytes == 1)
+			{
+				*pDest = *pSrc;
+			}
+		}
+
+#if CONTAINER_X86
+		// 4 unaligned 32 byte vectors, kept in registers between the loads and the stores
+		struct Avx2Block
+		{
+			__m256i a;
+			__m256i b;
+			__m256i c;
+			__m256i d;
+		};
+
+		CONTAINER_TARGET("avx2") CONTAINER_FORCEINLINE Avx2Block LoadBlock(const char* pSrc)
+		{
+			const __m256i* pVectors = reinterpret_cast<const __m256i*>(pSrc);
+			return { _mm256_loadu_si256(pVectors), _mm256_loadu_si256(pVectors + 1), _mm256_loadu_si256(pVectors + 2), _mm256_loadu_si256(pVectors + 3) };
+		}
+
+		CONTAINER_TARGET("avx2") CONTAINER_FORCEINLINE void StoreBlock(char* pDest, const Avx2Block& block)
+		{
+			__m256i* pVectors = reinterpret_cast<__m256i*>(pDest);
+			_mm256_storeu_si256(pVectors, block.a);
+			_mm256_storeu_si256(pVectors + 1, block.b);
+			_mm256_storeu_si256(pVectors + 2, block.c);
+			_mm256_storeu_si256(pVectors + 3, block.d);
+		}
+
+		// Up to 256 bytes with every load before the first store, that makes it right for any overlap as well
+		CONTAINER_TARGET("avx2") inline void CopyAvx2Short(char* pDest, const char* pSrc, size_t bytes)
+		{
+			if (bytes <= 128)
+			{
+				const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc));
+				const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + 32));
+				const __m256i secondLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + bytes - 64));
+				const __m256i last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + bytes - 32));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDest), first);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDest + 32), second);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDest + bytes - 64), secondLast);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDest + bytes - 32), last);
+				return;
+			}
+			const Avx2Block head = LoadBlock(pSrc);
+			const Avx2Block tail = LoadBlock(pSrc + bytes - 128);
+			StoreBlock(pDest, head);
+			StoreBlock(pDest + bytes - 128, tail);
+		}
+
+		// Front to back, safe when pDest is below pSrc. The first and last 128 bytes are loaded up front and stored last,
+		// that way the loop can start at the first cache line aligned destination and doesn't need a remainder loop
+		CONTAINER_TARGET("avx2") inline void CopyAvx2Forward(char* pDest, const char* pSrc, size_t bytes)
+		{
+			if (bytes <= 256)
+			{
+				CopyAvx2Short(pDest, pSrc, bytes);
+				return;
+			}
+
+			const Avx2Block head = LoadBlock(pSrc);
+			const Avx2Block tail = LoadBlock(pSrc + bytes - 128);
+			for (size_t offset = 128 - (reinterpret_cast<uintptr_t>(pDest) & 63); offset < bytes - 128; offset += 128)
+			{
+				const Avx2Block block = LoadBlock(pSrc + offset);
+				__m256i* pDestBlock = reinterpret_cast<__m256i*>(pDest + offset);
+				_mm256_store_si256(pDestBlock, block.a);
+				_mm256_store_si256(pDestBlock + 1, block.b);
+				_mm256_store_si256(pDestBlock + 2, block.c);
+				_mm256_store_si256(pDestBlock + 3, block.d);
+			}
+			StoreBlock(pDest, head);
+			StoreBlock(pDest + bytes - 128, tail);
+		}
+
+		// CopyAvx2Forward with streaming stores, for ranges that don't overlap and are far bigger than 256 bytes
+		// It goes through 4 pages side by side, a line of each in turn, which keeps 4 DRAM pages open instead of one
+		CONTAINER_TARGET("avx2") inline void CopyAvx2Streaming(char* pDest, const char* pSrc, size_t bytes)
+		{
+			constexpr size_t pageBytes = 4096;
+			constexpr size_t pageCount = 4;
+			auto streamBlock = [pDest, pSrc](size_t offset) CONTAINER_TARGET("avx2")
+				{
+					const Avx2Block block = LoadBlock(pSrc + offset);
+					__m256i* pDestBlock = reinterpret_cast<__m256i*>(pDest + offset);
+					_mm256_stream_si256(pDestBlock, block.a);
+					_mm256_stream_si256(pDestBlock + 1, block.b);
+					_mm256_stream_si256(pDestBlock + 2, block.c);
+					_mm256_stream_si256(pDestBlock + 3, block.d);
+				};
+
+			const Avx2Block head = LoadBlock(pSrc);
+			const Avx2Block tail = LoadBlock(pSrc + bytes - 128);
+			size_t offset = 128 - (reinterpret_cast<uintptr_t>(pDest) & 63);
+			for (; offset + pageCount * pageBytes <= bytes - 128; offset += pageCount * pageBytes)
+			{
+				for (size_t line{}; line < pageBytes; line += 128)
+				{
+					for (size_t page{}; page < pageCount; ++page)
+					{
+						streamBlock(offset + page * pageBytes + line);
+					}
+				}
+			}
+			for (; offset < bytes - 128; offset += 128)
+			{
+				streamBlock(offset);
+			}
+			// streaming stores aren't ordered with the stores after them
+			_mm_sfence();
+			StoreBlock(pDest, head);
+			StoreBlock(pDest + bytes - 128, tail);
+		}
+
+		// Back to front for overlapping ranges with pDest above pSrc, the mirror image of CopyAvx2Forward
+		CONTAINER_TARGET("avx2") inline void CopyAvx2Backward(char* pDest, const char* pSrc, size_t bytes)
+		{
+			if (bytes <= 256)
+			{
+				CopyAvx2Short(pDest, pSrc, bytes);
+				return;
+			}
+
+			const Avx2Block head = LoadBlock(pSrc);
+			const Avx2Block tail = LoadBlock(pSrc + bytes - 128);
+			for (size_t end = bytes - (reinterpret_cast<uintptr_t>(pDest + bytes) & 63); end > 128; end -= 128)
+			{
+				const __m256i* pBlock = reinterpret_cast<const __m256i*>(pSrc + end - 128);
+				const __m256i d = _mm256_loadu_si256(pBlock + 3);
+				const __m256i c = _mm256_loadu_si256(pBlock + 2);
+				const __m256i b = _mm256_loadu_si256(pBlock + 1);
+				const __m256i a = _mm256_loadu_si256(pBlock);
+				__m256i* pDestBlock = reinterpret_cast<__m256i*>(pDest + end - 128);
+				_mm256_store_si256(pDestBlock + 3, d);
+				_mm256_store_si256(pDestBlock + 2, c);
+				_mm256_store_si256(pDestBlock + 1, b);
+				_mm256_store_si256(pDestBlock, a);
+			}
+			StoreBlock(pDest + bytes - 128, tail);
+			StoreBlock(pDest, head);
+		}
+
+		// Copies front to back a byte at a time as far as the result goes, so it's only right when pDest isn't inside the source
+		inline void RepMovsb(char* pDest, const char* pSrc, size_t bytes)
+		{
+#if defined(_MSC_VER)
+			__movsb(reinterpret_cast<unsigned char*>(pDest), reinterpret_cast<const unsigned char*>(pSrc), bytes);
+#else
+			__asm__ volatile("rep movsb" : "+D"(pDest), "+S"(pSrc), "+c"(bytes) : : "memory");
+#endif
+		}
+#endif
+
+		// Everything above TinyCopyBytes, one kernel per SimdTier. They are only called through CopyKernels, so the
+		// inline part of CopyBytes stays a compare and the tiny copy
+		// The size classes are checked from small to big, the small copies are the common ones and pay for the fewest checks
+		inline void CopyLargeScalar(char* pDest, const char* pSrc, size_t bytes)
+		{
+			std::memmove(pDest, pSrc, bytes);
+		}
+
+#if CONTAINER_X86
+		// no vector loop of our own below AVX2, only rep movsb where it beats libc
+		inline void CopyLargeSse42(char* pDest, const char* pSrc, size_t bytes)
+		{
+			const bool forward = pDest <= pSrc || pDest >= pSrc + bytes;
+			if (GetCpuFeatures().erms && forward && bytes >= RepMovsbThreshold)
+			{
+				RepMovsb(pDest, pSrc, bytes);
+				return;
+			}
+			std::memmove(pDest, pSrc, bytes);
+		}
+
+		inline void CopyLargeAvx2(char* pDest, const char* pSrc, size_t bytes)
+		{
+			const bool forward = pDest <= pSrc || pDest >= pSrc + bytes;
+			if (bytes < RepMovsbThreshold || !forward)
+			{
+				if (forward)
+				{
+					CopyAvx2Forward(pDest, pSrc, bytes);
+				}
+				else
+				{
+					CopyAvx2Backward(pDest, pSrc, bytes);
+				}
+				return;
+			}
+			const bool overlapping = pDest < pSrc + bytes && pSrc < pDest + bytes;
+			if (!overlapping && bytes >= NonTemporalThreshold())
+			{
+				CopyAvx2Streaming(pDest, pSrc, bytes);
+				return;
+			}
+			if (GetCpuFeatures().erms)
+			{
+				RepMovsb(pDest, pSrc, bytes);
+				return;
+			}
+			CopyAvx2Forward(pDest, pSrc, bytes);
+		}
+#endif
+
+		using CopyKernel = void(*)(char* pDest, const char* pSrc, size_t bytes);
+
+		// AVX-512 copies with the AVX2 kernel, 64 byte stores don't make a copy faster but can lower the clock on older CPUs
+#if CONTAINER_X86
+		inline constexpr CopyKernel CopyKernels[SimdTierCount]{ CopyLargeScalar, CopyLargeSse42, CopyLargeAvx2, CopyLargeAvx2 };
+#else
+		inline constexpr CopyKernel CopyKernels[SimdTierCount]{ CopyLargeScalar, CopyLargeScalar, CopyLargeScalar, CopyLargeScalar };
+#endif
+
+		inline CopyKernel BoundCopyKernel()
+		{
+			static const CopyKernel kernel = BindKernel(CopyKernels);
+			return kernel;
+		}
+	}
+#pragma endregion
+
+#pragma region MemoryCopy
+	inline size_t NonTemporalThreshold()
+	{
+		static const size_t threshold = []()
+			{
+				const size_t cache = GetCpuFeatures().lastLevelCachePerCore;
+				// without cache information assume a few MB, like most desktop CPUs have per core
+				return cache == 0 ? size_t{ 3 * 1024 * 1024 } : std::max<size_t>(cache / 4 * 3, 1024 * 1024);
+			}();
+		return threshold;
+	}
+
+	CONTAINER_FORCEINLINE void CopyBytes(void* pDest, const void* pSrc, size_t bytes)
+	{
+		MoveBytes(pDest, pSrc, bytes);
+	}
+
+	CONTAINER_FORCEINLINE void MoveBytes(void* pDest, const void* pSrc, size_t bytes)
+	{
+		if (bytes <= TinyCopyBytes)
+		{
+			Detail::CopyTiny(static_cast<char*>(pDest), static_cast<const char*>(pSrc), bytes);
+			return;
+		}
+		Detail::BoundCopyKernel()(static_cast<char*>(pDest), static_cast<const char*>(pSrc), bytes);
+	}
+#pragma endregion
+}
@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace Container
+{
+	// How a PageAllocator sets up the pages of big buffers, the options can be combined
+	// Prefault: maps every page during the allocation, so the first writes don't page fault one page at a time
+	// HugePages: asks for transparent huge pages, one fault and one TLB entry per 2 MB instead of per 4 KB. Linux only,
+	//            Windows only hands out large pages to processes with SeLockMemoryPrivilege, so there it does nothing
+	// Lock: pins the pages in memory so they never get swapped out, which also faults them all in. Needs enough
+	//       RLIMIT_MEMLOCK on Linux and a big enough working set on Windows, failures are counted in LockFailures
+	enum class PageOptions : uint32_t
+	{
+		None = 0,
+		Prefault = 1 << 0,
+		HugePages = 1 << 1,
+		Lock = 1 << 2
+	};
+
+	_NODISCARD constexpr PageOptions operator|(PageOptions lhs, PageOptions rhs);
+	_NODISCARD constexpr bool HasOption(PageOptions options, PageOptions option);
+
+	// Allocations from this size on get pages of their own, smaller ones come from the heap and ignore the options
+	inline constexpr size_t PageAllocationThreshold = 256 * 1024;
+	inline constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+	_NODISCARD size_t PageSize();
+	// Touches every page of [pData, pData + bytes) with a write that keeps the data, on threadCount threads (0 picks
+	// one per core for big buffers). Worth it when a buffer is about to be filled anyway and the faults shouldn't land on the code filling it
+	void PrefaultPages(void* pData, size_t bytes, uint32_t threadCount = 0);
+	// Page faults the process has taken so far that didn't need to read from disk, -1 where the platform doesn't say
+	_NODISCARD int64_t MinorPageFaults();
+
+	// Maps big buffers straight from the OS with the given PageOptions, meant for the few huge vectors whose first
+	// touch or TLB misses show up in latency. Vector reserves through it like through any other allocator:
+	// Vector<float, PageAllocator<float>> vector{ PageAllocator<float>{ PageOptions::Prefault | PageOptions::HugePages } };
+	// Where the memory comes from only depends on the size, so any two PageAllocators can free each others memory
+	template<typename type>
+	class PageAllocator
+	{
+	public:
+#pragma region member types
+		using value_type = type;
+		using is_always_equal = std::true_type;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = PageAllocator<otherType>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		constexpr PageAllocator(PageOptions options = PageOptions::None);
+		template<typename otherType>
+		constexpr PageAllocator(const PageAllocator<otherType>& other);
+#pragma endregion
+
+		_NODISCARD type* allocate(size_t count);
+		void deallocate(type* pData, size_t count);
+		_NODISCARD constexpr PageOptions Options() const;
+		// allocations whose pages couldn't be locked, over all PageAllocators
+		_NODISCARD static uint32_t LockFailures();
+
+		template<typename otherType>
+		constexpr bool operator==(const PageAllocator<otherType>& rhs) const;
+		template<typename otherType>
+		constexpr bool operator!=(const PageAllocator<otherType>& rhs) const;
+
+	private:
+		PageOptions m_Options;
+	};
+
+	// The part of PageAllocator that doesn't depend on the element type
+	class PageMapper final
+	{
+	public:
+		PageMapper() = delete;
+
+		_NODISCARD static void* Map(size_t bytes, PageOptions options);
+		static void Unmap(void* pData, size_t bytes);
+		_NODISCARD static uint32_t LockFailures();
+
+	private:
+		static size_t MappedBytes(size_t bytes);
+
+		inline static std::atomic<uint32_t> s_LockFailures{ 0 };
+	};
+
+#pragma region PageOptions
+	constexpr PageOptions operator|(PageOptions lhs, PageOptions rhs)
+	{
+		return static_cast<PageOptions>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+	}
+
+	constexpr bool HasOption(PageOptions options, PageOptions option)
+	{
+		return (static_cast<uint32_t>(options) & static_cast<uint32_t>(option)) != 0;
+	}
+#pragma endregion
+
+#pragma region Page Functions
+	inline size_t PageSize()
+	{
+#if defined(_WIN32)
+		static const size_t pageSize = []()
+			{
+				SYSTEM_INFO info{};
+				GetSystemInfo(&info);
+				return static_cast<size_t>(info.dwPageSize);
+			}();
+		return pageSize;
+#elif defined(__unix__) || defined(__APPLE__)
+		static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		return pageSize;
+#else
+		return 4096;
+#endif
+	}
+
+	inline void PrefaultPages(void* pData, size_t bytes, uint32_t threadCount)
+	{
+		const size_t pageSize = PageSize();
+		char* pBegin = static_cast<char*>(pData);
+		char* pEnd = pBegin + bytes;
+		if (bytes == 0)
+		{
+			return;
+		}
+
+		// an atomic add of 0 is a single write access, so a fresh page takes one fault instead of a read fault
+		// mapping the zero page followed by a write fault
+		auto touch = [pageSize](char* pFirst, char* pLast)
+			{
+				for (char* pPage = pFirst; pPage < pLast; pPage += pageSize)
+				{
+					std::atomic_ref<char>{ *pPage }.fetch_add(0, std::memory_order_relaxed);
+				}
+				std::atomic_ref<char>{ *(pLast - 1) }.fetch_add(0, std::memory_order_relaxed);
+			};
+
+		// on its own it starts a thread per 64 MB at most, starting threads costs more than faulting a few MB
+		const size_t pageCount = (bytes + pageSize - 1) / pageSize;
+		size_t threads = threadCount;
+		if (threads == 0)
+		{
+			threads = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), std::max<size_t>(bytes / (64 * 1024 * 1024), 1));
+		}
+		threads = std::min(threads, pageCount);
+		if (threads == 1)
+		{
+			touch(pBegin, pEnd);
+			return;
+		}
+
+		const size_t pagesPerThread = (pageCount + threads - 1) / threads;
+		std::vector<std::thread> workers{};
+		workers.reserve(threads - 1);
+		for (size_t thread{ 1 }; thread < threads; ++thread)
+		{
+			char* pFirst = std::min(pBegin + thread * pagesPerThread * pageSize, pEnd);
+			char* pLast = std::min(pFirst + pagesPerThread * pageSize, pEnd);
+			if (pFirst < pLast)
+			{
+				workers.emplace_back(touch, pFirst, pLast);
+			}
+		}
+		touch(pBegin, std::min(pBegin + pagesPerThread * pageSize, pEnd));
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	inline int64_t MinorPageFaults()
+	{
+#if defined(_WIN32)
+		// Windows only counts all faults together, soft and hard
+		PROCESS_MEMORY_COUNTERS counters{};
+		return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? static_cast<int64_t>(counters.PageFaultCount) : -1;
+#elif defined(__unix__) || defined(__APPLE__)
+		rusage usage{};
+		return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<int64_t>(usage.ru_minflt) : -1;
+#else
+		return -1;
+#endif
+	}
+#pragma endregion
+
+#pragma region PageMapper
+	inline size_t PageMapper::MappedBytes(size_t bytes)
+	{
+		// only rounded to whole pages, so unmapping doesn't need to know the options the memory was mapped with
+		const size_t pageSize = PageSize();
+		return (bytes + pageSize - 1) / pageSize * pageSize;
+	}
+
+	inline void* PageMapper::Map(size_t bytes, PageOptions options)
+	{
+		const size_t mappedBytes = MappedBytes(bytes);
+		void* pData{ nullptr };
+#if defined(_WIN32)
+		pData = VirtualAlloc(nullptr, mappedBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (!pData)
+		{
+			throw std::bad_alloc{};
+		}
+		if (HasOption(options, PageOptions::Lock) && !VirtualLock(pData, mappedBytes))
+		{
+			s_LockFailures.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (HasOption(options, PageOptions::Prefault))
+		{
+			PrefaultPages(pData, mappedBytes);
+		}
+#elif defined(__unix__) || defined(__APPLE__)
+		const bool hugePages = HasOption(options, PageOptions::HugePages) && mappedBytes >= HugePageSize;
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+		// huge pages have to be asked for before the pages get faulted in, so those get prefaulted after the madvise
+		if (HasOption(options, PageOptions::Prefault) && !hugePages)
+		{
+			flags |= MAP_POPULATE;
+		}
+#endif
+		// huge pages only get used for 2 MB aligned ranges, so map one huge page more and cut the unaligned ends off
+		const size_t reservedBytes = hugePages ? mappedBytes + HugePageSize : mappedBytes;
+		char* pMapping = static_cast<char*>(mmap(nullptr, reservedBytes, PROT_READ | PROT_WRITE, flags, -1, 0));
+		if (pMapping == MAP_FAILED)
+		{
+			throw std::bad_alloc{};
+		}
+		pData = pMapping;
+		if (hugePages)
+		{
+			char* pAligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(pMapping) + HugePageSize - 1) & ~(HugePageSize - 1));
+			if (pAligned != pMapping)
+			{
+				munmap(pMapping, static_cast<size_t>(pAligned - pMapping));
+			}
+			const size_t tailBytes = static_cast<size_t>(pMapping + reservedBytes - (pAligned + mappedBytes));
+			if (tailBytes != 0)
+			{
+				munmap(pAligned + mappedBytes, tailBytes);
+			}
+			pData = pAligned;
+#if defined(MADV_HUGEPAGE)
+			madvise(pData, mappedBytes, MADV_HUGEPAGE);
+#endif
+			if (HasOption(options, PageOptions::Prefault))
+			{
+				PrefaultPages(pData, mappedBytes);
+			}
+		}
+#if !defined(MAP_POPULATE)
+		else if (HasOption(options, PageOptions::Prefault))
+		{
+			PrefaultPages(pData, mappedBytes);
+		}
+#endif
+		if (HasOption(options, PageOptions::Lock) && mlock(pData, mappedBytes) != 0)
+		{
+			s_LockFailures.fetch_add(1, std::memory_order_relaxed);
+		}
+#else
+		pData = ::operator new(mappedBytes);
+		if (HasOption(options, PageOptions::Prefault))
+		{
+			PrefaultPages(pData, mappedBytes);
+		}
+#endif
+		return pData;
+	}
+
+	inline void PageMapper::Unmap(void* pData, size_t bytes)
+	{
+		// unmapping unlocks the pages as well
+#if defined(_WIN32)
+		(void)bytes;
+		VirtualFree(pData, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+		munmap(pData, MappedBytes(bytes));
+#else
+		::operator delete(pData, MappedBytes(bytes));
+#endif
+	}
+
+	inline uint32_t PageMapper::LockFailures()
+	{
+		return s_LockFailures.load(std::memory_order_relaxed);
+	}
+#pragma endregion
+
+#pragma region PageAllocator
+	template<typename type>
+	constexpr PageAllocator<type>::PageAllocator(PageOptions options)
+		: m_Options{ options }
+	{
+	}
+
+	template<typename type>
+	template<typename otherType>
+	constexpr PageAllocator<type>::PageAllocator(const PageAllocator<otherType>& other)
+		: m_Options{ other.Options() }
+	{
+	}
+
+	template<typename type>
+	inline type* PageAllocator<type>::allocate(size_t count)
+	{
+		const size_t bytes = count * sizeof(type);
+		if (bytes < PageAllocationThreshold)
+		{
+			return static_cast<type*>(::operator new(bytes, std::align_val_t{ alignof(type) }));
+		}
+		return static_cast<type*>(PageMapper::Map(bytes, m_Options));
+	}
+
+	template<typename type>
+	inline void PageAllocator<type>::deallocate(type* pData, size_t count)
+	{
+		const size_t bytes = count * sizeof(type);
+		if (bytes < PageAllocationThreshold)
+		{
+			::operator delete(pData, bytes, std::align_val_t{ alignof(type) });
+			return;
+		}
+		PageMapper::Unmap(pData, bytes);
+	}
+
+	template<typename type>
+	constexpr PageOptions PageAllocator<type>::Options() const
+	{
+		return m_Options;
+	}
+
+	template<typename type>
+	inline uint32_t PageAllocator<type>::LockFailures()
+	{
+		return PageMapper::LockFailures();
+	}
+
+	template<typename type>
+	template<typename otherType>
+	constexpr bool PageAllocator<type>::operator==(const PageAllocator<otherType>&) const
+	{
+		return true;
+	}
+
+	template<typename type>
+	template<typename otherType>
+	constexpr bool PageAllocator<type>::operator!=(const PageAllocator<otherType>&) const
+	{
+		return false;
+	}
+#pragma endregion
+}
@@ -0,0 +1,216 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters through Linux perf_event_open, to see why a benchmark is as fast as it is
+// Everywhere else, or when the kernel doesn't allow it (perf_event_paranoid, containers, VMs without a virtual PMU),
+// the counters simply report that they aren't available and the benchmarks only get timed
+namespace Benchmark
+{
+	enum class Counter : uint32_t
+	{
+		Cycles,
+		Instructions,
+		L1DMisses,
+		LLCMisses,
+		BranchMisses,
+		DTLBMisses,
+		Count
+	};
+
+	inline constexpr uint32_t CounterCount = static_cast<uint32_t>(Counter::Count);
+	inline constexpr const char* CounterNames[CounterCount]{ "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses" };
+
+	struct CounterValues
+	{
+		double values[CounterCount]{};
+		// counters that couldn't be opened or never got scheduled on the PMU stay invalid
+		bool valid[CounterCount]{};
+
+		_NODISCARD bool Any() const;
+	};
+
+	// Counts the calling thread only, threads a benchmark starts itself aren't included
+	// Every counter is opened on its own instead of as a group, so the kernel can multiplex them when there are more
+	// counters than the PMU has registers, the values get scaled up by the fraction of time they were actually counting
+	class PerfCounters final
+	{
+	public:
+#pragma region Deleted Functions
+		PerfCounters(const PerfCounters& other) = delete;
+		PerfCounters& operator=(const PerfCounters& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		PerfCounters();
+		~PerfCounters();
+#pragma endregion
+
+		// true when at least one counter could be opened
+		_NODISCARD bool Available() const;
+		_NODISCARD bool IsOpen(Counter counter) const;
+		// why counters are missing, empty when all of them opened
+		_NODISCARD const std::string& Error() const;
+
+		void Start();
+		_NODISCARD CounterValues Stop();
+
+	private:
+		int m_Fds[CounterCount];
+		std::string m_Error;
+	};
+
+#pragma region CounterValues
+	inline bool CounterValues::Any() const
+	{
+		for (bool isValid : valid)
+		{
+			if (isValid)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+#pragma endregion
+
+#pragma region PerfCounters
+#if defined(__linux__)
+	inline PerfCounters::PerfCounters()
+		: m_Fds{}
+		, m_Error{}
+	{
+		constexpr uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		const struct
+		{
+			uint32_t type;
+			uint64_t config;
+		} events[CounterCount]{
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | readMiss },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | readMiss },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | readMiss },
+		};
+
+		for (uint32_t i{}; i < CounterCount; ++i)
+		{
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = events[i].type;
+			attr.config = events[i].config;
+			attr.disabled = 1;
+			// user space only, that's also all perf_event_paranoid 2 allows
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			m_Fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+			if (m_Fds[i] < 0)
+			{
+				m_Error += std::string{ m_Error.empty() ? "" : ", " } + CounterNames[i] + ": " + std::strerror(errno);
+			}
+		}
+	}
+
+	inline PerfCounters::~PerfCounters()
+	{
+		for (int fd : m_Fds)
+		{
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+		}
+	}
+
+	inline void PerfCounters::Start()
+	{
+		for (int fd : m_Fds)
+		{
+			if (fd >= 0)
+			{
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+	}
+
+	inline CounterValues PerfCounters::Stop()
+	{
+		for (int fd : m_Fds)
+		{
+			if (fd >= 0)
+			{
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			}
+		}
+
+		CounterValues result{};
+		for (uint32_t i{}; i < CounterCount; ++i)
+		{
+			uint64_t data[3]{}; // value, time enabled, time running
+			if (m_Fds[i] < 0 || read(m_Fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+			{
+				continue;
+			}
+			result.values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+			result.valid[i] = true;
+		}
+		return result;
+	}
+#else
+	inline PerfCounters::PerfCounters()
+		: m_Fds{}
+		, m_Error{ "hardware counters are only read on Linux" }
+	{
+		for (int& fd : m_Fds)
+		{
+			fd = -1;
+		}
+	}
+
+	inline PerfCounters::~PerfCounters()
+	{
+	}
+
+	inline void PerfCounters::Start()
+	{
+	}
+
+	inline CounterValues PerfCounters::Stop()
+	{
+		return CounterValues{};
+	}
+#endif
+
+	inline bool PerfCounters::Available() const
+	{
+		for (int fd : m_Fds)
+		{
+			if (fd >= 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	inline bool PerfCounters::IsOpen(Counter counter) const
+	{
+		return m_Fds[static_cast<uint32_t>(counter)] >= 0;
+	}
+
+	inline const std::string& PerfCounters::Error() const
+	{
+		return m_Error;
+	}
+#pragma endregion
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// SSE2 is part of the x64 baseline, on 32 bit MSVC it depends on /arch
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTAINER_SSE2 1
+#include <emmintrin.h>
+#else
+#define CONTAINER_SSE2 0
+#endif
+
+// AVX needs /arch:AVX or -mavx (or -march=native on a machine that has it)
+#if defined(__AVX__)
+#define CONTAINER_AVX 1
+#include <immintrin.h>
+#else
+#define CONTAINER_AVX 0
+#endif
+
+// x86 and x64, where instructions past the compile flags can be used after checking CPUID at runtime
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86)
+#define CONTAINER_X86 1
+#include <immintrin.h>
+#else
+#define CONTAINER_X86 0
+#endif
+
+// Lets a function use an instruction set the rest of the build doesn't, MSVC allows every intrinsic anywhere
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CONTAINER_TARGET(isa)
+#else
+#define CONTAINER_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(_MSC_VER)
+#define CONTAINER_FORCEINLINE __forceinline
+#else
+#define CONTAINER_FORCEINLINE inline __attribute__((always_inline))
+#endif
+
+// Prefetching an address that isn't mapped is harmless, so callers can prefetch past the end of their data
+#if CONTAINER_SSE2
+#define CONTAINER_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define CONTAINER_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define CONTAINER_PREFETCH(address) ((void)(address))
+#endif
+
+#define CONTAINER_CACHE_LINE 64
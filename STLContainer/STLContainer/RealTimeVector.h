@@ -0,0 +1,538 @@
+#pragma once
+#include "Concepts.h"
+#include "MemoryCopy.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Container
+{
+	// A vector whose PushBack never copies the whole buffer in one go, for code where the slowest push matters more than the average
+	// When it is full it allocates a buffer twice as big and puts new elements there, the old elements stay where they are.
+	// Every push after that moves MigrationStep more of them over, so the copy gets spread over the pushes that fill the new
+	// buffer and is done long before that buffer is full. At most two buffers exist at the same time
+	// While a migration runs, the elements from the migrated count up to the old size are still in the old buffer, and every
+	// access checks which buffer it has to read. Data() finishes the migration first, since it has to return one contiguous buffer
+	// Trivially copyable elements get relocated with CopyBytes, others get moved one by one, like Vector does
+	template<typename type, typename allocator = std::allocator<type>>
+	class RealTimeVector final
+	{
+	public:
+#pragma region member types
+		using allocator_type = allocator;
+		// elements moved per push while migrating, about 256 bytes worth and never less than 1
+		static constexpr uint32_t MigrationStep = sizeof(type) >= 256 ? 1 : static_cast<uint32_t>(256 / sizeof(type));
+#pragma endregion
+#pragma region Type Requirments
+		static_assert(std::is_copy_constructible<type>::value);
+		static_assert(IsAllocator<allocator, type>);
+#pragma endregion
+#pragma region De/Constructors
+		RealTimeVector();
+		explicit RealTimeVector(const allocator& alloc);
+		RealTimeVector(const RealTimeVector& other);
+		RealTimeVector(RealTimeVector&& other) noexcept;
+		// The allocator only comes along when it propagates, like with Vector. Moving from an unequal allocator that doesn't
+		// propagate moves the elements one by one
+		RealTimeVector& operator=(const RealTimeVector& other);
+		RealTimeVector& operator=(RealTimeVector&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+			|| std::allocator_traits<allocator>::is_always_equal::value);
+		~RealTimeVector();
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD const type& At(uint32_t pos) const;
+		_NODISCARD type& At(uint32_t pos);
+		_NODISCARD const type& operator[](uint32_t pos) const;
+		_NODISCARD type& operator[](uint32_t pos);
+		_NODISCARD const type& Front() const;
+		_NODISCARD type& Front();
+		_NODISCARD const type& Back() const;
+		_NODISCARD type& Back();
+		// finishes a running migration, which takes as long as the copy a Vector would have done
+		_NODISCARD type* Data();
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		_NODISCARD uint32_t Capacity() const;
+		// reallocating here copies everything at once, reserve up front to avoid even the incremental migrations
+		void Reserve(uint32_t newCapacity);
+		_NODISCARD bool IsMigrating() const;
+		// elements that are still in the old buffer
+		_NODISCARD uint32_t PendingMigration() const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		void PushBack(const type& value);
+		void PushBack(type&& value);
+		template<class... ARGS>
+		void EmplaceBack(ARGS&&... args);
+		void PopBack();
+		// moves all remaining elements over, for a moment where a longer pause doesn't hurt
+		void FinishMigration();
+		// Only swaps the allocators when they propagate on swap, otherwise they have to be equal
+		void Swap(RealTimeVector& other) noexcept;
+#pragma endregion
+
+	private:
+		type* Slot(uint32_t pos) const;
+		void Grow();
+		void Migrate(uint32_t count);
+		void ReleaseOldBuffer();
+		// moves count elements to a buffer that doesn't overlap, the ones at pSrc are gone after it
+		void RelocateElements(type* pDest, type* pSrc, uint32_t count);
+		bool AllocatorEquals(const RealTimeVector& other) const;
+		// moves the elements of other into a buffer from our own allocator, for when we can't take over its buffers
+		void MoveElementsFrom(RealTimeVector& other);
+
+		using alloc_traits = std::allocator_traits<allocator>;
+
+		type* m_pData;
+		type* m_pOldData;
+		uint32_t m_Size;
+		uint32_t m_Capacity;
+		// elements [m_Migrated, m_OldSize) are still in m_pOldData, both are 0 when nothing is migrating
+		uint32_t m_Migrated;
+		uint32_t m_OldSize;
+		uint32_t m_OldCapacity;
+		allocator m_Allocator;
+
+		static constexpr uint32_t m_DefaultSize = 4;
+	};
+
+#pragma region De/Constructors
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>::RealTimeVector()
+		: RealTimeVector(allocator{})
+	{
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>::RealTimeVector(const allocator& alloc)
+		: m_pData{ nullptr }
+		, m_pOldData{ nullptr }
+		, m_Size{ 0 }
+		, m_Capacity{ 0 }
+		, m_Migrated{ 0 }
+		, m_OldSize{ 0 }
+		, m_OldCapacity{ 0 }
+		, m_Allocator{ alloc }
+	{
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>::RealTimeVector(const RealTimeVector& other)
+		: RealTimeVector(alloc_traits::select_on_container_copy_construction(other.m_Allocator))
+	{
+		Reserve(other.m_Size);
+		for (uint32_t i{}; i < other.m_Size; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i, other[i]);
+			++m_Size;
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>::RealTimeVector(RealTimeVector&& other) noexcept
+		: m_pData{ std::exchange(other.m_pData, nullptr) }
+		, m_pOldData{ std::exchange(other.m_pOldData, nullptr) }
+		, m_Size{ std::exchange(other.m_Size, 0) }
+		, m_Capacity{ std::exchange(other.m_Capacity, 0) }
+		, m_Migrated{ std::exchange(other.m_Migrated, 0) }
+		, m_OldSize{ std::exchange(other.m_OldSize, 0) }
+		, m_OldCapacity{ std::exchange(other.m_OldCapacity, 0) }
+		, m_Allocator{ std::move(other.m_Allocator) }
+	{
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>& RealTimeVector<type, allocator>::operator=(const RealTimeVector& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Clear();
+		if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+		{
+			// the buffer has to go back to the allocator it came from before that one gets replaced
+			if (!AllocatorEquals(other) && m_pData)
+			{
+				alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+				m_pData = nullptr;
+				m_Capacity = 0;
+			}
+			m_Allocator = other.m_Allocator;
+		}
+		Reserve(other.m_Size);
+		for (uint32_t i{}; i < other.m_Size; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i, other[i]);
+			++m_Size;
+		}
+		return *this;
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>& RealTimeVector<type, allocator>::operator=(RealTimeVector&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+		|| std::allocator_traits<allocator>::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Clear();
+		if constexpr (!alloc_traits::propagate_on_container_move_assignment::value)
+		{
+			// we keep our allocator, so buffers that came from a different one can't be taken over
+			if (!AllocatorEquals(other))
+			{
+				MoveElementsFrom(other);
+				return *this;
+			}
+		}
+
+		if (m_pData)
+		{
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
+		m_pData = std::exchange(other.m_pData, nullptr);
+		m_pOldData = std::exchange(other.m_pOldData, nullptr);
+		m_Size = std::exchange(other.m_Size, 0);
+		m_Capacity = std::exchange(other.m_Capacity, 0);
+		m_Migrated = std::exchange(other.m_Migrated, 0);
+		m_OldSize = std::exchange(other.m_OldSize, 0);
+		m_OldCapacity = std::exchange(other.m_OldCapacity, 0);
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+		{
+			m_Allocator = std::move(other.m_Allocator);
+		}
+		return *this;
+	}
+
+	template<typename type, typename allocator>
+	inline RealTimeVector<type, allocator>::~RealTimeVector()
+	{
+		Clear();
+		if (m_pData)
+		{
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
+	}
+#pragma endregion
+
+#pragma region Accessors
+	template<typename type, typename allocator>
+	inline type* RealTimeVector<type, allocator>::Slot(uint32_t pos) const
+	{
+		// one compare more than a plain array access, the range is empty when nothing is migrating
+		return pos - m_Migrated < m_OldSize - m_Migrated ? m_pOldData + pos : m_pData + pos;
+	}
+
+	template<typename type, typename allocator>
+	inline const type& RealTimeVector<type, allocator>::At(uint32_t pos) const
+	{
+		assert(m_Size > pos);
+		return *Slot(pos);
+	}
+
+	template<typename type, typename allocator>
+	inline type& RealTimeVector<type, allocator>::At(uint32_t pos)
+	{
+		assert(m_Size > pos);
+		return *Slot(pos);
+	}
+
+	template<typename type, typename allocator>
+	inline const type& RealTimeVector<type, allocator>::operator[](uint32_t pos) const
+	{
+		return *Slot(pos);
+	}
+
+	template<typename type, typename allocator>
+	inline type& RealTimeVector<type, allocator>::operator[](uint32_t pos)
+	{
+		return *Slot(pos);
+	}
+
+	template<typename type, typename allocator>
+	inline const type& RealTimeVector<type, allocator>::Front() const
+	{
+		assert(m_Size > 0);
+		return *Slot(0);
+	}
+
+	template<typename type, typename allocator>
+	inline type& RealTimeVector<type, allocator>::Front()
+	{
+		assert(m_Size > 0);
+		return *Slot(0);
+	}
+
+	template<typename type, typename allocator>
+	inline const type& RealTimeVector<type, allocator>::Back() const
+	{
+		assert(m_Size > 0);
+		return *Slot(m_Size - 1);
+	}
+
+	template<typename type, typename allocator>
+	inline type& RealTimeVector<type, allocator>::Back()
+	{
+		assert(m_Size > 0);
+		return *Slot(m_Size - 1);
+	}
+
+	template<typename type, typename allocator>
+	inline type* RealTimeVector<type, allocator>::Data()
+	{
+		FinishMigration();
+		return m_pData;
+	}
+#pragma endregion
+
+#pragma region Capacity
+	template<typename type, typename allocator>
+	inline bool RealTimeVector<type, allocator>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename type, typename allocator>
+	inline uint32_t RealTimeVector<type, allocator>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename type, typename allocator>
+	inline uint32_t RealTimeVector<type, allocator>::Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::Reserve(uint32_t newCapacity)
+	{
+		if (newCapacity <= m_Capacity)
+		{
+			return;
+		}
+
+		FinishMigration();
+		type* pNewData = alloc_traits::allocate(m_Allocator, newCapacity);
+		if (m_pData)
+		{
+			RelocateElements(pNewData, m_pData, m_Size);
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
+		m_pData = pNewData;
+		m_Capacity = newCapacity;
+	}
+
+	template<typename type, typename allocator>
+	inline bool RealTimeVector<type, allocator>::IsMigrating() const
+	{
+		return m_pOldData != nullptr;
+	}
+
+	template<typename type, typename allocator>
+	inline uint32_t RealTimeVector<type, allocator>::PendingMigration() const
+	{
+		return m_OldSize - m_Migrated;
+	}
+#pragma endregion
+
+#pragma region Modifiers
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::Clear()
+	{
+		if constexpr (!std::is_trivially_destructible<type>::value)
+		{
+			for (uint32_t i{}; i < m_Size; ++i)
+			{
+				alloc_traits::destroy(m_Allocator, Slot(i));
+			}
+		}
+		m_Size = 0;
+		ReleaseOldBuffer();
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::PushBack(const type& value)
+	{
+		EmplaceBack(value);
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::PushBack(type&& value)
+	{
+		EmplaceBack(std::move(value));
+	}
+
+	template<typename type, typename allocator>
+	template<class... ARGS>
+	inline void RealTimeVector<type, allocator>::EmplaceBack(ARGS&&... args)
+	{
+		if (m_Size == m_Capacity)
+		{
+			Grow();
+		}
+
+		// growing doesn't move any element, so args can still refer to one of ours
+		alloc_traits::construct(m_Allocator, m_pData + m_Size, std::forward<ARGS>(args)...);
+		++m_Size;
+
+		if (m_pOldData)
+		{
+			Migrate(MigrationStep);
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::PopBack()
+	{
+		assert(m_Size > 0);
+		--m_Size;
+		if constexpr (!std::is_trivially_destructible<type>::value)
+		{
+			alloc_traits::destroy(m_Allocator, Slot(m_Size));
+		}
+
+		// popping into the part that is still in the old buffer leaves less to migrate
+		if (m_Size < m_OldSize)
+		{
+			m_OldSize = m_Size;
+			if (m_Migrated >= m_OldSize)
+			{
+				ReleaseOldBuffer();
+			}
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::FinishMigration()
+	{
+		if (m_pOldData)
+		{
+			Migrate(m_OldSize - m_Migrated);
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::Swap(RealTimeVector& other) noexcept
+	{
+		std::swap(m_pData, other.m_pData);
+		std::swap(m_pOldData, other.m_pOldData);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_Migrated, other.m_Migrated);
+		std::swap(m_OldSize, other.m_OldSize);
+		std::swap(m_OldCapacity, other.m_OldCapacity);
+		if constexpr (alloc_traits::propagate_on_container_swap::value)
+		{
+			std::swap(m_Allocator, other.m_Allocator);
+		}
+		else
+		{
+			// without propagation each buffer stays with the allocator that has to free it
+			assert(AllocatorEquals(other));
+		}
+	}
+#pragma endregion
+
+#pragma region Helpers
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::Grow()
+	{
+		// Every push moves at least one element and every pop leaves at least one less to move, so the elements still
+		// in the old buffer never outnumber the free slots in the new one. A full buffer means the migration is done
+		assert(!m_pOldData);
+
+		const uint32_t newCapacity = m_Capacity > 0 ? m_Capacity * 2 : m_DefaultSize;
+		m_pOldData = m_pData;
+		m_OldCapacity = m_Capacity;
+		m_OldSize = m_Size;
+		m_Migrated = 0;
+		m_pData = alloc_traits::allocate(m_Allocator, newCapacity);
+		m_Capacity = newCapacity;
+		if (m_OldSize == 0)
+		{
+			ReleaseOldBuffer();
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::Migrate(uint32_t count)
+	{
+		const uint32_t end = count < m_OldSize - m_Migrated ? m_Migrated + count : m_OldSize;
+		RelocateElements(m_pData + m_Migrated, m_pOldData + m_Migrated, end - m_Migrated);
+		m_Migrated = end;
+		if (m_Migrated == m_OldSize)
+		{
+			ReleaseOldBuffer();
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::ReleaseOldBuffer()
+	{
+		if (m_pOldData)
+		{
+			alloc_traits::deallocate(m_Allocator, m_pOldData, m_OldCapacity);
+		}
+		m_pOldData = nullptr;
+		m_OldCapacity = 0;
+		m_OldSize = 0;
+		m_Migrated = 0;
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::RelocateElements(type* pDest, type* pSrc, uint32_t count)
+	{
+		// elements like std::string with its short string buffer may point into themselves, so only trivially copyable ones can move as bytes
+		if constexpr (std::is_trivially_copyable<type>::value)
+		{
+			CopyBytes(pDest, pSrc, count * sizeof(type));
+		}
+		else
+		{
+			for (uint32_t i{}; i < count; ++i)
+			{
+				alloc_traits::construct(m_Allocator, pDest + i, std::move(pSrc[i]));
+				alloc_traits::destroy(m_Allocator, pSrc + i);
+			}
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline bool RealTimeVector<type, allocator>::AllocatorEquals(const RealTimeVector& other) const
+	{
+		if constexpr (alloc_traits::is_always_equal::value)
+		{
+			return true;
+		}
+		else
+		{
+			return m_Allocator == other.m_Allocator;
+		}
+	}
+
+	template<typename type, typename allocator>
+	inline void RealTimeVector<type, allocator>::MoveElementsFrom(RealTimeVector& other)
+	{
+		assert(m_Size == 0);
+		Reserve(other.m_Size);
+		for (uint32_t i{}; i < other.m_Size; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i, std::move(other[i]));
+			++m_Size;
+		}
+		other.Clear();
+	}
+#pragma endregion
+}
@@ -0,0 +1,739 @@
+#pragma once
+#include "Vector.h"
+#include "Hash.h"
+#include <cassert>
+#include <cstdint>
+#include <bit>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Container
+{
+	// Slot of a RobinHoodMap, only holds a constructed pair while it's occupied
+	template<typename key, typename value>
+	class RobinHoodEntry final
+	{
+	public:
+		using value_type = std::pair<key, value>;
+
+		RobinHoodEntry();
+		RobinHoodEntry(const RobinHoodEntry& other);
+		RobinHoodEntry(RobinHoodEntry&& other) noexcept;
+		RobinHoodEntry& operator=(const RobinHoodEntry& other);
+		RobinHoodEntry& operator=(RobinHoodEntry&& other) noexcept;
+		~RobinHoodEntry();
+
+		_NODISCARD bool Occupied() const;
+		_NODISCARD uint32_t Distance() const;
+		_NODISCARD uint32_t Hash() const;
+		_NODISCARD value_type& Pair();
+		_NODISCARD const value_type& Pair() const;
+
+		template<class... ARGS>
+		void Emplace(uint32_t distance, uint32_t hash, ARGS&&... args);
+		// Moves other's pair in and leaves other empty
+		void Take(RobinHoodEntry& other, uint32_t distance);
+		void SetDistance(uint32_t distance);
+		void Destroy();
+
+	private:
+		uint32_t m_Distance; // 0 for an empty slot, probe sequence length + 1 otherwise
+		uint32_t m_Hash; // low half of the hash, compared before the keys and reused when growing
+		union
+		{
+			value_type m_Pair;
+		};
+	};
+
+	template<typename entryType>
+	class RobinHoodIterator final
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using pairType = std::conditional_t<std::is_const<entryType>::value, const typename entryType::value_type, typename entryType::value_type>;
+
+		RobinHoodIterator(entryType* pEntry, entryType* pEnd);
+
+		_NODISCARD pairType& operator*() const;
+		_NODISCARD pairType* operator->() const;
+		RobinHoodIterator& operator++();
+		RobinHoodIterator operator++(int);
+		bool operator==(const RobinHoodIterator& rhs) const;
+		bool operator!=(const RobinHoodIterator& rhs) const;
+
+	private:
+		void SkipEmpty();
+
+		entryType* m_pEntry;
+		entryType* m_pEnd;
+	};
+
+	// Open addressing with linear probing where an insert takes the slot of any element that is closer to its home slot
+	// than the new one, which keeps the probe lengths even. Every slot knows its distance from home, so a lookup can
+	// stop as soon as it passes an element that is closer to home than the key would be, and an erase shifts the
+	// following elements back one slot instead of leaving a tombstone
+	template<typename key, typename value, typename hash = std::hash<key>, typename keyEqual = std::equal_to<key>,
+		typename allocator = std::allocator<std::pair<key, value>>>
+	class RobinHoodMap final
+	{
+	public:
+#pragma region member types
+		using entry = RobinHoodEntry<key, value>;
+		// the key isn't const so entries can move, changing it through an iterator breaks the map
+		using value_type = typename entry::value_type;
+		using iterator = RobinHoodIterator<entry>;
+		using const_iterator = RobinHoodIterator<const entry>;
+#pragma endregion
+#pragma region Iterator Functions
+		_NODISCARD iterator Begin();
+		_NODISCARD iterator End();
+		_NODISCARD const_iterator CBegin() const;
+		_NODISCARD const_iterator CEnd() const;
+#pragma endregion
+#pragma region De/Constructors
+		RobinHoodMap();
+		explicit RobinHoodMap(const allocator& alloc);
+		explicit RobinHoodMap(uint32_t expectedSize, const allocator& alloc = allocator{});
+		RobinHoodMap(const RobinHoodMap& other) = default;
+		RobinHoodMap(RobinHoodMap&& other) noexcept;
+		RobinHoodMap& operator=(const RobinHoodMap& other) = default;
+		RobinHoodMap& operator=(RobinHoodMap&& other) noexcept;
+		~RobinHoodMap() = default;
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD allocator GetAllocator() const;
+		_NODISCARD value& At(const key& k);
+		_NODISCARD const value& At(const key& k) const;
+		value& operator[](const key& k);
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		_NODISCARD uint32_t Capacity() const;
+		_NODISCARD float LoadFactor() const;
+		_NODISCARD float MaxLoadFactor() const;
+		// clamped to [0.25, 0.95], probe lengths grow quickly when the table gets close to full
+		void MaxLoadFactor(float maxLoadFactor);
+		// Makes room for count elements without growing
+		void Reserve(uint32_t count);
+#pragma endregion
+#pragma region Lookup
+		_NODISCARD iterator Find(const key& k);
+		_NODISCARD const_iterator Find(const key& k) const;
+		_NODISCARD bool Contains(const key& k) const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		std::pair<iterator, bool> Insert(const value_type& pair);
+		std::pair<iterator, bool> Insert(value_type&& pair);
+		// Only constructs the value from args when k is missing
+		template<class... ARGS>
+		std::pair<iterator, bool> TryEmplace(const key& k, ARGS&&... args);
+		bool Erase(const key& k);
+		void Erase(iterator pos);
+		void Erase(const_iterator pos);
+		void Swap(RobinHoodMap& other) noexcept;
+#pragma endregion
+
+	private:
+		using entryAllocator = typename std::allocator_traits<allocator>::template rebind_alloc<entry>;
+
+		static constexpr uint32_t NotFound = UINT32_MAX;
+		static constexpr uint32_t m_MinCapacity = 16;
+
+		uint64_t HashKey(const key& k) const;
+		uint32_t FindIndex(const key& k, uint64_t hashValue) const;
+		template<class... ARGS>
+		uint32_t InsertNew(uint64_t hashValue, ARGS&&... args);
+		void EraseAt(uint32_t idx);
+		void Resize(uint32_t newCapacity);
+		uint32_t GrowthLimit(uint32_t capacity) const;
+		uint32_t CapacityFor(uint32_t count) const;
+
+		Vector<entry, entryAllocator> m_Entries;
+		uint32_t m_Size;
+		float m_MaxLoadFactor;
+		hash m_Hash;
+		keyEqual m_KeyEqual;
+	};
+
+#pragma region Entry
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>::RobinHoodEntry()
+		: m_Distance{ 0 }
+		, m_Hash{ 0 }
+	{
+	}
+
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>::RobinHoodEntry(const RobinHoodEntry& other)
+		: m_Distance{ other.m_Distance }
+		, m_Hash{ other.m_Hash }
+	{
+		if (other.Occupied())
+		{
+			std::construct_at(&m_Pair, other.m_Pair);
+		}
+	}
+
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>::RobinHoodEntry(RobinHoodEntry&& other) noexcept
+		: m_Distance{ other.m_Distance }
+		, m_Hash{ other.m_Hash }
+	{
+		if (other.Occupied())
+		{
+			std::construct_at(&m_Pair, std::move(other.m_Pair));
+		}
+	}
+
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>& RobinHoodEntry<key, value>::operator=(const RobinHoodEntry& other)
+	{
+		if (this != &other)
+		{
+			Destroy();
+			if (other.Occupied())
+			{
+				Emplace(other.m_Distance, other.m_Hash, other.m_Pair);
+			}
+		}
+		return *this;
+	}
+
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>& RobinHoodEntry<key, value>::operator=(RobinHoodEntry&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Destroy();
+			if (other.Occupied())
+			{
+				Emplace(other.m_Distance, other.m_Hash, std::move(other.m_Pair));
+			}
+		}
+		return *this;
+	}
+
+	template<typename key, typename value>
+	inline RobinHoodEntry<key, value>::~RobinHoodEntry()
+	{
+		Destroy();
+	}
+
+	template<typename key, typename value>
+	inline bool RobinHoodEntry<key, value>::Occupied() const
+	{
+		return m_Distance != 0;
+	}
+
+	template<typename key, typename value>
+	inline uint32_t RobinHoodEntry<key, value>::Distance() const
+	{
+		return m_Distance;
+	}
+
+	template<typename key, typename value>
+	inline uint32_t RobinHoodEntry<key, value>::Hash() const
+	{
+		return m_Hash;
+	}
+
+	template<typename key, typename value>
+	inline typename RobinHoodEntry<key, value>::value_type& RobinHoodEntry<key, value>::Pair()
+	{
+		assert(Occupied());
+		return m_Pair;
+	}
+
+	template<typename key, typename value>
+	inline const typename RobinHoodEntry<key, value>::value_type& RobinHoodEntry<key, value>::Pair() const
+	{
+		assert(Occupied());
+		return m_Pair;
+	}
+
+	template<typename key, typename value>
+	template<class... ARGS>
+	inline void RobinHoodEntry<key, value>::Emplace(uint32_t distance, uint32_t hash, ARGS&&... args)
+	{
+		assert(!Occupied() && distance != 0);
+		std::construct_at(&m_Pair, std::forward<ARGS>(args)...);
+		m_Distance = distance;
+		m_Hash = hash;
+	}
+
+	template<typename key, typename value>
+	inline void RobinHoodEntry<key, value>::Take(RobinHoodEntry& other, uint32_t distance)
+	{
+		Emplace(distance, other.m_Hash, std::move(other.m_Pair));
+		other.Destroy();
+	}
+
+	template<typename key, typename value>
+	inline void RobinHoodEntry<key, value>::SetDistance(uint32_t distance)
+	{
+		assert(Occupied() && distance != 0);
+		m_Distance = distance;
+	}
+
+	template<typename key, typename value>
+	inline void RobinHoodEntry<key, value>::Destroy()
+	{
+		if (Occupied())
+		{
+			std::destroy_at(&m_Pair);
+			m_Distance = 0;
+		}
+	}
+#pragma endregion
+
+#pragma region Iterator
+	template<typename entryType>
+	inline RobinHoodIterator<entryType>::RobinHoodIterator(entryType* pEntry, entryType* pEnd)
+		: m_pEntry{ pEntry }
+		, m_pEnd{ pEnd }
+	{
+		SkipEmpty();
+	}
+
+	template<typename entryType>
+	inline typename RobinHoodIterator<entryType>::pairType& RobinHoodIterator<entryType>::operator*() const
+	{
+		return m_pEntry->Pair();
+	}
+
+	template<typename entryType>
+	inline typename RobinHoodIterator<entryType>::pairType* RobinHoodIterator<entryType>::operator->() const
+	{
+		return &m_pEntry->Pair();
+	}
+
+	template<typename entryType>
+	inline RobinHoodIterator<entryType>& RobinHoodIterator<entryType>::operator++()
+	{
+		++m_pEntry;
+		SkipEmpty();
+		return *this;
+	}
+
+	template<typename entryType>
+	inline RobinHoodIterator<entryType> RobinHoodIterator<entryType>::operator++(int)
+	{
+		RobinHoodIterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	template<typename entryType>
+	inline bool RobinHoodIterator<entryType>::operator==(const RobinHoodIterator& rhs) const
+	{
+		return m_pEntry == rhs.m_pEntry;
+	}
+
+	template<typename entryType>
+	inline bool RobinHoodIterator<entryType>::operator!=(const RobinHoodIterator& rhs) const
+	{
+		return m_pEntry != rhs.m_pEntry;
+	}
+
+	template<typename entryType>
+	inline void RobinHoodIterator<entryType>::SkipEmpty()
+	{
+		while (m_pEntry != m_pEnd && !m_pEntry->Occupied())
+		{
+			++m_pEntry;
+		}
+	}
+#pragma endregion
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline RobinHoodMap<key, value, hash, keyEqual, allocator>::RobinHoodMap()
+		: RobinHoodMap(allocator{})
+	{
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline RobinHoodMap<key, value, hash, keyEqual, allocator>::RobinHoodMap(const allocator& alloc)
+		: m_Entries{ entryAllocator{ alloc } }
+		, m_Size{ 0 }
+		, m_MaxLoadFactor{ 0.875f }
+		, m_Hash{}
+		, m_KeyEqual{}
+	{
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline RobinHoodMap<key, value, hash, keyEqual, allocator>::RobinHoodMap(uint32_t expectedSize, const allocator& alloc)
+		: RobinHoodMap(alloc)
+	{
+		Reserve(expectedSize);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline RobinHoodMap<key, value, hash, keyEqual, allocator>::RobinHoodMap(RobinHoodMap&& other) noexcept
+		: m_Entries{ std::move(other.m_Entries) }
+		, m_Size{ other.m_Size }
+		, m_MaxLoadFactor{ other.m_MaxLoadFactor }
+		, m_Hash{ std::move(other.m_Hash) }
+		, m_KeyEqual{ std::move(other.m_KeyEqual) }
+	{
+		other.m_Size = 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline RobinHoodMap<key, value, hash, keyEqual, allocator>& RobinHoodMap<key, value, hash, keyEqual, allocator>::operator=(RobinHoodMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			m_Entries = std::move(other.m_Entries);
+			m_Size = other.m_Size;
+			other.m_Size = 0;
+			m_MaxLoadFactor = other.m_MaxLoadFactor;
+			m_Hash = std::move(other.m_Hash);
+			m_KeyEqual = std::move(other.m_KeyEqual);
+		}
+		return *this;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::Begin()
+	{
+		return iterator{ m_Entries.Data(), m_Entries.Data() + m_Entries.Size() };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::End()
+	{
+		return iterator{ m_Entries.Data() + m_Entries.Size(), m_Entries.Data() + m_Entries.Size() };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::const_iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::CBegin() const
+	{
+		return const_iterator{ m_Entries.Data(), m_Entries.Data() + m_Entries.Size() };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::const_iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::CEnd() const
+	{
+		return const_iterator{ m_Entries.Data() + m_Entries.Size(), m_Entries.Data() + m_Entries.Size() };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline allocator RobinHoodMap<key, value, hash, keyEqual, allocator>::GetAllocator() const
+	{
+		return allocator{ m_Entries.GetAllocator() };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline value& RobinHoodMap<key, value, hash, keyEqual, allocator>::At(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		assert(idx != NotFound);
+		return m_Entries[idx].Pair().second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline const value& RobinHoodMap<key, value, hash, keyEqual, allocator>::At(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		assert(idx != NotFound);
+		return m_Entries[idx].Pair().second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline value& RobinHoodMap<key, value, hash, keyEqual, allocator>::operator[](const key& k)
+	{
+		return TryEmplace(k).first->second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool RobinHoodMap<key, value, hash, keyEqual, allocator>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::Capacity() const
+	{
+		return m_Entries.Size();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline float RobinHoodMap<key, value, hash, keyEqual, allocator>::LoadFactor() const
+	{
+		return m_Entries.Size() > 0 ? static_cast<float>(m_Size) / m_Entries.Size() : 0.f;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline float RobinHoodMap<key, value, hash, keyEqual, allocator>::MaxLoadFactor() const
+	{
+		return m_MaxLoadFactor;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::MaxLoadFactor(float maxLoadFactor)
+	{
+		m_MaxLoadFactor = maxLoadFactor < 0.25f ? 0.25f : (maxLoadFactor > 0.95f ? 0.95f : maxLoadFactor);
+		if (m_Size > GrowthLimit(m_Entries.Size()))
+		{
+			Resize(CapacityFor(m_Size));
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Reserve(uint32_t count)
+	{
+		if (count > GrowthLimit(m_Entries.Size()))
+		{
+			Resize(CapacityFor(count));
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::Find(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		return idx != NotFound ? iterator{ m_Entries.Data() + idx, m_Entries.Data() + m_Entries.Size() } : End();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename RobinHoodMap<key, value, hash, keyEqual, allocator>::const_iterator RobinHoodMap<key, value, hash, keyEqual, allocator>::Find(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		return idx != NotFound ? const_iterator{ m_Entries.Data() + idx, m_Entries.Data() + m_Entries.Size() } : CEnd();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool RobinHoodMap<key, value, hash, keyEqual, allocator>::Contains(const key& k) const
+	{
+		return FindIndex(k, HashKey(k)) != NotFound;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Clear()
+	{
+		for (uint32_t i{}; i < m_Entries.Size(); ++i)
+		{
+			m_Entries[i].Destroy();
+		}
+		m_Size = 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline std::pair<typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		RobinHoodMap<key, value, hash, keyEqual, allocator>::Insert(const value_type& pair)
+	{
+		return TryEmplace(pair.first, pair.second);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline std::pair<typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		RobinHoodMap<key, value, hash, keyEqual, allocator>::Insert(value_type&& pair)
+	{
+		const uint64_t hashValue = HashKey(pair.first);
+		uint32_t idx = FindIndex(pair.first, hashValue);
+		const bool inserted = idx == NotFound;
+		if (inserted)
+		{
+			idx = InsertNew(hashValue, std::move(pair));
+		}
+		return { iterator{ m_Entries.Data() + idx, m_Entries.Data() + m_Entries.Size() }, inserted };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<class... ARGS>
+	inline std::pair<typename RobinHoodMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		RobinHoodMap<key, value, hash, keyEqual, allocator>::TryEmplace(const key& k, ARGS&&... args)
+	{
+		const uint64_t hashValue = HashKey(k);
+		uint32_t idx = FindIndex(k, hashValue);
+		const bool inserted = idx == NotFound;
+		if (inserted)
+		{
+			idx = InsertNew(hashValue, std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(std::forward<ARGS>(args)...));
+		}
+		return { iterator{ m_Entries.Data() + idx, m_Entries.Data() + m_Entries.Size() }, inserted };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool RobinHoodMap<key, value, hash, keyEqual, allocator>::Erase(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		if (idx == NotFound)
+		{
+			return false;
+		}
+		EraseAt(idx);
+		return true;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Erase(iterator pos)
+	{
+		Erase(pos->first);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Erase(const_iterator pos)
+	{
+		Erase(pos->first);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Swap(RobinHoodMap& other) noexcept
+	{
+		m_Entries.Swap(other.m_Entries);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_MaxLoadFactor, other.m_MaxLoadFactor);
+		std::swap(m_Hash, other.m_Hash);
+		std::swap(m_KeyEqual, other.m_KeyEqual);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint64_t RobinHoodMap<key, value, hash, keyEqual, allocator>::HashKey(const key& k) const
+	{
+		return MixHash(static_cast<uint64_t>(m_Hash(k)));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::FindIndex(const key& k, uint64_t hashValue) const
+	{
+		const uint32_t capacity = m_Entries.Size();
+		if (capacity == 0)
+		{
+			return NotFound;
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint32_t fragment = static_cast<uint32_t>(hashValue);
+		uint32_t idx = static_cast<uint32_t>(hashValue >> 32) & mask;
+		const entry* pEntries = m_Entries.Data();
+		for (uint32_t distance{ 1 }; ; ++distance)
+		{
+			const entry& current = pEntries[idx];
+			// an empty slot has distance 0, and an element closer to its home would have been displaced by k
+			if (current.Distance() < distance)
+			{
+				return NotFound;
+			}
+			if (current.Hash() == fragment && m_KeyEqual(current.Pair().first, k))
+			{
+				return idx;
+			}
+			idx = (idx + 1) & mask;
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<class... ARGS>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::InsertNew(uint64_t hashValue, ARGS&&... args)
+	{
+		if (m_Size + 1 > GrowthLimit(m_Entries.Size()))
+		{
+			Resize(CapacityFor(m_Size + 1));
+		}
+
+		const uint32_t mask = m_Entries.Size() - 1;
+		const uint32_t fragment = static_cast<uint32_t>(hashValue);
+		uint32_t idx = static_cast<uint32_t>(hashValue >> 32) & mask;
+		uint32_t distance = 1;
+		while (m_Entries[idx].Occupied() && m_Entries[idx].Distance() >= distance)
+		{
+			++distance;
+			idx = (idx + 1) & mask;
+		}
+
+		const uint32_t insertedIdx = idx;
+		if (!m_Entries[idx].Occupied())
+		{
+			m_Entries[idx].Emplace(distance, fragment, std::forward<ARGS>(args)...);
+		}
+		else
+		{
+			// take from the rich: the resident is closer to home than the new element, so it moves further along instead
+			entry carried{};
+			carried.Emplace(distance, fragment, std::forward<ARGS>(args)...);
+			std::swap(m_Entries[idx], carried);
+			while (true)
+			{
+				carried.SetDistance(carried.Distance() + 1);
+				idx = (idx + 1) & mask;
+				entry& current = m_Entries[idx];
+				if (!current.Occupied())
+				{
+					current.Take(carried, carried.Distance());
+					break;
+				}
+				if (current.Distance() < carried.Distance())
+				{
+					std::swap(current, carried);
+				}
+			}
+		}
+
+		++m_Size;
+		return insertedIdx;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::EraseAt(uint32_t idx)
+	{
+		// backward shift: pull the following elements one slot closer to home until one is already home or a slot is empty
+		const uint32_t mask = m_Entries.Size() - 1;
+		m_Entries[idx].Destroy();
+		uint32_t next = (idx + 1) & mask;
+		while (m_Entries[next].Distance() > 1)
+		{
+			m_Entries[idx].Take(m_Entries[next], m_Entries[next].Distance() - 1);
+			idx = next;
+			next = (next + 1) & mask;
+		}
+		--m_Size;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void RobinHoodMap<key, value, hash, keyEqual, allocator>::Resize(uint32_t newCapacity)
+	{
+		assert(std::has_single_bit(newCapacity) && newCapacity >= m_MinCapacity);
+		// the old entries stay with our allocator, so the swap never has to move allocators around
+		Vector<entry, entryAllocator> oldEntries{ m_Entries.GetAllocator() };
+		oldEntries.Swap(m_Entries);
+		m_Entries.Resize(newCapacity);
+		m_Size = 0;
+
+		for (uint32_t i{}; i < oldEntries.Size(); ++i)
+		{
+			if (oldEntries[i].Occupied())
+			{
+				value_type& pair = oldEntries[i].Pair();
+				InsertNew(HashKey(pair.first), std::move(pair));
+			}
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::GrowthLimit(uint32_t capacity) const
+	{
+		return static_cast<uint32_t>(capacity * m_MaxLoadFactor);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t RobinHoodMap<key, value, hash, keyEqual, allocator>::CapacityFor(uint32_t count) const
+	{
+		uint32_t capacity = m_MinCapacity;
+		while (static_cast<uint32_t>(capacity * m_MaxLoadFactor) < count)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+}
@@ -0,0 +1,364 @@
+#pragma once
+#include "CpuDispatch.h"
+#include "Platform.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The fill, find and compare kernels behind Fill, Find and Equal in Algorithm.h, one per SimdTier
+// They only see bytes: fill writes a pattern, find looks for an element with the same bits and compare checks two ranges
+// for equal bytes. The copy kernels live in MemoryCopy.h
+namespace Container
+{
+	namespace Detail
+	{
+		// pattern is the value repeated over all 8 bytes and bytes a multiple of the value size, so every 8 byte
+		// store of the pattern lines up with the values, wherever it starts
+		using FillKernel = void(*)(void* pDest, uint64_t pattern, size_t bytes);
+		// index of the first element whose bits equal the lowest sizeof(element) bytes of pattern, count when there is none
+		using FindKernel = size_t(*)(const void* pData, uint64_t pattern, size_t count);
+		using EqualKernel = bool(*)(const void* pLhs, const void* pRhs, size_t bytes);
+
+#pragma region Scalar
+		inline void FillScalar(void* pDest, uint64_t pattern, size_t bytes)
+		{
+			char* pBytes = static_cast<char*>(pDest);
+			size_t offset{};
+			for (; offset + 8 <= bytes; offset += 8)
+			{
+				std::memcpy(pBytes + offset, &pattern, 8);
+			}
+			std::memcpy(pBytes + offset, &pattern, bytes - offset);
+		}
+
+		template<typename element>
+		inline size_t FindScalar(const void* pData, uint64_t pattern, size_t count)
+		{
+			const char* pBytes = static_cast<const char*>(pData);
+			const element wanted = static_cast<element>(pattern);
+			for (size_t i{}; i < count; ++i)
+			{
+				element value;
+				std::memcpy(&value, pBytes + i * sizeof(element), sizeof(element));
+				if (value == wanted)
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		inline bool EqualScalar(const void* pLhs, const void* pRhs, size_t bytes)
+		{
+			const char* pLhsBytes = static_cast<const char*>(pLhs);
+			const char* pRhsBytes = static_cast<const char*>(pRhs);
+			size_t offset{};
+			for (; offset + 8 <= bytes; offset += 8)
+			{
+				uint64_t lhs;
+				uint64_t rhs;
+				std::memcpy(&lhs, pLhsBytes + offset, 8);
+				std::memcpy(&rhs, pRhsBytes + offset, 8);
+				if (lhs != rhs)
+				{
+					return false;
+				}
+			}
+			for (; offset < bytes; ++offset)
+			{
+				if (pLhsBytes[offset] != pRhsBytes[offset])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+#pragma endregion
+
+#if CONTAINER_X86
+#pragma region SSE4.2
+		template<typename element>
+		CONTAINER_TARGET("sse4.2") CONTAINER_FORCEINLINE __m128i CompareEqual128(__m128i lhs, __m128i rhs)
+		{
+			if constexpr (sizeof(element) == 1)
+			{
+				return _mm_cmpeq_epi8(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 2)
+			{
+				return _mm_cmpeq_epi16(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 4)
+			{
+				return _mm_cmpeq_epi32(lhs, rhs);
+			}
+			else
+			{
+				return _mm_cmpeq_epi64(lhs, rhs);
+			}
+		}
+
+		CONTAINER_TARGET("sse4.2") inline void FillSse42(void* pDest, uint64_t pattern, size_t bytes)
+		{
+			if (bytes < 16)
+			{
+				FillScalar(pDest, pattern, bytes);
+				return;
+			}
+			char* pBytes = static_cast<char*>(pDest);
+			const __m128i value = _mm_set1_epi64x(static_cast<long long>(pattern));
+			for (size_t offset{}; offset + 16 <= bytes; offset += 16)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pBytes + offset), value);
+			}
+			// the last 16 bytes overlap what the loop wrote instead of needing a remainder loop
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pBytes + bytes - 16), value);
+		}
+
+		template<typename element>
+		CONTAINER_TARGET("sse4.2") inline size_t FindSse42(const void* pData, uint64_t pattern, size_t count)
+		{
+			const char* pBytes = static_cast<const char*>(pData);
+			const size_t bytes = count * sizeof(element);
+			const __m128i wanted = _mm_set1_epi64x(static_cast<long long>(pattern));
+			size_t offset{};
+			for (; offset + 16 <= bytes; offset += 16)
+			{
+				const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + offset));
+				const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(CompareEqual128<element>(values, wanted)));
+				if (mask != 0)
+				{
+					return (offset + std::countr_zero(mask)) / sizeof(element);
+				}
+			}
+			return offset / sizeof(element) + FindScalar<element>(pBytes + offset, pattern, count - offset / sizeof(element));
+		}
+
+		CONTAINER_TARGET("sse4.2") inline bool EqualSse42(const void* pLhs, const void* pRhs, size_t bytes)
+		{
+			if (bytes < 16)
+			{
+				return EqualScalar(pLhs, pRhs, bytes);
+			}
+			const char* pLhsBytes = static_cast<const char*>(pLhs);
+			const char* pRhsBytes = static_cast<const char*>(pRhs);
+			auto differs = [pLhsBytes, pRhsBytes](size_t offset) CONTAINER_TARGET("sse4.2")
+				{
+					const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLhsBytes + offset));
+					const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRhsBytes + offset));
+					const __m128i difference = _mm_xor_si128(lhs, rhs);
+					return !_mm_testz_si128(difference, difference);
+				};
+			for (size_t offset{}; offset + 16 <= bytes; offset += 16)
+			{
+				if (differs(offset))
+				{
+					return false;
+				}
+			}
+			// comparing a few bytes twice is cheaper than a remainder loop
+			return !differs(bytes - 16);
+		}
+#pragma endregion
+
+#pragma region AVX2
+		template<typename element>
+		CONTAINER_TARGET("avx2") CONTAINER_FORCEINLINE __m256i CompareEqual256(__m256i lhs, __m256i rhs)
+		{
+			if constexpr (sizeof(element) == 1)
+			{
+				return _mm256_cmpeq_epi8(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 2)
+			{
+				return _mm256_cmpeq_epi16(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 4)
+			{
+				return _mm256_cmpeq_epi32(lhs, rhs);
+			}
+			else
+			{
+				return _mm256_cmpeq_epi64(lhs, rhs);
+			}
+		}
+
+		CONTAINER_TARGET("avx2") inline void FillAvx2(void* pDest, uint64_t pattern, size_t bytes)
+		{
+			if (bytes < 32)
+			{
+				FillSse42(pDest, pattern, bytes);
+				return;
+			}
+			char* pBytes = static_cast<char*>(pDest);
+			const __m256i value = _mm256_set1_epi64x(static_cast<long long>(pattern));
+			size_t offset{};
+			for (; offset + 128 <= bytes; offset += 128)
+			{
+				__m256i* pVectors = reinterpret_cast<__m256i*>(pBytes + offset);
+				_mm256_storeu_si256(pVectors, value);
+				_mm256_storeu_si256(pVectors + 1, value);
+				_mm256_storeu_si256(pVectors + 2, value);
+				_mm256_storeu_si256(pVectors + 3, value);
+			}
+			for (; offset + 32 <= bytes; offset += 32)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(pBytes + offset), value);
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(pBytes + bytes - 32), value);
+		}
+
+		// 64 bytes per iteration, the two compares get combined so the loop has one branch
+		template<typename element>
+		CONTAINER_TARGET("avx2") inline size_t FindAvx2(const void* pData, uint64_t pattern, size_t count)
+		{
+			const char* pBytes = static_cast<const char*>(pData);
+			const size_t bytes = count * sizeof(element);
+			const __m256i wanted = _mm256_set1_epi64x(static_cast<long long>(pattern));
+			size_t offset{};
+			for (; offset + 64 <= bytes; offset += 64)
+			{
+				const __m256i first = CompareEqual256<element>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBytes + offset)), wanted);
+				const __m256i second = CompareEqual256<element>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBytes + offset + 32)), wanted);
+				if (!_mm256_testz_si256(_mm256_or_si256(first, second), _mm256_or_si256(first, second)))
+				{
+					const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(first)) | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(second))) << 32);
+					return (offset + std::countr_zero(mask)) / sizeof(element);
+				}
+			}
+			return offset / sizeof(element) + FindSse42<element>(pBytes + offset, pattern, count - offset / sizeof(element));
+		}
+
+		CONTAINER_TARGET("avx2") inline bool EqualAvx2(const void* pLhs, const void* pRhs, size_t bytes)
+		{
+			if (bytes < 32)
+			{
+				return EqualSse42(pLhs, pRhs, bytes);
+			}
+			const char* pLhsBytes = static_cast<const char*>(pLhs);
+			const char* pRhsBytes = static_cast<const char*>(pRhs);
+			auto difference = [pLhsBytes, pRhsBytes](size_t offset) CONTAINER_TARGET("avx2")
+				{
+					return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLhsBytes + offset)),
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRhsBytes + offset)));
+				};
+			size_t offset{};
+			for (; offset + 64 <= bytes; offset += 64)
+			{
+				const __m256i differences = _mm256_or_si256(difference(offset), difference(offset + 32));
+				if (!_mm256_testz_si256(differences, differences))
+				{
+					return false;
+				}
+			}
+			const __m256i differences = _mm256_or_si256(difference(offset < bytes - 32 ? offset : bytes - 32), difference(bytes - 32));
+			return _mm256_testz_si256(differences, differences);
+		}
+#pragma endregion
+
+#pragma region AVX-512
+		template<typename element>
+		CONTAINER_TARGET("avx512f,avx512bw") CONTAINER_FORCEINLINE uint64_t CompareEqualMask512(__m512i lhs, __m512i rhs)
+		{
+			if constexpr (sizeof(element) == 1)
+			{
+				return _mm512_cmpeq_epi8_mask(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 2)
+			{
+				return _mm512_cmpeq_epi16_mask(lhs, rhs);
+			}
+			else if constexpr (sizeof(element) == 4)
+			{
+				return _mm512_cmpeq_epi32_mask(lhs, rhs);
+			}
+			else
+			{
+				return _mm512_cmpeq_epi64_mask(lhs, rhs);
+			}
+		}
+
+		// The masks have a bit per element, and the tail is a masked load that can't fault on the bytes past the end
+		template<typename element>
+		CONTAINER_TARGET("avx512f,avx512bw") inline size_t FindAvx512(const void* pData, uint64_t pattern, size_t count)
+		{
+			const char* pBytes = static_cast<const char*>(pData);
+			const size_t bytes = count * sizeof(element);
+			const __m512i wanted = _mm512_set1_epi64(static_cast<long long>(pattern));
+			size_t offset{};
+			for (; offset + 64 <= bytes; offset += 64)
+			{
+				const uint64_t mask = CompareEqualMask512<element>(_mm512_loadu_si512(pBytes + offset), wanted);
+				if (mask != 0)
+				{
+					return offset / sizeof(element) + std::countr_zero(mask);
+				}
+			}
+			if (offset == bytes)
+			{
+				return count;
+			}
+			const size_t remaining = (bytes - offset) / sizeof(element);
+			const __m512i values = _mm512_maskz_loadu_epi8((uint64_t{ 1 } << (bytes - offset)) - 1, pBytes + offset);
+			const uint64_t mask = CompareEqualMask512<element>(values, wanted) & ((uint64_t{ 1 } << remaining) - 1);
+			return mask != 0 ? offset / sizeof(element) + std::countr_zero(mask) : count;
+		}
+
+		CONTAINER_TARGET("avx512f,avx512bw") inline bool EqualAvx512(const void* pLhs, const void* pRhs, size_t bytes)
+		{
+			const char* pLhsBytes = static_cast<const char*>(pLhs);
+			const char* pRhsBytes = static_cast<const char*>(pRhs);
+			size_t offset{};
+			for (; offset + 64 <= bytes; offset += 64)
+			{
+				if (_mm512_cmpneq_epi64_mask(_mm512_loadu_si512(pLhsBytes + offset), _mm512_loadu_si512(pRhsBytes + offset)) != 0)
+				{
+					return false;
+				}
+			}
+			if (offset == bytes)
+			{
+				return true;
+			}
+			const __mmask64 tail = (uint64_t{ 1 } << (bytes - offset)) - 1;
+			return _mm512_cmpneq_epi8_mask(_mm512_maskz_loadu_epi8(tail, pLhsBytes + offset), _mm512_maskz_loadu_epi8(tail, pRhsBytes + offset)) == 0;
+		}
+#pragma endregion
+#endif
+
+#pragma region Kernel Tables
+		// AVX-512 fills with the AVX2 kernel, a fill is bound by the stores and 64 byte stores can lower the clock on older CPUs
+#if CONTAINER_X86
+		inline constexpr FillKernel FillKernels[SimdTierCount]{ FillScalar, FillSse42, FillAvx2, FillAvx2 };
+		template<typename element>
+		inline constexpr FindKernel FindKernels[SimdTierCount]{ FindScalar<element>, FindSse42<element>, FindAvx2<element>, FindAvx512<element> };
+		inline constexpr EqualKernel EqualKernels[SimdTierCount]{ EqualScalar, EqualSse42, EqualAvx2, EqualAvx512 };
+#else
+		inline constexpr FillKernel FillKernels[SimdTierCount]{ FillScalar, FillScalar, FillScalar, FillScalar };
+		template<typename element>
+		inline constexpr FindKernel FindKernels[SimdTierCount]{ FindScalar<element>, FindScalar<element>, FindScalar<element>, FindScalar<element> };
+		inline constexpr EqualKernel EqualKernels[SimdTierCount]{ EqualScalar, EqualScalar, EqualScalar, EqualScalar };
+#endif
+
+		inline FillKernel BoundFillKernel()
+		{
+			static const FillKernel kernel = BindKernel(FillKernels);
+			return kernel;
+		}
+
+		template<typename element>
+		inline FindKernel BoundFindKernel()
+		{
+			static const FindKernel kernel = BindKernel(FindKernels<element>);
+			return kernel;
+		}
+
+		inline EqualKernel BoundEqualKernel()
+		{
+			static const EqualKernel kernel = BindKernel(EqualKernels);
+			return kernel;
+		}
+#pragma endregion
+	}
+}
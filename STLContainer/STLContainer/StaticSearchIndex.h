@@ -0,0 +1,181 @@
+#pragma once
+#include "Vector.h"
+#include "Platform.h"
+#include <bit>
+#include <functional>
+
+namespace Container
+{
+	// Read only search index over sorted keys, stored in Eytzinger (BFS) order
+	// Node k has its children at 2k and 2k + 1, so the first levels of the tree share a handful of cache lines
+	// and the 16 great-great-grandchildren of a node sit next to each other, which makes them easy to prefetch
+	// Results are mapped back to positions in the sorted input the index was built from
+	template<typename type, typename compare = std::less<type>>
+	class StaticSearchIndex final
+	{
+	public:
+#pragma region member types
+		static constexpr uint32_t NoIndex = UINT32_MAX;
+#pragma endregion
+#pragma region Deleted Functions
+		// the keys are aligned to cache lines relative to the buffer, a copied buffer could end up with a different offset
+		StaticSearchIndex(const StaticSearchIndex& other) = delete;
+		StaticSearchIndex& operator=(const StaticSearchIndex& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		StaticSearchIndex();
+		template<typename allocator, typename hooks>
+		explicit StaticSearchIndex(const Vector<type, allocator, hooks>& sorted);
+		StaticSearchIndex(const type* pSorted, uint32_t size);
+		StaticSearchIndex(StaticSearchIndex&& other) = default;
+		StaticSearchIndex& operator=(StaticSearchIndex&& other) = default;
+		~StaticSearchIndex() = default;
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+#pragma endregion
+#pragma region Lookup
+		// Position in the sorted input of the first key that isn't less than value, Size() if there is none
+		_NODISCARD uint32_t LowerBound(const type& value) const;
+		// Position in the sorted input of value or NoIndex
+		_NODISCARD uint32_t Find(const type& value) const;
+		_NODISCARD bool Contains(const type& value) const;
+#pragma endregion
+#pragma region Modifiers
+		void Build(const type* pSorted, uint32_t size);
+#pragma endregion
+
+	private:
+		uint32_t BuildNode(const type* pSorted, uint32_t sortedIdx, uint64_t node);
+		uint64_t LowerBoundNode(const type& value) const;
+		const type* Keys() const;
+		type* Keys();
+
+		// amount of keys in one cache line, prefetching node * stride fetches 4 levels below node for 16 byte keys and 3 for 8 byte keys
+		static constexpr uint32_t m_PrefetchStride = sizeof(type) >= CONTAINER_CACHE_LINE ? 1 : CONTAINER_CACHE_LINE / sizeof(type);
+
+		Vector<type> m_Storage;
+		Vector<uint32_t> m_SortedPositions;
+		uint32_t m_Size;
+		compare m_Compare;
+	};
+
+	template<typename type, typename compare>
+	inline StaticSearchIndex<type, compare>::StaticSearchIndex()
+		: m_Storage{}
+		, m_SortedPositions{}
+		, m_Size{ 0 }
+		, m_Compare{}
+	{
+	}
+
+	template<typename type, typename compare>
+	template<typename allocator, typename hooks>
+	inline StaticSearchIndex<type, compare>::StaticSearchIndex(const Vector<type, allocator, hooks>& sorted)
+		: StaticSearchIndex(sorted.Data(), sorted.Size())
+	{
+	}
+
+	template<typename type, typename compare>
+	inline StaticSearchIndex<type, compare>::StaticSearchIndex(const type* pSorted, uint32_t size)
+		: StaticSearchIndex()
+	{
+		Build(pSorted, size);
+	}
+
+	template<typename type, typename compare>
+	inline bool StaticSearchIndex<type, compare>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename type, typename compare>
+	inline uint32_t StaticSearchIndex<type, compare>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename type, typename compare>
+	inline uint32_t StaticSearchIndex<type, compare>::LowerBound(const type& value) const
+	{
+		const uint64_t node = LowerBoundNode(value);
+		return node != 0 ? m_SortedPositions[static_cast<uint32_t>(node)] : m_Size;
+	}
+
+	template<typename type, typename compare>
+	inline uint32_t StaticSearchIndex<type, compare>::Find(const type& value) const
+	{
+		const uint64_t node = LowerBoundNode(value);
+		if (node == 0 || m_Compare(value, Keys()[node]))
+		{
+			return NoIndex;
+		}
+		return m_SortedPositions[static_cast<uint32_t>(node)];
+	}
+
+	template<typename type, typename compare>
+	inline bool StaticSearchIndex<type, compare>::Contains(const type& value) const
+	{
+		return Find(value) != NoIndex;
+	}
+
+	template<typename type, typename compare>
+	inline void StaticSearchIndex<type, compare>::Build(const type* pSorted, uint32_t size)
+	{
+		assert(size < UINT32_MAX);
+		m_Size = size;
+		// node 0 is unused, the extra stride worth of keys is room to line node 0 up with a cache line
+		m_Storage.Clear();
+		m_Storage.Resize(size + 1 + m_PrefetchStride);
+		m_SortedPositions.Clear();
+		m_SortedPositions.Resize(size + 1);
+		BuildNode(pSorted, 0, 1);
+	}
+
+	template<typename type, typename compare>
+	inline uint32_t StaticSearchIndex<type, compare>::BuildNode(const type* pSorted, uint32_t sortedIdx, uint64_t node)
+	{
+		// an in-order walk of the implicit tree visits the nodes in sorted order
+		if (node > m_Size)
+		{
+			return sortedIdx;
+		}
+		sortedIdx = BuildNode(pSorted, sortedIdx, 2 * node);
+		Keys()[node] = pSorted[sortedIdx];
+		m_SortedPositions[static_cast<uint32_t>(node)] = sortedIdx;
+		return BuildNode(pSorted, sortedIdx + 1, 2 * node + 1);
+	}
+
+	template<typename type, typename compare>
+	inline uint64_t StaticSearchIndex<type, compare>::LowerBoundNode(const type& value) const
+	{
+		const type* pKeys = Keys();
+		const uintptr_t keysAddress = reinterpret_cast<uintptr_t>(pKeys);
+		uint64_t node = 1;
+		while (node <= m_Size)
+		{
+			CONTAINER_PREFETCH(reinterpret_cast<const void*>(keysAddress + node * m_PrefetchStride * sizeof(type)));
+			node = 2 * node + (m_Compare(pKeys[node], value) ? 1 : 0);
+		}
+		// every right turn appended a 1, after dropping those and the last left turn we're at the answer
+		// when we only went right, node ends up at 0
+		node >>= std::countr_one(node) + 1;
+		return node;
+	}
+
+	template<typename type, typename compare>
+	inline const type* StaticSearchIndex<type, compare>::Keys() const
+	{
+		const uintptr_t address = reinterpret_cast<uintptr_t>(m_Storage.Data());
+		const uintptr_t aligned = (address + CONTAINER_CACHE_LINE - 1) & ~uintptr_t{ CONTAINER_CACHE_LINE - 1 };
+		const uintptr_t offset = (aligned - address) / sizeof(type);
+		return m_Storage.Data() + (offset < m_PrefetchStride ? offset : 0);
+	}
+
+	template<typename type, typename compare>
+	inline type* StaticSearchIndex<type, compare>::Keys()
+	{
+		return const_cast<type*>(static_cast<const StaticSearchIndex*>(this)->Keys());
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <ios>
+
+namespace Benchmark
+{
+	// Puts the flags and precision of a stream back the way they were when it goes out of scope, so a table printed with
+	// std::fixed and a small precision doesn't cut off the numbers whatever prints to std::cout after it
+	class StreamFormatGuard final
+	{
+	public:
+#pragma region Deleted Functions
+		StreamFormatGuard(const StreamFormatGuard& other) = delete;
+		StreamFormatGuard& operator=(const StreamFormatGuard& other) = delete;
+#pragma endregion
+#pragma region De/Constructors
+		explicit StreamFormatGuard(std::ios_base& stream);
+		~StreamFormatGuard();
+#pragma endregion
+
+	private:
+		std::ios_base& m_Stream;
+		std::ios_base::fmtflags m_Flags;
+		std::streamsize m_Precision;
+	};
+
+#pragma region StreamFormatGuard
+	inline StreamFormatGuard::StreamFormatGuard(std::ios_base& stream)
+		: m_Stream{ stream }
+		, m_Flags{ stream.flags() }
+		, m_Precision{ stream.precision() }
+	{
+	}
+
+	inline StreamFormatGuard::~StreamFormatGuard()
+	{
+		m_Stream.flags(m_Flags);
+		m_Stream.precision(m_Precision);
+	}
+#pragma endregion
+}
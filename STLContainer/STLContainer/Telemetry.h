@@ -0,0 +1,399 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+// Define as 1 to compile the allocation counters in, with 0 TelemetryAllocator is just an alias of the allocator it wraps
+#ifndef CONTAINER_TELEMETRY
+#define CONTAINER_TELEMETRY 0
+#endif
+
+namespace Container
+{
+	namespace Telemetry
+	{
+		// bucket i counts reallocations to a buffer of [2^i, 2^(i+1)) bytes
+		inline constexpr uint32_t HistogramBuckets = 40;
+
+		// Everything recorded for one tag, summed over all threads
+		struct Stats
+		{
+			const char* pName = "";
+			uint64_t allocations = 0;
+			uint64_t deallocations = 0;
+			uint64_t allocatedBytes = 0;
+			uint64_t deallocatedBytes = 0;
+			int64_t liveBytes = 0;
+			// sum of the peaks of every thread, exact when a tag is only used on one thread and an upper bound otherwise
+			uint64_t peakLiveBytes = 0;
+			uint64_t reallocations = 0;
+			uint64_t reallocatedBytes = 0; // bytes of elements that had to be moved to a new buffer
+			uint64_t reallocationHistogram[HistogramBuckets]{};
+			uint64_t destroyedContainers = 0;
+			uint64_t slackBytes = 0; // Capacity() - Size() of every container when it was destroyed
+		};
+
+		// The counters of one tag on one thread. Only the owning thread writes them, with plain loads and stores on
+		// relaxed atomics, so counting never locks or bounces a cache line between threads. Readers can load them at any time
+		class ThreadCounters final
+		{
+		public:
+			void Allocated(size_t bytes);
+			void Deallocated(size_t bytes);
+			void Reallocated(size_t movedBytes, size_t newBytes);
+			void Destroyed(size_t slackBytes);
+			void AddTo(Stats& stats) const;
+
+		private:
+			static void Add(std::atomic<uint64_t>& counter, uint64_t amount);
+
+			std::atomic<uint64_t> m_Allocations{ 0 };
+			std::atomic<uint64_t> m_Deallocations{ 0 };
+			std::atomic<uint64_t> m_AllocatedBytes{ 0 };
+			std::atomic<uint64_t> m_DeallocatedBytes{ 0 };
+			std::atomic<uint64_t> m_PeakLiveBytes{ 0 };
+			std::atomic<uint64_t> m_Reallocations{ 0 };
+			std::atomic<uint64_t> m_ReallocatedBytes{ 0 };
+			std::atomic<uint64_t> m_Histogram[HistogramBuckets]{};
+			std::atomic<uint64_t> m_DestroyedContainers{ 0 };
+			std::atomic<uint64_t> m_SlackBytes{ 0 };
+		};
+
+		// All threads' counters of one tag. Never destroyed, so counters outlive the threads that wrote them
+		class TagRegistry final
+		{
+		public:
+#pragma region Deleted Functions
+			TagRegistry(const TagRegistry& other) = delete;
+			TagRegistry& operator=(const TagRegistry& other) = delete;
+#pragma endregion
+			explicit TagRegistry(const char* pName);
+
+			// the only place that locks, once per thread per tag
+			_NODISCARD ThreadCounters& Register();
+			_NODISCARD Stats Collect() const;
+
+		private:
+			const char* m_pName;
+			mutable std::mutex m_Mutex;
+			std::vector<std::unique_ptr<ThreadCounters>> m_Counters;
+		};
+
+		// Names the tag in reports: tag::Name when it has one, the type name the compiler gives it otherwise
+		template<typename tag>
+		_NODISCARD const char* TagName();
+		template<typename tag>
+		_NODISCARD TagRegistry& Registry();
+		// the counters of tag for the calling thread
+		template<typename tag>
+		_NODISCARD ThreadCounters& Local();
+		_NODISCARD std::vector<TagRegistry*>& AllRegistries();
+		_NODISCARD std::mutex& AllRegistriesMutex();
+
+		template<typename tag>
+		_NODISCARD Stats Collect();
+		// One block per tag that was used, with the reallocation histogram left out where it's empty
+		void Report(std::ostream& out);
+	}
+
+	struct DefaultTelemetryTag
+	{
+		static constexpr const char* Name = "Default";
+	};
+
+#if CONTAINER_TELEMETRY
+	// Counts what goes through inner per tag (use one tag per container type you want to see apart) and gets told
+	// about reallocations and destruction by Vector, see Telemetry::Report for the results
+	template<typename type, typename tag = DefaultTelemetryTag, typename inner = std::allocator<type>>
+	class TelemetryAllocator
+	{
+		using inner_traits = std::allocator_traits<inner>;
+	public:
+#pragma region member types
+		using value_type = type;
+		using propagate_on_container_copy_assignment = typename inner_traits::propagate_on_container_copy_assignment;
+		using propagate_on_container_move_assignment = typename inner_traits::propagate_on_container_move_assignment;
+		using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+		using is_always_equal = typename inner_traits::is_always_equal;
+		template<typename otherType>
+		struct rebind
+		{
+			using other = TelemetryAllocator<otherType, tag, typename inner_traits::template rebind_alloc<otherType>>;
+		};
+#pragma endregion
+#pragma region De/Constructors
+		TelemetryAllocator() = default;
+		TelemetryAllocator(const inner& innerAllocator);
+		template<typename otherType, typename otherInner>
+		TelemetryAllocator(const TelemetryAllocator<otherType, tag, otherInner>& other);
+#pragma endregion
+
+		_NODISCARD type* allocate(size_t count);
+		void deallocate(type* pData, size_t count);
+		_NODISCARD TelemetryAllocator select_on_container_copy_construction() const;
+		_NODISCARD const inner& GetInner() const;
+
+		// Called by Vector
+		void OnReallocate(size_t size, size_t oldCapacity, size_t newCapacity);
+		void OnDestroy(size_t size, size_t capacity);
+
+		template<typename otherType, typename otherInner>
+		bool operator==(const TelemetryAllocator<otherType, tag, otherInner>& rhs) const;
+		template<typename otherType, typename otherInner>
+		bool operator!=(const TelemetryAllocator<otherType, tag, otherInner>& rhs) const;
+
+	private:
+		inner m_Inner;
+	};
+#else
+	// compiled out: the containers get exactly the allocator they would have had without telemetry
+	template<typename type, typename tag = DefaultTelemetryTag, typename inner = std::allocator<type>>
+	using TelemetryAllocator = typename std::allocator_traits<inner>::template rebind_alloc<type>;
+#endif
+
+#pragma region Telemetry
+	namespace Telemetry
+	{
+		inline void ThreadCounters::Add(std::atomic<uint64_t>& counter, uint64_t amount)
+		{
+			// single writer, so load and store are enough and cheaper than a locked add
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		inline void ThreadCounters::Allocated(size_t bytes)
+		{
+			Add(m_Allocations, 1);
+			Add(m_AllocatedBytes, bytes);
+			// memory freed here but allocated on another thread can make this thread's own balance negative
+			const int64_t live = static_cast<int64_t>(m_AllocatedBytes.load(std::memory_order_relaxed) - m_DeallocatedBytes.load(std::memory_order_relaxed));
+			if (live > 0 && static_cast<uint64_t>(live) > m_PeakLiveBytes.load(std::memory_order_relaxed))
+			{
+				m_PeakLiveBytes.store(static_cast<uint64_t>(live), std::memory_order_relaxed);
+			}
+		}
+
+		inline void ThreadCounters::Deallocated(size_t bytes)
+		{
+			Add(m_Deallocations, 1);
+			Add(m_DeallocatedBytes, bytes);
+		}
+
+		inline void ThreadCounters::Reallocated(size_t movedBytes, size_t newBytes)
+		{
+			Add(m_Reallocations, 1);
+			Add(m_ReallocatedBytes, movedBytes);
+			const uint32_t bucket = newBytes == 0 ? 0 : static_cast<uint32_t>(std::bit_width(newBytes) - 1);
+			Add(m_Histogram[bucket < HistogramBuckets ? bucket : HistogramBuckets - 1], 1);
+		}
+
+		inline void ThreadCounters::Destroyed(size_t slackBytes)
+		{
+			Add(m_DestroyedContainers, 1);
+			Add(m_SlackBytes, slackBytes);
+		}
+
+		inline void ThreadCounters::AddTo(Stats& stats) const
+		{
+			stats.allocations += m_Allocations.load(std::memory_order_relaxed);
+			stats.deallocations += m_Deallocations.load(std::memory_order_relaxed);
+			stats.allocatedBytes += m_AllocatedBytes.load(std::memory_order_relaxed);
+			stats.deallocatedBytes += m_DeallocatedBytes.load(std::memory_order_relaxed);
+			stats.peakLiveBytes += m_PeakLiveBytes.load(std::memory_order_relaxed);
+			stats.reallocations += m_Reallocations.load(std::memory_order_relaxed);
+			stats.reallocatedBytes += m_ReallocatedBytes.load(std::memory_order_relaxed);
+			for (uint32_t i{}; i < HistogramBuckets; ++i)
+			{
+				stats.reallocationHistogram[i] += m_Histogram[i].load(std::memory_order_relaxed);
+			}
+			stats.destroyedContainers += m_DestroyedContainers.load(std::memory_order_relaxed);
+			stats.slackBytes += m_SlackBytes.load(std::memory_order_relaxed);
+		}
+
+		inline TagRegistry::TagRegistry(const char* pName)
+			: m_pName{ pName }
+			, m_Mutex{}
+			, m_Counters{}
+		{
+		}
+
+		inline ThreadCounters& TagRegistry::Register()
+		{
+			std::lock_guard lock{ m_Mutex };
+			m_Counters.push_back(std::make_unique<ThreadCounters>());
+			return *m_Counters.back();
+		}
+
+		inline Stats TagRegistry::Collect() const
+		{
+			Stats stats{};
+			stats.pName = m_pName;
+			std::lock_guard lock{ m_Mutex };
+			for (const std::unique_ptr<ThreadCounters>& pCounters : m_Counters)
+			{
+				pCounters->AddTo(stats);
+			}
+			stats.liveBytes = static_cast<int64_t>(stats.allocatedBytes - stats.deallocatedBytes);
+			return stats;
+		}
+
+		template<typename tag>
+		inline const char* TagName()
+		{
+			if constexpr (requires { { tag::Name } -> std::convertible_to<const char*>; })
+			{
+				return tag::Name;
+			}
+			else
+			{
+				return typeid(tag).name();
+			}
+		}
+
+		template<typename tag>
+		inline TagRegistry& Registry()
+		{
+			static TagRegistry* pRegistry = []()
+				{
+					TagRegistry* pNew = new TagRegistry{ TagName<tag>() };
+					std::lock_guard lock{ AllRegistriesMutex() };
+					AllRegistries().push_back(pNew);
+					return pNew;
+				}();
+			return *pRegistry;
+		}
+
+		template<typename tag>
+		inline ThreadCounters& Local()
+		{
+			thread_local ThreadCounters& counters = Registry<tag>().Register();
+			return counters;
+		}
+
+		inline std::vector<TagRegistry*>& AllRegistries()
+		{
+			static std::vector<TagRegistry*>* pRegistries = new std::vector<TagRegistry*>{};
+			return *pRegistries;
+		}
+
+		inline std::mutex& AllRegistriesMutex()
+		{
+			static std::mutex* pMutex = new std::mutex{};
+			return *pMutex;
+		}
+
+		template<typename tag>
+		inline Stats Collect()
+		{
+#if CONTAINER_TELEMETRY
+			return Registry<tag>().Collect();
+#else
+			Stats stats{};
+			stats.pName = TagName<tag>();
+			return stats;
+#endif
+		}
+
+		inline void Report(std::ostream& out)
+		{
+#if CONTAINER_TELEMETRY
+			std::lock_guard lock{ AllRegistriesMutex() };
+			for (const TagRegistry* pRegistry : AllRegistries())
+			{
+				const Stats stats = pRegistry->Collect();
+				out << stats.pName << "\n";
+				out << "\tallocations: " << stats.allocations << " (" << stats.allocatedBytes << " bytes)"
+					<< "\tdeallocations: " << stats.deallocations << " (" << stats.deallocatedBytes << " bytes)\n";
+				out << "\tlive bytes: " << stats.liveBytes << "\tpeak live bytes: " << stats.peakLiveBytes << "\n";
+				out << "\treallocations: " << stats.reallocations << " (" << stats.reallocatedBytes << " bytes moved)\n";
+				out << "\tdestroyed containers: " << stats.destroyedContainers << "\tslack at destruction: " << stats.slackBytes << " bytes\n";
+				for (uint32_t i{}; i < HistogramBuckets; ++i)
+				{
+					if (stats.reallocationHistogram[i] > 0)
+					{
+						out << "\t\t[" << (uint64_t{ 1 } << i) << ", " << (uint64_t{ 2 } << i) << ") bytes: " << stats.reallocationHistogram[i] << "\n";
+					}
+				}
+			}
+#else
+			out << "Telemetry is compiled out, define CONTAINER_TELEMETRY as 1 to record it\n";
+#endif
+		}
+	}
+#pragma endregion
+
+#if CONTAINER_TELEMETRY
+#pragma region TelemetryAllocator
+	template<typename type, typename tag, typename inner>
+	inline TelemetryAllocator<type, tag, inner>::TelemetryAllocator(const inner& innerAllocator)
+		: m_Inner{ innerAllocator }
+	{
+	}
+
+	template<typename type, typename tag, typename inner>
+	template<typename otherType, typename otherInner>
+	inline TelemetryAllocator<type, tag, inner>::TelemetryAllocator(const TelemetryAllocator<otherType, tag, otherInner>& other)
+		: m_Inner{ other.GetInner() }
+	{
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline type* TelemetryAllocator<type, tag, inner>::allocate(size_t count)
+	{
+		Telemetry::Local<tag>().Allocated(count * sizeof(type));
+		return inner_traits::allocate(m_Inner, count);
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline void TelemetryAllocator<type, tag, inner>::deallocate(type* pData, size_t count)
+	{
+		Telemetry::Local<tag>().Deallocated(count * sizeof(type));
+		inner_traits::deallocate(m_Inner, pData, count);
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline TelemetryAllocator<type, tag, inner> TelemetryAllocator<type, tag, inner>::select_on_container_copy_construction() const
+	{
+		return TelemetryAllocator{ inner_traits::select_on_container_copy_construction(m_Inner) };
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline const inner& TelemetryAllocator<type, tag, inner>::GetInner() const
+	{
+		return m_Inner;
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline void TelemetryAllocator<type, tag, inner>::OnReallocate(size_t size, size_t, size_t newCapacity)
+	{
+		Telemetry::Local<tag>().Reallocated(size * sizeof(type), newCapacity * sizeof(type));
+	}
+
+	template<typename type, typename tag, typename inner>
+	inline void TelemetryAllocator<type, tag, inner>::OnDestroy(size_t size, size_t capacity)
+	{
+		Telemetry::Local<tag>().Destroyed((capacity - size) * sizeof(type));
+	}
+
+	template<typename type, typename tag, typename inner>
+	template<typename otherType, typename otherInner>
+	inline bool TelemetryAllocator<type, tag, inner>::operator==(const TelemetryAllocator<otherType, tag, otherInner>& rhs) const
+	{
+		return m_Inner == rhs.GetInner();
+	}
+
+	template<typename type, typename tag, typename inner>
+	template<typename otherType, typename otherInner>
+	inline bool TelemetryAllocator<type, tag, inner>::operator!=(const TelemetryAllocator<otherType, tag, otherInner>& rhs) const
+	{
+		return !(m_Inner == rhs.GetInner());
+	}
+#pragma endregion
+#endif
+}
@@ -0,0 +1,868 @@
+#pragma once
+#include "Platform.h"
+#include "Hash.h"
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <functional>
+#include <utility>
+
+namespace Container
+{
+	// Swiss table style open addressing: every slot has a control byte in a separate array
+	// A full slot stores the low 7 bits of its hash in the control byte, so a probe compares 16 control bytes
+	// with one SSE2 instruction and only touches the slots whose 7 bit tag matched
+	namespace SwissTable
+	{
+		using ctrl = int8_t;
+		static constexpr ctrl Empty = -128; // 0b10000000
+		static constexpr ctrl Deleted = -2; // 0b11111110
+		static constexpr uint32_t GroupWidth = 16;
+
+		// The 16 control bytes starting at some position, matches are returned as a bitmask with one bit per byte
+		class Group final
+		{
+		public:
+			explicit Group(const ctrl* pCtrl);
+			_NODISCARD uint32_t Match(ctrl tag) const;
+			_NODISCARD uint32_t MatchEmpty() const;
+			_NODISCARD uint32_t MatchEmptyOrDeleted() const;
+		private:
+#if CONTAINER_SSE2
+			__m128i m_Ctrl;
+#else
+			ctrl m_Ctrl[GroupWidth];
+#endif
+		};
+
+		// lookups on a table without memory use this, it never matches and always reports an empty slot
+		alignas(GroupWidth) inline constexpr ctrl EmptyGroup[GroupWidth]{ Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+			Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty };
+	}
+
+	template<typename slotType>
+	class SwissTableIterator final
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		SwissTableIterator(const SwissTable::ctrl* pCtrl, slotType* pSlot, const SwissTable::ctrl* pCtrlEnd);
+
+		_NODISCARD slotType& operator*() const;
+		_NODISCARD slotType* operator->() const;
+		SwissTableIterator& operator++();
+		SwissTableIterator operator++(int);
+		bool operator==(const SwissTableIterator& rhs) const;
+		bool operator!=(const SwissTableIterator& rhs) const;
+
+	private:
+		void SkipFree();
+
+		const SwissTable::ctrl* m_pCtrl;
+		slotType* m_pSlot;
+		const SwissTable::ctrl* m_pCtrlEnd;
+	};
+
+	template<typename key, typename value, typename hash = std::hash<key>, typename keyEqual = std::equal_to<key>,
+		typename allocator = std::allocator<std::pair<key, value>>>
+	class UnorderedMap final
+	{
+	public:
+#pragma region member types
+		// the key isn't const so rehashing can move it, changing it through an iterator breaks the map
+		using value_type = std::pair<key, value>;
+		using iterator = SwissTableIterator<value_type>;
+		using const_iterator = SwissTableIterator<const value_type>;
+#pragma endregion
+#pragma region Iterator Functions
+		_NODISCARD iterator Begin();
+		_NODISCARD iterator End();
+		_NODISCARD const_iterator CBegin() const;
+		_NODISCARD const_iterator CEnd() const;
+#pragma endregion
+#pragma region De/Constructors
+		UnorderedMap();
+		explicit UnorderedMap(const allocator& alloc);
+		explicit UnorderedMap(uint32_t expectedSize, const allocator& alloc = allocator{});
+		UnorderedMap(const UnorderedMap& other);
+		UnorderedMap(UnorderedMap&& other) noexcept;
+		UnorderedMap& operator=(const UnorderedMap& other);
+		// Only takes over the table of other when the allocator propagates or both are equal, otherwise moves the elements one by one
+		UnorderedMap& operator=(UnorderedMap&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+			|| std::allocator_traits<allocator>::is_always_equal::value);
+		~UnorderedMap();
+#pragma endregion
+#pragma region Accessors
+		_NODISCARD value& At(const key& k);
+		_NODISCARD const value& At(const key& k) const;
+		// The reference dangles as soon as an insert grows the map, so map[b] = map[a] can read freed slots when b is new.
+		// TryEmplace(b, map.At(a)) is safe, it copies the value before growing
+		value& operator[](const key& k);
+#pragma endregion
+#pragma region Capacity
+		_NODISCARD bool Empty() const;
+		_NODISCARD uint32_t Size() const;
+		// amount of slots, not all of them can be filled before the map grows
+		_NODISCARD uint32_t Capacity() const;
+		_NODISCARD float LoadFactor() const;
+		_NODISCARD float MaxLoadFactor() const;
+		// clamped to [0.25, 0.9375], a completely full table would make misses probe forever
+		void MaxLoadFactor(float maxLoadFactor);
+		// Makes room for count elements without growing
+		void Reserve(uint32_t count);
+		void Rehash(uint32_t slotCount);
+#pragma endregion
+#pragma region Lookup
+		_NODISCARD iterator Find(const key& k);
+		_NODISCARD const_iterator Find(const key& k) const;
+		_NODISCARD bool Contains(const key& k) const;
+#pragma endregion
+#pragma region Modifiers
+		void Clear();
+		std::pair<iterator, bool> Insert(const value_type& pair);
+		std::pair<iterator, bool> Insert(value_type&& pair);
+		// Only constructs the value from args when k is missing
+		template<class... ARGS>
+		std::pair<iterator, bool> TryEmplace(const key& k, ARGS&&... args);
+		bool Erase(const key& k);
+		void Erase(iterator pos);
+		void Erase(const_iterator pos);
+		// Only swaps the allocators when they propagate on swap, otherwise they have to be equal like with the std containers
+		void Swap(UnorderedMap& other) noexcept;
+#pragma endregion
+
+	private:
+		using slotAllocator = typename std::allocator_traits<allocator>::template rebind_alloc<value_type>;
+		using slotTraits = std::allocator_traits<slotAllocator>;
+		using ctrlAllocator = typename std::allocator_traits<allocator>::template rebind_alloc<SwissTable::ctrl>;
+		using ctrlTraits = std::allocator_traits<ctrlAllocator>;
+
+		static constexpr uint32_t NotFound = UINT32_MAX;
+		static constexpr uint32_t m_MinCapacity = SwissTable::GroupWidth;
+
+		uint64_t HashKey(const key& k) const;
+		static SwissTable::ctrl Tag(uint64_t hashValue);
+		uint32_t FindIndex(const key& k, uint64_t hashValue) const;
+		uint32_t FindFreeIndex(uint64_t hashValue) const;
+		template<class... ARGS>
+		uint32_t InsertNew(uint64_t hashValue, ARGS&&... args);
+		void EraseAt(uint32_t idx);
+		void SetCtrl(uint32_t idx, SwissTable::ctrl ctrlValue);
+		void Resize(uint32_t newCapacity);
+		void Deallocate();
+		void CopyFrom(const UnorderedMap& other);
+		bool AllocatorEquals(const UnorderedMap& other) const;
+		// moves the elements of other into slots from our own allocator, for when we can't take over its table
+		void MoveElementsFrom(UnorderedMap& other);
+		// swaps everything but the allocators
+		void SwapTables(UnorderedMap& other) noexcept;
+		uint32_t GrowthLimit(uint32_t capacity) const;
+		static uint32_t CapacityFor(uint32_t count, float maxLoadFactor);
+
+		SwissTable::ctrl* m_pCtrl;
+		value_type* m_pSlots;
+		uint32_t m_Size;
+		uint32_t m_Capacity;
+		uint32_t m_GrowthLeft; // inserts into empty slots left before the next rehash, tombstones don't give growth back
+		float m_MaxLoadFactor;
+		slotAllocator m_Allocator;
+		hash m_Hash;
+		keyEqual m_KeyEqual;
+	};
+
+#pragma region Group
+	inline SwissTable::Group::Group(const ctrl* pCtrl)
+	{
+#if CONTAINER_SSE2
+		m_Ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+#else
+		std::memcpy(m_Ctrl, pCtrl, GroupWidth);
+#endif
+	}
+
+	inline uint32_t SwissTable::Group::Match(ctrl tag) const
+	{
+#if CONTAINER_SSE2
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), m_Ctrl)));
+#else
+		uint32_t mask{};
+		for (uint32_t i{}; i < GroupWidth; ++i)
+		{
+			mask |= static_cast<uint32_t>(m_Ctrl[i] == tag) << i;
+		}
+		return mask;
+#endif
+	}
+
+	inline uint32_t SwissTable::Group::MatchEmpty() const
+	{
+		return Match(Empty);
+	}
+
+	inline uint32_t SwissTable::Group::MatchEmptyOrDeleted() const
+	{
+		// full slots are positive, so empty and deleted are the only bytes below -1
+#if CONTAINER_SSE2
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_Ctrl)));
+#else
+		uint32_t mask{};
+		for (uint32_t i{}; i < GroupWidth; ++i)
+		{
+			mask |= static_cast<uint32_t>(m_Ctrl[i] < -1) << i;
+		}
+		return mask;
+#endif
+	}
+#pragma endregion
+
+#pragma region Iterator
+	template<typename slotType>
+	inline SwissTableIterator<slotType>::SwissTableIterator(const SwissTable::ctrl* pCtrl, slotType* pSlot, const SwissTable::ctrl* pCtrlEnd)
+		: m_pCtrl{ pCtrl }
+		, m_pSlot{ pSlot }
+		, m_pCtrlEnd{ pCtrlEnd }
+	{
+		SkipFree();
+	}
+
+	template<typename slotType>
+	inline slotType& SwissTableIterator<slotType>::operator*() const
+	{
+		return *m_pSlot;
+	}
+
+	template<typename slotType>
+	inline slotType* SwissTableIterator<slotType>::operator->() const
+	{
+		return m_pSlot;
+	}
+
+	template<typename slotType>
+	inline SwissTableIterator<slotType>& SwissTableIterator<slotType>::operator++()
+	{
+		++m_pCtrl;
+		++m_pSlot;
+		SkipFree();
+		return *this;
+	}
+
+	template<typename slotType>
+	inline SwissTableIterator<slotType> SwissTableIterator<slotType>::operator++(int)
+	{
+		SwissTableIterator temp = *this;
+		++(*this);
+		return temp;
+	}
+
+	template<typename slotType>
+	inline bool SwissTableIterator<slotType>::operator==(const SwissTableIterator& rhs) const
+	{
+		return m_pCtrl == rhs.m_pCtrl;
+	}
+
+	template<typename slotType>
+	inline bool SwissTableIterator<slotType>::operator!=(const SwissTableIterator& rhs) const
+	{
+		return m_pCtrl != rhs.m_pCtrl;
+	}
+
+	template<typename slotType>
+	inline void SwissTableIterator<slotType>::SkipFree()
+	{
+		while (m_pCtrl != m_pCtrlEnd && *m_pCtrl < 0)
+		{
+			++m_pCtrl;
+			++m_pSlot;
+		}
+	}
+#pragma endregion
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::UnorderedMap()
+		: UnorderedMap(allocator{})
+	{
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::UnorderedMap(const allocator& alloc)
+		: m_pCtrl{ const_cast<SwissTable::ctrl*>(SwissTable::EmptyGroup) }
+		, m_pSlots{ nullptr }
+		, m_Size{ 0 }
+		, m_Capacity{ 0 }
+		, m_GrowthLeft{ 0 }
+		, m_MaxLoadFactor{ 0.875f }
+		, m_Allocator{ alloc }
+		, m_Hash{}
+		, m_KeyEqual{}
+	{
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::UnorderedMap(uint32_t expectedSize, const allocator& alloc)
+		: UnorderedMap(alloc)
+	{
+		Reserve(expectedSize);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::UnorderedMap(const UnorderedMap& other)
+		: UnorderedMap(slotTraits::select_on_container_copy_construction(other.m_Allocator))
+	{
+		m_MaxLoadFactor = other.m_MaxLoadFactor;
+		CopyFrom(other);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::UnorderedMap(UnorderedMap&& other) noexcept
+		: m_pCtrl{ other.m_pCtrl }
+		, m_pSlots{ other.m_pSlots }
+		, m_Size{ other.m_Size }
+		, m_Capacity{ other.m_Capacity }
+		, m_GrowthLeft{ other.m_GrowthLeft }
+		, m_MaxLoadFactor{ other.m_MaxLoadFactor }
+		, m_Allocator{ std::move(other.m_Allocator) }
+		, m_Hash{ std::move(other.m_Hash) }
+		, m_KeyEqual{ std::move(other.m_KeyEqual) }
+	{
+		other.m_pCtrl = const_cast<SwissTable::ctrl*>(SwissTable::EmptyGroup);
+		other.m_pSlots = nullptr;
+		other.m_Size = 0;
+		other.m_Capacity = 0;
+		other.m_GrowthLeft = 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>& UnorderedMap<key, value, hash, keyEqual, allocator>::operator=(const UnorderedMap& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Deallocate();
+		if constexpr (slotTraits::propagate_on_container_copy_assignment::value)
+		{
+			m_Allocator = other.m_Allocator;
+		}
+		m_MaxLoadFactor = other.m_MaxLoadFactor;
+		CopyFrom(other);
+		return *this;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>& UnorderedMap<key, value, hash, keyEqual, allocator>::operator=(UnorderedMap&& other) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value
+		|| std::allocator_traits<allocator>::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		Deallocate();
+		if constexpr (slotTraits::propagate_on_container_move_assignment::value)
+		{
+			m_Allocator = std::move(other.m_Allocator);
+		}
+		else if (!AllocatorEquals(other))
+		{
+			// we keep our allocator, so a table that came from a different one can't be taken over
+			MoveElementsFrom(other);
+			return *this;
+		}
+		SwapTables(other);
+		return *this;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline UnorderedMap<key, value, hash, keyEqual, allocator>::~UnorderedMap()
+	{
+		Deallocate();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator UnorderedMap<key, value, hash, keyEqual, allocator>::Begin()
+	{
+		return iterator{ m_pCtrl, m_pSlots, m_pCtrl + m_Capacity };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator UnorderedMap<key, value, hash, keyEqual, allocator>::End()
+	{
+		return iterator{ m_pCtrl + m_Capacity, m_pSlots + m_Capacity, m_pCtrl + m_Capacity };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::const_iterator UnorderedMap<key, value, hash, keyEqual, allocator>::CBegin() const
+	{
+		return const_iterator{ m_pCtrl, m_pSlots, m_pCtrl + m_Capacity };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::const_iterator UnorderedMap<key, value, hash, keyEqual, allocator>::CEnd() const
+	{
+		return const_iterator{ m_pCtrl + m_Capacity, m_pSlots + m_Capacity, m_pCtrl + m_Capacity };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline value& UnorderedMap<key, value, hash, keyEqual, allocator>::At(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		assert(idx != NotFound);
+		return m_pSlots[idx].second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline const value& UnorderedMap<key, value, hash, keyEqual, allocator>::At(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		assert(idx != NotFound);
+		return m_pSlots[idx].second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline value& UnorderedMap<key, value, hash, keyEqual, allocator>::operator[](const key& k)
+	{
+		return TryEmplace(k).first->second;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool UnorderedMap<key, value, hash, keyEqual, allocator>::Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::Size() const
+	{
+		return m_Size;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline float UnorderedMap<key, value, hash, keyEqual, allocator>::LoadFactor() const
+	{
+		return m_Capacity > 0 ? static_cast<float>(m_Size) / m_Capacity : 0.f;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline float UnorderedMap<key, value, hash, keyEqual, allocator>::MaxLoadFactor() const
+	{
+		return m_MaxLoadFactor;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::MaxLoadFactor(float maxLoadFactor)
+	{
+		m_MaxLoadFactor = maxLoadFactor < 0.25f ? 0.25f : (maxLoadFactor > 0.9375f ? 0.9375f : maxLoadFactor);
+		if (m_Size > GrowthLimit(m_Capacity))
+		{
+			Resize(CapacityFor(m_Size, m_MaxLoadFactor));
+		}
+		else if (m_Capacity > 0)
+		{
+			// tombstones still count against the new limit, a same size rehash clears them and recomputes the growth
+			Resize(m_Capacity);
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Reserve(uint32_t count)
+	{
+		if (count > GrowthLimit(m_Capacity))
+		{
+			Resize(CapacityFor(count, m_MaxLoadFactor));
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Rehash(uint32_t slotCount)
+	{
+		const uint32_t needed = CapacityFor(m_Size, m_MaxLoadFactor);
+		Resize(std::bit_ceil(slotCount > needed ? slotCount : needed));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator UnorderedMap<key, value, hash, keyEqual, allocator>::Find(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		return idx != NotFound ? iterator{ m_pCtrl + idx, m_pSlots + idx, m_pCtrl + m_Capacity } : End();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline typename UnorderedMap<key, value, hash, keyEqual, allocator>::const_iterator UnorderedMap<key, value, hash, keyEqual, allocator>::Find(const key& k) const
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		return idx != NotFound ? const_iterator{ m_pCtrl + idx, m_pSlots + idx, m_pCtrl + m_Capacity } : CEnd();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool UnorderedMap<key, value, hash, keyEqual, allocator>::Contains(const key& k) const
+	{
+		return FindIndex(k, HashKey(k)) != NotFound;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Clear()
+	{
+		if (m_Capacity == 0)
+		{
+			return;
+		}
+
+		if constexpr (!std::is_trivially_destructible<value_type>::value)
+		{
+			for (uint32_t i{}; i < m_Capacity; ++i)
+			{
+				if (m_pCtrl[i] >= 0)
+				{
+					slotTraits::destroy(m_Allocator, m_pSlots + i);
+				}
+			}
+		}
+		std::memset(m_pCtrl, SwissTable::Empty, m_Capacity + SwissTable::GroupWidth);
+		m_Size = 0;
+		m_GrowthLeft = GrowthLimit(m_Capacity);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline std::pair<typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		UnorderedMap<key, value, hash, keyEqual, allocator>::Insert(const value_type& pair)
+	{
+		return TryEmplace(pair.first, pair.second);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline std::pair<typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		UnorderedMap<key, value, hash, keyEqual, allocator>::Insert(value_type&& pair)
+	{
+		const uint64_t hashValue = HashKey(pair.first);
+		uint32_t idx = FindIndex(pair.first, hashValue);
+		const bool inserted = idx == NotFound;
+		if (inserted)
+		{
+			idx = InsertNew(hashValue, std::move(pair));
+		}
+		return { iterator{ m_pCtrl + idx, m_pSlots + idx, m_pCtrl + m_Capacity }, inserted };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<class... ARGS>
+	inline std::pair<typename UnorderedMap<key, value, hash, keyEqual, allocator>::iterator, bool>
+		UnorderedMap<key, value, hash, keyEqual, allocator>::TryEmplace(const key& k, ARGS&&... args)
+	{
+		const uint64_t hashValue = HashKey(k);
+		uint32_t idx = FindIndex(k, hashValue);
+		const bool inserted = idx == NotFound;
+		if (inserted)
+		{
+			idx = InsertNew(hashValue, std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(std::forward<ARGS>(args)...));
+		}
+		return { iterator{ m_pCtrl + idx, m_pSlots + idx, m_pCtrl + m_Capacity }, inserted };
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool UnorderedMap<key, value, hash, keyEqual, allocator>::Erase(const key& k)
+	{
+		const uint32_t idx = FindIndex(k, HashKey(k));
+		if (idx == NotFound)
+		{
+			return false;
+		}
+		EraseAt(idx);
+		return true;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Erase(iterator pos)
+	{
+		EraseAt(static_cast<uint32_t>(&*pos - m_pSlots));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Erase(const_iterator pos)
+	{
+		EraseAt(static_cast<uint32_t>(&*pos - m_pSlots));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Swap(UnorderedMap& other) noexcept
+	{
+		if constexpr (slotTraits::propagate_on_container_swap::value)
+		{
+			std::swap(m_Allocator, other.m_Allocator);
+		}
+		else
+		{
+			// without propagation each table stays with the allocator that has to free it
+			assert(AllocatorEquals(other));
+		}
+		SwapTables(other);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint64_t UnorderedMap<key, value, hash, keyEqual, allocator>::HashKey(const key& k) const
+	{
+		return MixHash(static_cast<uint64_t>(m_Hash(k)));
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline SwissTable::ctrl UnorderedMap<key, value, hash, keyEqual, allocator>::Tag(uint64_t hashValue)
+	{
+		return static_cast<SwissTable::ctrl>(hashValue & 0x7F);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::FindIndex(const key& k, uint64_t hashValue) const
+	{
+		// an empty map has a mask of 0 and probes the shared empty group once
+		const uint32_t mask = m_Capacity > 0 ? m_Capacity - 1 : 0;
+		const SwissTable::ctrl tag = Tag(hashValue);
+		uint32_t pos = static_cast<uint32_t>(hashValue >> 7) & mask;
+		uint32_t step = 0;
+		while (true)
+		{
+			const SwissTable::Group group{ m_pCtrl + pos };
+			for (uint32_t matches = group.Match(tag); matches != 0; matches &= matches - 1)
+			{
+				const uint32_t idx = (pos + static_cast<uint32_t>(std::countr_zero(matches))) & mask;
+				if (m_KeyEqual(m_pSlots[idx].first, k))
+				{
+					return idx;
+				}
+			}
+			// an empty slot means an insert of k would have stopped here, so k can't be further along
+			if (group.MatchEmpty() != 0)
+			{
+				return NotFound;
+			}
+			// triangular probing over groups visits every group once when the capacity is a power of 2
+			step += SwissTable::GroupWidth;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::FindFreeIndex(uint64_t hashValue) const
+	{
+		const uint32_t mask = m_Capacity - 1;
+		uint32_t pos = static_cast<uint32_t>(hashValue >> 7) & mask;
+		uint32_t step = 0;
+		while (true)
+		{
+			const uint32_t free = SwissTable::Group{ m_pCtrl + pos }.MatchEmptyOrDeleted();
+			if (free != 0)
+			{
+				return (pos + static_cast<uint32_t>(std::countr_zero(free))) & mask;
+			}
+			step += SwissTable::GroupWidth;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	template<class... ARGS>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::InsertNew(uint64_t hashValue, ARGS&&... args)
+	{
+		const uint32_t idx = m_Capacity > 0 ? FindFreeIndex(hashValue) : 0;
+		// reusing a tombstone doesn't use up growth, only filling an empty slot does
+		if (m_Capacity == 0 || (m_GrowthLeft == 0 && m_pCtrl[idx] == SwissTable::Empty))
+		{
+			// args might live in the slots the rehash frees, like in TryEmplace(newKey, map.At(oldKey)), so the element gets built first
+			value_type pending = std::make_obj_using_allocator<value_type>(m_Allocator, std::forward<ARGS>(args)...);
+			// when most of the used up growth is tombstones a same size rehash is enough to clean them up
+			const uint32_t deleted = GrowthLimit(m_Capacity) - m_GrowthLeft - m_Size;
+			const bool mostlyTombstones = m_Capacity > 0 && deleted > m_Size / 2;
+			Resize(mostlyTombstones ? m_Capacity : CapacityFor(m_Size + 1, m_MaxLoadFactor));
+			// the rehash left growth, so this doesn't come back here
+			return InsertNew(hashValue, std::move(pending));
+		}
+
+		if (m_pCtrl[idx] == SwissTable::Empty)
+		{
+			--m_GrowthLeft;
+		}
+		slotTraits::construct(m_Allocator, m_pSlots + idx, std::forward<ARGS>(args)...);
+		SetCtrl(idx, Tag(hashValue));
+		++m_Size;
+		return idx;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::EraseAt(uint32_t idx)
+	{
+		slotTraits::destroy(m_Allocator, m_pSlots + idx);
+		--m_Size;
+
+		// If no probe window that contains idx can be full, no lookup ever probed past idx, so the slot can go back to empty
+		// instead of leaving a tombstone: that is the case when the empty slots right before and right after idx are
+		// less than a group apart
+		const uint32_t mask = m_Capacity - 1;
+		const uint32_t emptyAfter = SwissTable::Group{ m_pCtrl + idx }.MatchEmpty();
+		const uint32_t emptyBefore = SwissTable::Group{ m_pCtrl + ((idx - SwissTable::GroupWidth) & mask) }.MatchEmpty();
+		const bool wasNeverFull = emptyAfter != 0 && emptyBefore != 0 &&
+			static_cast<uint32_t>(std::countr_zero(emptyAfter) + std::countl_zero(static_cast<uint16_t>(emptyBefore))) < SwissTable::GroupWidth;
+		if (wasNeverFull)
+		{
+			SetCtrl(idx, SwissTable::Empty);
+			++m_GrowthLeft;
+		}
+		else
+		{
+			SetCtrl(idx, SwissTable::Deleted);
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::SetCtrl(uint32_t idx, SwissTable::ctrl ctrlValue)
+	{
+		m_pCtrl[idx] = ctrlValue;
+		// the first group is mirrored after the last slot so a group load near the end doesn't have to wrap around
+		if (idx < SwissTable::GroupWidth)
+		{
+			m_pCtrl[m_Capacity + idx] = ctrlValue;
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Resize(uint32_t newCapacity)
+	{
+		assert(std::has_single_bit(newCapacity) && newCapacity >= m_MinCapacity);
+		SwissTable::ctrl* pOldCtrl = m_pCtrl;
+		value_type* pOldSlots = m_pSlots;
+		const uint32_t oldCapacity = m_Capacity;
+
+		ctrlAllocator ctrlAlloc{ m_Allocator };
+		m_pCtrl = ctrlTraits::allocate(ctrlAlloc, newCapacity + SwissTable::GroupWidth);
+		std::memset(m_pCtrl, SwissTable::Empty, newCapacity + SwissTable::GroupWidth);
+		m_pSlots = slotTraits::allocate(m_Allocator, newCapacity);
+		m_Capacity = newCapacity;
+		m_GrowthLeft = GrowthLimit(newCapacity) - m_Size;
+
+		for (uint32_t i{}; i < oldCapacity; ++i)
+		{
+			if (pOldCtrl[i] >= 0)
+			{
+				const uint64_t hashValue = HashKey(pOldSlots[i].first);
+				const uint32_t idx = FindFreeIndex(hashValue);
+				slotTraits::construct(m_Allocator, m_pSlots + idx, std::move(pOldSlots[i]));
+				slotTraits::destroy(m_Allocator, pOldSlots + i);
+				SetCtrl(idx, Tag(hashValue));
+			}
+		}
+
+		if (oldCapacity > 0)
+		{
+			ctrlTraits::deallocate(ctrlAlloc, pOldCtrl, oldCapacity + SwissTable::GroupWidth);
+			slotTraits::deallocate(m_Allocator, pOldSlots, oldCapacity);
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::Deallocate()
+	{
+		if (m_Capacity == 0)
+		{
+			return;
+		}
+
+		Clear();
+		ctrlAllocator ctrlAlloc{ m_Allocator };
+		ctrlTraits::deallocate(ctrlAlloc, m_pCtrl, m_Capacity + SwissTable::GroupWidth);
+		slotTraits::deallocate(m_Allocator, m_pSlots, m_Capacity);
+		m_pCtrl = const_cast<SwissTable::ctrl*>(SwissTable::EmptyGroup);
+		m_pSlots = nullptr;
+		m_Size = 0;
+		m_Capacity = 0;
+		m_GrowthLeft = 0;
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::CopyFrom(const UnorderedMap& other)
+	{
+		m_Hash = other.m_Hash;
+		m_KeyEqual = other.m_KeyEqual;
+		if (other.m_Size == 0)
+		{
+			return;
+		}
+
+		Resize(CapacityFor(other.m_Size, m_MaxLoadFactor));
+		for (uint32_t i{}; i < other.m_Capacity; ++i)
+		{
+			if (other.m_pCtrl[i] >= 0)
+			{
+				InsertNew(HashKey(other.m_pSlots[i].first), other.m_pSlots[i]);
+			}
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline bool UnorderedMap<key, value, hash, keyEqual, allocator>::AllocatorEquals(const UnorderedMap& other) const
+	{
+		if constexpr (slotTraits::is_always_equal::value)
+		{
+			return true;
+		}
+		else
+		{
+			return m_Allocator == other.m_Allocator;
+		}
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::MoveElementsFrom(UnorderedMap& other)
+	{
+		assert(m_Size == 0);
+		m_MaxLoadFactor = other.m_MaxLoadFactor;
+		m_Hash = other.m_Hash;
+		m_KeyEqual = other.m_KeyEqual;
+		if (other.m_Size > 0)
+		{
+			Reserve(other.m_Size);
+			for (uint32_t i{}; i < other.m_Capacity; ++i)
+			{
+				if (other.m_pCtrl[i] >= 0)
+				{
+					InsertNew(HashKey(other.m_pSlots[i].first), std::move(other.m_pSlots[i]));
+				}
+			}
+		}
+		other.Deallocate();
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline void UnorderedMap<key, value, hash, keyEqual, allocator>::SwapTables(UnorderedMap& other) noexcept
+	{
+		std::swap(m_pCtrl, other.m_pCtrl);
+		std::swap(m_pSlots, other.m_pSlots);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_GrowthLeft, other.m_GrowthLeft);
+		std::swap(m_MaxLoadFactor, other.m_MaxLoadFactor);
+		std::swap(m_Hash, other.m_Hash);
+		std::swap(m_KeyEqual, other.m_KeyEqual);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::GrowthLimit(uint32_t capacity) const
+	{
+		return static_cast<uint32_t>(capacity * m_MaxLoadFactor);
+	}
+
+	template<typename key, typename value, typename hash, typename keyEqual, typename allocator>
+	inline uint32_t UnorderedMap<key, value, hash, keyEqual, allocator>::CapacityFor(uint32_t count, float maxLoadFactor)
+	{
+		uint32_t capacity = m_MinCapacity;
+		while (static_cast<uint32_t>(capacity * maxLoadFactor) < count)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+}
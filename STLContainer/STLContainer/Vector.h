@@ -1,7 +1,15 @@
 #pragma once
+#include "Algorithm.h"
+#include "Concepts.h"
+#include "MemoryCopy.h"
+#include "VectorHooks.h"
 #include <type_traits>
 #include <memory>
+#include <memory_resource>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <array>
 
 namespace Container
 {
@@ -11,21 +19,21 @@ namespace Container
 	{
 	public:
 		using iterator_category = std::random_access_iterator_tag;
-		virtual ~ConstIterator() = default;
-		ConstIterator(type* pVal);
-
-		_NODISCARD const type& operator*() const;
-		_NODISCARD const type& operator->() const;
-		ConstIterator& operator++();
-		ConstIterator operator++(int);
-		ConstIterator& operator--();
-		ConstIterator operator--(int);
-		ConstIterator& operator+=(int32_t rhs);
-		ConstIterator& operator-=(int32_t rhs);
-		ConstIterator operator+(int32_t rhs);
-		ConstIterator operator-(int32_t rhs);
-		bool operator==(const ConstIterator& rhs) const;
-		bool operator!=(const ConstIterator& rhs) const;
+		constexpr virtual ~ConstIterator() = default;
+		constexpr ConstIterator(type* pVal);
+
+		_NODISCARD constexpr const type& operator*() const;
+		_NODISCARD constexpr const type& operator->() const;
+		constexpr ConstIterator& operator++();
+		constexpr ConstIterator operator++(int);
+		constexpr ConstIterator& operator--();
+		constexpr ConstIterator operator--(int);
+		constexpr ConstIterator& operator+=(int32_t rhs);
+		constexpr ConstIterator& operator-=(int32_t rhs);
+		constexpr ConstIterator operator+(int32_t rhs);
+		constexpr ConstIterator operator-(int32_t rhs);
+		constexpr bool operator==(const ConstIterator& rhs) const;
+		constexpr bool operator!=(const ConstIterator& rhs) const;
 
 		type* m_pValue;
 	};
@@ -37,169 +45,207 @@ namespace Container
 	public:
 		using iterator_category = std::random_access_iterator_tag;
 		Iterator() = delete;
-		Iterator(type* start);
-
-		_NODISCARD type& operator*();
-		_NODISCARD type& operator->();
-		Iterator& operator++();
-		Iterator operator++(int);
-		Iterator& operator--();
-		Iterator operator--(int);
-		Iterator& operator+=(int32_t rhs);
-		Iterator& operator-=(int32_t rhs);
-		Iterator operator+(int32_t rhs);
-		Iterator operator-(int32_t rhs);
-		bool operator==(const Iterator& rhs) const;
-		bool operator!=(const Iterator& rhs) const;
+		constexpr Iterator(type* start);
+		constexpr ~Iterator() override = default;
+
+		_NODISCARD constexpr type& operator*();
+		_NODISCARD constexpr type& operator->();
+		constexpr Iterator& operator++();
+		constexpr Iterator operator++(int);
+		constexpr Iterator& operator--();
+		constexpr Iterator operator--(int);
+		constexpr Iterator& operator+=(int32_t rhs);
+		constexpr Iterator& operator-=(int32_t rhs);
+		constexpr Iterator operator+(int32_t rhs);
+		constexpr Iterator operator-(int32_t rhs);
+		constexpr bool operator==(const Iterator& rhs) const;
+		constexpr bool operator!=(const Iterator& rhs) const;
 	private:
 
 	};
 
 #pragma endregion
 
-	template<typename type, typename allocator = std::allocator<type>>
+	// hooks gets told about reallocations and big shifts, see VectorHooks.h
+	template<typename type, typename allocator = std::allocator<type>, typename hooks = NoHooks>
 	class Vector final
 	{
 	public:
 #pragma region member types
 		using iterator = Iterator<type>;
 		using const_iterator = ConstIterator<type>;
+		using allocator_type = allocator;
 #pragma endregion
 #pragma region Type Requirments
 		static_assert(std::is_copy_assignable<type>::value);
 		static_assert(std::is_copy_constructible<type>::value);
+		static_assert(IsAllocator<allocator, type>);
+		static_assert(IsVectorHooks<hooks>);
 #pragma endregion
 #pragma region Deleted Functions
 #pragma endregion
 #pragma region Iterators
 #pragma region Iterator Functions
-		_NODISCARD iterator Begin();
-		_NODISCARD iterator End();
-		_NODISCARD const_iterator CBegin() const;
-		_NODISCARD const_iterator CEnd() const;
+		_NODISCARD constexpr iterator Begin();
+		_NODISCARD constexpr iterator End();
+		_NODISCARD constexpr const_iterator CBegin() const;
+		_NODISCARD constexpr const_iterator CEnd() const;
 #pragma endregion
 #pragma endregion
 #pragma region De/Constructors
-		Vector();
-		Vector(uint32_t size, const type& type);
-		Vector(uint32_t capacity);
-		Vector(const Vector& other);
-		Vector(Vector&& other);
-		Vector& operator=(const Vector& other);
-		Vector& operator=(Vector&& other);
-		~Vector();
+		constexpr Vector();
+		explicit constexpr Vector(const allocator& alloc);
+		constexpr Vector(uint32_t size, const type& value, const allocator& alloc = allocator{});
+		constexpr Vector(uint32_t capacity, const allocator& alloc = allocator{});
+		// copies get their allocator from select_on_container_copy_construction
+		constexpr Vector(const Vector& other);
+		constexpr Vector(const Vector& other, const allocator& alloc);
+		constexpr Vector(Vector&& other);
+		// only takes over the buffer of other when both allocators are equal, otherwise the elements get moved
+		constexpr Vector(Vector&& other, const allocator& alloc);
+		constexpr Vector& operator=(const Vector& other);
+		constexpr Vector& operator=(Vector&& other);
+		constexpr ~Vector();
 #pragma endregion
 #pragma region Accessors
-		_NODISCARD const type& At(uint32_t pos) const;
-		_NODISCARD type& At(uint32_t pos);
-		_NODISCARD const type& operator[](uint32_t pos) const;
-		_NODISCARD type& operator[](uint32_t pos);
-		_NODISCARD const type& Front() const;
-		_NODISCARD type& Front();
-		_NODISCARD const type& Back() const;
-		_NODISCARD type& Back();
-		_NODISCARD type* Data();
-		_NODISCARD const type* Data() const;
+		_NODISCARD constexpr allocator GetAllocator() const;
+		_NODISCARD constexpr const type& At(uint32_t pos) const;
+		_NODISCARD constexpr type& At(uint32_t pos);
+		_NODISCARD constexpr const type& operator[](uint32_t pos) const;
+		_NODISCARD constexpr type& operator[](uint32_t pos);
+		_NODISCARD constexpr const type& Front() const;
+		_NODISCARD constexpr type& Front();
+		_NODISCARD constexpr const type& Back() const;
+		_NODISCARD constexpr type& Back();
+		_NODISCARD constexpr type* Data();
+		_NODISCARD constexpr const type* Data() const;
 #pragma endregion
 #pragma region Capacity
-		_NODISCARD bool Empty() const;
-		_NODISCARD uint32_t Size() const;
+		_NODISCARD constexpr bool Empty() const;
+		_NODISCARD constexpr uint32_t Size() const;
 		_NODISCARD constexpr uint32_t MaxElements() const;
-		void Reserve(uint32_t newReserve);
-		_NODISCARD uint32_t Capacity() const;
-		void ShrinkToFit();
+		constexpr void Reserve(uint32_t newReserve);
+		_NODISCARD constexpr uint32_t Capacity() const;
+		constexpr void ShrinkToFit();
 #pragma endregion
 #pragma region Modifiers
-		void Clear();
-		iterator Insert(const_iterator pos, const type& value);
-		iterator Insert(const_iterator pos, type&& value);
-		iterator Insert(const_iterator pos, uint32_t count, const type& value);
-		template<class inIt>
-		iterator Insert(const_iterator pos, inIt first, inIt last);
+		constexpr void Clear();
+		constexpr iterator Insert(const_iterator pos, const type& value);
+		constexpr iterator Insert(const_iterator pos, type&& value);
+		constexpr iterator Insert(const_iterator pos, uint32_t count, const type& value);
+		template<class inIt> requires (!std::is_integral<inIt>::value)
+		constexpr iterator Insert(const_iterator pos, inIt first, inIt last);
 		template<class... ARGS>
-		iterator Emplace(const_iterator pos, ARGS&&... arsgs);
-		iterator Erase(const_iterator pos);
-		iterator Erase(const_iterator first, const_iterator last);
-		void PushBack(const type& type);
-		void PushBack(type&& type);
+		constexpr iterator Emplace(const_iterator pos, ARGS&&... arsgs);
+		constexpr iterator Erase(const_iterator pos);
+		constexpr iterator Erase(const_iterator first, const_iterator last);
+		constexpr void PushBack(const type& value);
+		constexpr void PushBack(type&& value);
 		template<class... ARGS>
-		void EmplaceBack(ARGS&&... args);
-		void PopBack();
-		void Resize(uint32_t newSize);
-		void Swap(Vector& other);
+		constexpr void EmplaceBack(ARGS&&... args);
+		constexpr void PopBack();
+		constexpr void Resize(uint32_t newSize);
+		constexpr void Swap(Vector& other);
 #pragma endregion
 
 	private:
-		void Reallocate(uint32_t newCapacity);
-
+		constexpr void Reallocate(uint32_t newCapacity);
+		constexpr uint32_t GrownCapacity() const;
+		// lets the allocator round capacities up, AlignedAllocator uses it to fill whole cache lines
+		static constexpr uint32_t RoundCapacity(uint32_t capacity);
+		constexpr void RelocateElements(type* pDest, type* pSrc, uint32_t count);
+		// constructs count copies of value from pDest on
+		constexpr void ConstructFill(type* pDest, uint32_t count, const type& value);
+		constexpr bool AllocatorEquals(const Vector& other) const;
+		// moves the elements of other into a buffer from our own allocator, for when we can't take over its buffer
+		constexpr void MoveElementsFrom(Vector& other);
+
+		using alloc_traits = std::allocator_traits<allocator>;
 
 		type* m_pData;
 		uint32_t m_Size;
 		uint32_t m_Capacity;
-		allocator m_Allocator = allocator{};
+		allocator m_Allocator;
 
-		static const uint32_t m_DefaultSize = 4;
-		static const uint32_t m_CapacityGrowth = 2;
+		static constexpr uint32_t m_DefaultSize = 4;
+		static constexpr uint32_t m_CapacityGrowth = 2;
 
 		public:
 
 	};
 
+#pragma region Compile-time Helpers
+	// Runs generator during compilation and bakes the Vector it returns into a std::array
+	// Memory allocated during constant evaluation can't leave it, so the generator runs once to get the size and once to copy the values
+	template<typename generator>
+	consteval auto ToArray(generator);
+#pragma endregion
+
 	template<typename type>
-	inline Iterator<type>::Iterator(type* start)
+	constexpr Iterator<type>::Iterator(type* start)
 		: ConstIterator<type>{ start }
 	{
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::Vector()
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector()
+		: Vector(allocator{})
+	{
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(const allocator& alloc)
 		: m_pData{nullptr}
 		, m_Size{0}
-		, m_Capacity{m_DefaultSize}
+		, m_Capacity{RoundCapacity(m_DefaultSize)}
+		, m_Allocator{alloc}
 	{
-		m_pData = m_Allocator.allocate(m_DefaultSize);
+		m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::Vector(uint32_t size, const type& type)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(uint32_t size, const type& value, const allocator& alloc)
 		: m_pData{nullptr}
 		, m_Size{size}
-		, m_Capacity{size}
+		, m_Capacity{RoundCapacity(size)}
+		, m_Allocator{alloc}
 	{
-		m_pData = m_Allocator.allocate(size);
-		m_Capacity = size;
-		m_Size = size;
-		for (uint32_t i{}; i < size; ++i)
-		{
-			m_pData[i] = type;
-		}
+		m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
+		ConstructFill(m_pData, size, value);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::Vector(uint32_t capacity)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(uint32_t capacity, const allocator& alloc)
 		: m_pData { nullptr }
 		, m_Size{ 0 }
-		, m_Capacity{ capacity }
+		, m_Capacity{ RoundCapacity(capacity) }
+		, m_Allocator{ alloc }
+	{
+		m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(const Vector& other)
+		: Vector(other, alloc_traits::select_on_container_copy_construction(other.m_Allocator))
 	{
-		m_pData = m_Allocator.allocate(capacity);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::Vector(const Vector& other)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(const Vector& other, const allocator& alloc)
 		: m_pData{nullptr}
 		, m_Size{other.m_Size}
 		, m_Capacity{other.m_Capacity}
-		, m_Allocator{}
+		, m_Allocator{alloc}
 	{
-		m_pData = m_Allocator.allocate(m_Capacity);
+		m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
 		for (uint32_t i = 0; i < m_Size; ++i)
 		{
-			m_pData[i] = other.m_pData[i];
+			alloc_traits::construct(m_Allocator, m_pData + i, other.m_pData[i]);
 		}
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::Vector(Vector&& other)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(Vector&& other)
 		: m_pData {other.m_pData}
 		, m_Size{other.m_Size}
 		, m_Capacity{other.m_Capacity}
@@ -210,23 +256,76 @@ namespace Container
 		other.m_Capacity = 0;
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>& Vector<type, allocator>::operator=(const Vector& other)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::Vector(Vector&& other, const allocator& alloc)
+		: m_pData{nullptr}
+		, m_Size{0}
+		, m_Capacity{0}
+		, m_Allocator{alloc}
 	{
+		if (AllocatorEquals(other))
+		{
+			std::swap(m_pData, other.m_pData);
+			std::swap(m_Size, other.m_Size);
+			std::swap(m_Capacity, other.m_Capacity);
+			return;
+		}
+
+		// memory from another allocator can't be given back through ours, so the elements move one by one
+		MoveElementsFrom(other);
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>& Vector<type, allocator, hooks>::operator=(const Vector& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
 		Clear();
+		if (m_pData)
+		{
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
 
+		if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+		{
+			m_Allocator = other.m_Allocator;
+		}
 		m_Size = other.m_Size;
 		m_Capacity = other.m_Capacity;
-		m_Allocator = allocator{};
-		m_pData = m_Allocator.allocate(m_Capacity);
-		memcpy(m_pData, other.m_pData, m_Size * sizeof(type));
+		m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
+		for (uint32_t i = 0; i < m_Size; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i, other.m_pData[i]);
+		}
 		return *this;
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>& Vector<type, allocator>::operator=(Vector&& other)
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>& Vector<type, allocator, hooks>::operator=(Vector&& other)
 	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
 		Clear();
+		if constexpr (!alloc_traits::propagate_on_container_move_assignment::value)
+		{
+			// we keep our allocator, so a buffer that came from a different one can't be taken over
+			if (!AllocatorEquals(other))
+			{
+				MoveElementsFrom(other);
+				return *this;
+			}
+		}
+
+		if (m_pData)
+		{
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
 
 		m_Size = other.m_Size;
 		other.m_Size = 0;
@@ -234,127 +333,148 @@ namespace Container
 		other.m_Capacity = 0;
 		m_pData = other.m_pData;
 		other.m_pData = nullptr;
-		m_Allocator = static_cast<allocator&&>(other.m_Allocator);
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+		{
+			m_Allocator = static_cast<allocator&&>(other.m_Allocator);
+		}
 		return *this;
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::~Vector()
+	template<typename type, typename allocator, typename hooks>
+	constexpr Vector<type, allocator, hooks>::~Vector()
 	{
+		// lets instrumenting allocators like TelemetryAllocator see how much capacity was never used
+		if constexpr (requires(allocator& alloc, size_t count) { alloc.OnDestroy(count, count); })
+		{
+			if (!std::is_constant_evaluated() && m_pData)
+			{
+				m_Allocator.OnDestroy(m_Size, m_Capacity);
+			}
+		}
+
 		Clear();
-		m_Allocator.deallocate(m_pData, m_Capacity);
+		if (m_pData) // moved from vectors don't own any memory
+		{
+			alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+		}
 	}
 
-	template<typename type, typename allocator>
-	inline const type& Vector<type, allocator>::At(uint32_t pos) const
+	template<typename type, typename allocator, typename hooks>
+	constexpr allocator Vector<type, allocator, hooks>::GetAllocator() const
+	{
+		return m_Allocator;
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr const type& Vector<type, allocator, hooks>::At(uint32_t pos) const
 	{
 		assert(m_Size > pos);
 		return m_pData[pos];
 	}
-	template<typename type, typename allocator>
-	inline type& Vector<type, allocator>::At(uint32_t pos)
+	template<typename type, typename allocator, typename hooks>
+	constexpr type& Vector<type, allocator, hooks>::At(uint32_t pos)
 	{
 		assert(m_Size > pos);
 		return m_pData[pos];
 	}
-	template<typename type, typename allocator>
-	inline const type& Vector<type, allocator>::operator[](uint32_t pos) const
+	template<typename type, typename allocator, typename hooks>
+	constexpr const type& Vector<type, allocator, hooks>::operator[](uint32_t pos) const
 	{
 		return m_pData[pos];
 	}
 
-	template<typename type, typename allocator>
-	inline type& Vector<type, allocator>::operator[](uint32_t pos)
+	template<typename type, typename allocator, typename hooks>
+	constexpr type& Vector<type, allocator, hooks>::operator[](uint32_t pos)
 	{
 		return m_pData[pos];
 	}
 
-	template<typename type, typename allocator>
-	inline const type& Vector<type, allocator>::Front() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr const type& Vector<type, allocator, hooks>::Front() const
 	{
 		assert(m_Size > 0);
 		return m_pData[0];
 	}
 
-	template<typename type, typename allocator>
-	inline type& Vector<type, allocator>::Front()
+	template<typename type, typename allocator, typename hooks>
+	constexpr type& Vector<type, allocator, hooks>::Front()
 	{
 		assert(m_Size > 0);
 		return m_pData[0];
 	}
 
-	template<typename type, typename allocator>
-	inline const type& Vector<type, allocator>::Back() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr const type& Vector<type, allocator, hooks>::Back() const
 	{
 		assert(m_Size > 0);
 		return m_pData[m_Size - 1];
 	}
 
-	template<typename type, typename allocator>
-	inline type& Vector<type, allocator>::Back()
+	template<typename type, typename allocator, typename hooks>
+	constexpr type& Vector<type, allocator, hooks>::Back()
 	{
 		assert(m_Size > 0);
 		return m_pData[m_Size - 1];
 	}
 
-	template<typename type, typename allocator>
-	inline type* Vector<type, allocator>::Data()
+	template<typename type, typename allocator, typename hooks>
+	constexpr type* Vector<type, allocator, hooks>::Data()
 	{
 		return m_pData;
 	}
 
-	template<typename type, typename allocator>
-	inline const type* Vector<type, allocator>::Data() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr const type* Vector<type, allocator, hooks>::Data() const
 	{
 		return m_pData;
 	}
 
-	template<typename type, typename allocator>
-	inline typename Vector<type, allocator>::iterator Vector<type, allocator>::Begin()
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Begin()
 	{
-		return Vector<type, allocator>::iterator{m_pData};
+		return Vector<type, allocator, hooks>::iterator{m_pData};
 	}
 
-	template<typename type, typename allocator>
-	inline typename Vector<type, allocator>::iterator Vector<type, allocator>::End()
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::End()
 	{
-		return Vector<type, allocator>::iterator{m_pData + m_Size};
+		return Vector<type, allocator, hooks>::iterator{m_pData + m_Size};
 	}
 
-	template<typename type, typename allocator>
-	inline typename Vector<type, allocator>::const_iterator Vector<type, allocator>::CBegin() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::const_iterator Vector<type, allocator, hooks>::CBegin() const
 	{
 		return const_iterator(m_pData);
 	}
 
-	template<typename type, typename allocator>
-	inline typename Vector<type, allocator>::const_iterator Vector<type, allocator>::CEnd() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::const_iterator Vector<type, allocator, hooks>::CEnd() const
 	{
 		return const_iterator(m_pData + m_Size);
 	}
 
-	template<typename type, typename allocator>
-	inline bool Vector<type, allocator>::Empty() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr bool Vector<type, allocator, hooks>::Empty() const
 	{
-		return m_Size > 0;
+		return m_Size == 0;
 	}
 
-	template<typename type, typename allocator>
-	inline uint32_t Vector<type, allocator>::Size() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr uint32_t Vector<type, allocator, hooks>::Size() const
 	{
 		return m_Size;
 	}
 
-	template<typename type, typename allocator>
-	inline constexpr uint32_t Vector<type, allocator>::MaxElements() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr uint32_t Vector<type, allocator, hooks>::MaxElements() const
 	{
 		return UINT32_MAX;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::Reserve(uint32_t newCapacity)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::Reserve(uint32_t newCapacity)
 	{
-		if (m_Capacity > newCapacity)
+		if (m_Capacity >= newCapacity)
 		{
 			return;
 		}
@@ -362,291 +482,488 @@ namespace Container
 		Reallocate(newCapacity);
 	}
 
-	template<typename type, typename allocator>
-	inline uint32_t Vector<type, allocator>::Capacity() const
+	template<typename type, typename allocator, typename hooks>
+	constexpr uint32_t Vector<type, allocator, hooks>::Capacity() const
 	{
 		return m_Capacity;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::ShrinkToFit()
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::ShrinkToFit()
 	{
 		Reallocate(m_Size);
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::Clear()
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::Clear()
 	{
 		if constexpr (!std::is_trivially_destructible<type>::value)
 		{
 			for (uint32_t i{}; i < m_Size; ++i)
 			{
-				m_pData[i].~type();
+				alloc_traits::destroy(m_Allocator, m_pData + i);
 			}
 		}
 		m_Size = 0;
 	}
 
-	template<typename type, typename allocator>
-	inline typename Vector<type, allocator>::iterator Vector<type, allocator>::Insert(const_iterator pos, const type& value)
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Insert(const_iterator pos, const type& value)
 	{
 		return Emplace(pos, value);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::iterator Vector<type, allocator>::Insert(const_iterator pos, type&& value)
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Insert(const_iterator pos, type&& value)
 	{
-		return Emplace(pos, value);
+		return Emplace(pos, std::move(value));
 	}
 
-	template<typename type, typename allocator>
+	template<typename type, typename allocator, typename hooks>
 	template<class ...ARGS>
-	inline void Vector<type, allocator>::EmplaceBack(ARGS && ...args)
+	constexpr void Vector<type, allocator, hooks>::EmplaceBack(ARGS && ...args)
 	{
-		Emplace(CEnd(), args...);
+		Emplace(CEnd(), std::forward<ARGS>(args)...);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::iterator Vector<type, allocator>::Insert(const_iterator pos, uint32_t count, const type& value)
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Insert(const_iterator pos, uint32_t count, const type& value)
 	{
 		if (count == 0)
 		{
-			return pos;
+			return iterator(pos.m_pValue);
 		}
 
 		type* location = pos.m_pValue;
 		assert(location >= m_pData && location <= m_pData + m_Size);
-		uint32_t distanceToStart = location - m_pData;
+		uint32_t distanceToStart = static_cast<uint32_t>(location - m_pData);
 		uint32_t distanceToEnd = m_Size - distanceToStart;
-		m_Size += count;
 
-		if (m_Size > m_Capacity)
+		if (m_Size + count > m_Capacity)
 		{
-			Reserve(m_Size + count);
+			Reallocate(m_Size + count);
 		}
 
-		std::move(m_pData + distanceToStart + count, m_pData + distanceToStart, distanceToEnd * sizeof(type));
+		RelocateElements(m_pData + distanceToStart + count, m_pData + distanceToStart, distanceToEnd);
 
-		for (int i{}; i < count; ++i)
-		{
-			m_pData[distanceToStart + i] = value;
-		}
+		ConstructFill(m_pData + distanceToStart, count, value);
+		m_Size += count;
 
 		return iterator(m_pData + distanceToStart);
 	}
 
-	template<typename type, typename allocator>
-	template<class inIt>
-	inline Vector<type, allocator>::iterator
- Vector<type, allocator>::Insert(const_iterator pos, inIt first, inIt last)
+	template<typename type, typename allocator, typename hooks>
+	template<class inIt> requires (!std::is_integral<inIt>::value)
+	constexpr typename Vector<type, allocator, hooks>::iterator
+ Vector<type, allocator, hooks>::Insert(const_iterator pos, inIt first, inIt last)
 	{
 		if (first == last)
 		{
-			return pos;
+			return iterator(pos.m_pValue);
 		}
 
 		type* location = pos.m_pValue;
 		assert(location >= m_pData && location <= m_pData + m_Size);
-		uint32_t distanceToStart = location - m_pData;
+		uint32_t distanceToStart = static_cast<uint32_t>(location - m_pData);
 		uint32_t distanceToEnd = m_Size - distanceToStart;
-		auto distance = std::distance(first, last);
-		m_Size += distance;
+		uint32_t distance = static_cast<uint32_t>(std::distance(first, last));
 
-		if (m_Size > m_Capacity)
+		if (m_Size + distance > m_Capacity)
 		{
-			Reserve(m_Size + distance);
+			Reallocate(m_Size + distance);
 		}
 
-		std::memmove(m_pData + distanceToStart + distance, m_pData + distanceToStart, distanceToEnd * sizeof(type));
+		RelocateElements(m_pData + distanceToStart + distance, m_pData + distanceToStart, distanceToEnd);
 
 		for (uint32_t i = 0; i < distance; ++i)
 		{
-			m_pData[distanceToStart + i] = first;
+			alloc_traits::construct(m_Allocator, m_pData + distanceToStart + i, *first);
 			++first;
 		}
+		m_Size += distance;
 
 		return iterator(m_pData + distanceToStart);
 	}
 
-	template<typename type, typename allocator>
+	template<typename type, typename allocator, typename hooks>
 	template<class... ARGS>
-	inline typename Vector<type, allocator>::iterator Vector<type, allocator>::Emplace(const_iterator pos, ARGS&&... args)
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Emplace(const_iterator pos, ARGS&&... args)
 	{
 		type* location = pos.m_pValue;
 		assert(location >= m_pData && location <= m_pData + m_Size);
-		uint32_t distanceToStart = location - m_pData;
+		uint32_t distanceToStart = static_cast<uint32_t>(location - m_pData);
 		uint32_t distanceToEnd = m_Size - distanceToStart;
-		++m_Size;
+		// args might point into this vector so we build the value before we move anything
+		// it's built with our allocator, so nested containers can hand their buffer over instead of copying it
+		type value = std::make_obj_using_allocator<type>(m_Allocator, std::forward<ARGS>(args)...);
 		if (m_Size == m_Capacity)
 		{
-			Reallocate(m_Capacity * m_CapacityGrowth); // this invalidates the iterator, this is why we use distances instead of the actual allocator to emplace
+			Reallocate(GrownCapacity()); // this invalidates the iterator, this is why we use distances instead of the actual allocator to emplace
 		}
 
-		std::memmove(m_pData + distanceToStart + 1, m_pData + distanceToStart, distanceToEnd * sizeof(type)); // memmove because the src and dest will overlap
-		m_pData[distanceToStart] = type(args...);
+		RelocateElements(m_pData + distanceToStart + 1, m_pData + distanceToStart, distanceToEnd);
+		alloc_traits::construct(m_Allocator, m_pData + distanceToStart, std::move(value));
+		++m_Size;
 		return iterator(m_pData + distanceToStart);
 	}
 
-	template<typename type, typename allocator>
-	inline Vector<type, allocator>::iterator Vector<type, allocator>::Erase(const_iterator pos)
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Erase(const_iterator pos)
 	{
 		type* location = pos.m_pValue;
 
-		assert(location >= m_pData && location <= m_pData + m_Size);
-		uint32_t distanceToStart = location - m_pData;
-		uint32_t distanceToEnd = m_Size - distanceToStart;
+		assert(location >= m_pData && location < m_pData + m_Size);
+		uint32_t distanceToStart = static_cast<uint32_t>(location - m_pData);
+		uint32_t distanceToEnd = m_Size - distanceToStart - 1;
 		if constexpr (!std::is_trivially_destructible<type>::value)
 		{
-			location->~type();
+			alloc_traits::destroy(m_Allocator, location);
 		}
 
-		std::memmove(m_pData + distanceToStart, m_pData + distanceToStart + 1, distanceToEnd * sizeof(type));
+		RelocateElements(m_pData + distanceToStart, m_pData + distanceToStart + 1, distanceToEnd);
 		--m_Size;
 
 		return iterator(pos.m_pValue);
 	}
 
-	template<typename type, typename allocator>
-	Vector<type, allocator>::iterator Vector<type, allocator>::Erase(const_iterator first, const_iterator last)
+	template<typename type, typename allocator, typename hooks>
+	constexpr typename Vector<type, allocator, hooks>::iterator Vector<type, allocator, hooks>::Erase(const_iterator first, const_iterator last)
 	{
 		type* firstLoc = first.m_pValue;
 		type* lastLoc = last.m_pValue;
 
-		uint32_t distanceToFirst = firstLoc - m_pData;
-		uint32_t distanceToLast = lastLoc - m_pData;
+		uint32_t distanceToFirst = static_cast<uint32_t>(firstLoc - m_pData);
+		uint32_t distanceToLast = static_cast<uint32_t>(lastLoc - m_pData);
 		uint32_t eraseCount = distanceToLast - distanceToFirst;
-		uint32_t sizeToMove = (m_Size - distanceToLast) * sizeof(type);
+		uint32_t countToMove = m_Size - distanceToLast;
 
 		if constexpr (!std::is_trivially_destructible<type>::value)
 		{
-			for (const_iterator it{first}; it != last; ++it)
+			for (type* pErase{ firstLoc }; pErase != lastLoc; ++pErase)
 			{
-				it->~type();
+				alloc_traits::destroy(m_Allocator, pErase);
 			}
 		}
 
 		m_Size -= eraseCount;
-		// memmove because locations might overlap
-		std::memmove(firstLoc, lastLoc, sizeToMove);
+		RelocateElements(firstLoc, lastLoc, countToMove);
 		return iterator{ firstLoc };
 	}
 
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::PushBack(const type& type)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::PushBack(const type& value)
 	{
 		if (m_Size == m_Capacity)
 		{
-			Reallocate(m_Capacity * m_CapacityGrowth);
+			type copy = std::make_obj_using_allocator<type>(m_Allocator, value); // value might live in the buffer we are about to free
+			Reallocate(GrownCapacity());
+			alloc_traits::construct(m_Allocator, m_pData + m_Size, std::move(copy));
+		}
+		else
+		{
+			alloc_traits::construct(m_Allocator, m_pData + m_Size, value);
 		}
-
-		m_pData[m_Size] = type;
 		++m_Size;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::PushBack(type&& type)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::PushBack(type&& value)
 	{
 		if (m_Size == m_Capacity)
 		{
-			Reallocate(m_Capacity * m_CapacityGrowth);
+			type moved = std::make_obj_using_allocator<type>(m_Allocator, std::move(value)); // value might live in the buffer we are about to free
+			Reallocate(GrownCapacity());
+			alloc_traits::construct(m_Allocator, m_pData + m_Size, std::move(moved));
+		}
+		else
+		{
+			alloc_traits::construct(m_Allocator, m_pData + m_Size, std::move(value));
 		}
-
-		m_pData[m_Size] = std::move(type);
 		++m_Size;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::PopBack()
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::PopBack()
 	{
 		if constexpr (!std::is_trivially_destructible<type>::value)
 		{
-			Back().~type();
+			alloc_traits::destroy(m_Allocator, &Back());
 		}
 
 		--m_Size;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::Resize(uint32_t newSize)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::Resize(uint32_t newSize)
 	{
 		static_assert(std::is_default_constructible<type>::value, "type needs to be default constructable");
 		if constexpr (!std::is_trivially_destructible<type>::value)
 		{
 			if (newSize < m_Size)
 			{
-				for (size_t i{ newSize }; i < m_Size; ++i)
+				for (uint32_t i{ newSize }; i < m_Size; ++i)
 				{
-					m_pData[i].~type();
+					alloc_traits::destroy(m_Allocator, m_pData + i);
 				}
 			}
 		}
 
 		if (newSize > m_Capacity)
 		{
-			uint32_t oldCap = m_Capacity;
 			Reallocate(newSize);
-			for (uint32_t i{ m_Size }; i < m_Capacity; ++i)
-			{
-				m_pData[i] = type{};
-			}
 		}
-		
+
+		for (uint32_t i{ m_Size }; i < newSize; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i);
+		}
+
 		m_Size = newSize;
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::Swap(Vector& other)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::Swap(Vector& other)
 	{
+		if constexpr (alloc_traits::propagate_on_container_swap::value)
+		{
+			std::swap(m_Allocator, other.m_Allocator);
+		}
+		else
+		{
+			// without propagation each buffer stays with the allocator that has to free it, just like the std containers
+			assert(AllocatorEquals(other));
+		}
 		std::swap(m_Capacity, other.m_Capacity);
 		std::swap(m_Size, other.m_Size);
 		std::swap(m_pData, other.m_pData);
 	}
 
-	template<typename type, typename allocator>
-	inline void Vector<type, allocator>::Reallocate(uint32_t newCapacity)
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::Reallocate(uint32_t newCapacity)
 	{
+		newCapacity = RoundCapacity(newCapacity);
+		// allocators that can grow a block where it is (like ArenaAllocator) save the copy
+		if constexpr (requires(allocator& alloc, type* pData, size_t count) { { alloc.TryExpand(pData, count, count) } -> std::same_as<bool>; })
+		{
+			if (!std::is_constant_evaluated() && m_pData && newCapacity > m_Capacity
+				&& m_Allocator.TryExpand(m_pData, m_Capacity, newCapacity))
+			{
+				hooks::OnReallocate(m_Size, m_Capacity, newCapacity, 0);
+				m_Capacity = newCapacity;
+				return;
+			}
+		}
+
+		if constexpr (requires(allocator& alloc, size_t count) { alloc.OnReallocate(count, count, count); })
+		{
+			if (!std::is_constant_evaluated() && m_pData)
+			{
+				m_Allocator.OnReallocate(m_Size, m_Capacity, newCapacity);
+			}
+		}
+
 		type* pOldData = m_pData;
-		m_pData = m_Allocator.allocate(newCapacity);
-		memcpy(m_pData, pOldData, m_Size * sizeof(type));
-		m_Allocator.deallocate(pOldData, m_Capacity);
+		m_pData = alloc_traits::allocate(m_Allocator, newCapacity);
+		if (pOldData)
+		{
+			// only trivially copyable elements can be copied as bytes, others (like std::string with its short string buffer) may point into themselves
+			if (std::is_constant_evaluated() || !std::is_trivially_copyable<type>::value)
+			{
+				for (uint32_t i{}; i < m_Size; ++i)
+				{
+					std::construct_at(m_pData + i, std::move(pOldData[i]));
+					std::destroy_at(pOldData + i);
+				}
+			}
+			else
+			{
+				CopyBytes(m_pData, pOldData, m_Size * sizeof(type));
+			}
+			if (!std::is_constant_evaluated())
+			{
+				if (newCapacity < m_Capacity)
+				{
+					hooks::OnShrink(m_Size, m_Capacity, newCapacity, m_Size * sizeof(type));
+				}
+				else
+				{
+					hooks::OnReallocate(m_Size, m_Capacity, newCapacity, m_Size * sizeof(type));
+				}
+			}
+			alloc_traits::deallocate(m_Allocator, pOldData, m_Capacity);
+		}
 		m_Capacity = newCapacity;
 	}
 
+	template<typename type, typename allocator, typename hooks>
+	constexpr uint32_t Vector<type, allocator, hooks>::GrownCapacity() const
+	{
+		// a moved from or fully shrunk vector has no capacity left to multiply
+		return m_Capacity > 0 ? m_Capacity * m_CapacityGrowth : m_DefaultSize;
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr uint32_t Vector<type, allocator, hooks>::RoundCapacity(uint32_t capacity)
+	{
+		if constexpr (requires(size_t count) { { allocator::RoundCapacity(count) } -> std::same_as<size_t>; })
+		{
+			return static_cast<uint32_t>(allocator::RoundCapacity(capacity));
+		}
+		else
+		{
+			return capacity;
+		}
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::RelocateElements(type* pDest, type* pSrc, uint32_t count)
+	{
+		if (count == 0 || pDest == pSrc)
+		{
+			return;
+		}
+
+		if (!std::is_constant_evaluated())
+		{
+			// moving up makes room for an insert, moving down closes the gap of an erase
+			if (pDest > pSrc)
+			{
+				hooks::OnInsertShift(static_cast<uint32_t>(pSrc - m_pData), static_cast<uint32_t>(pDest - pSrc), count * sizeof(type));
+			}
+			else
+			{
+				hooks::OnEraseShift(static_cast<uint32_t>(pDest - m_pData), static_cast<uint32_t>(pSrc - pDest), count * sizeof(type));
+			}
+			if constexpr (std::is_trivially_copyable<type>::value)
+			{
+				MoveBytes(pDest, pSrc, count * sizeof(type)); // MoveBytes because the src and dest will overlap
+				return;
+			}
+		}
+
+		// the compiler can't memmove objects during constant evaluation, and other elements may point into themselves,
+		// so we move them one by one in the direction that never overwrites an element we still have to move
+		if (pDest < pSrc)
+		{
+			for (uint32_t i{}; i < count; ++i)
+			{
+				std::construct_at(pDest + i, std::move(pSrc[i]));
+				std::destroy_at(pSrc + i);
+			}
+		}
+		else
+		{
+			for (uint32_t i{ count }; i > 0; --i)
+			{
+				std::construct_at(pDest + i - 1, std::move(pSrc[i - 1]));
+				std::destroy_at(pSrc + i - 1);
+			}
+		}
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::ConstructFill(type* pDest, uint32_t count, const type& value)
+	{
+		// trivially copyable elements don't need constructing one by one, the fill kernel writes them all at once
+		if constexpr (std::is_trivially_copyable<type>::value)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				Fill(pDest, count, value);
+				return;
+			}
+		}
+
+		for (uint32_t i{}; i < count; ++i)
+		{
+			alloc_traits::construct(m_Allocator, pDest + i, value);
+		}
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr bool Vector<type, allocator, hooks>::AllocatorEquals(const Vector& other) const
+	{
+		if constexpr (alloc_traits::is_always_equal::value)
+		{
+			return true;
+		}
+		else
+		{
+			return m_Allocator == other.m_Allocator;
+		}
+	}
+
+	template<typename type, typename allocator, typename hooks>
+	constexpr void Vector<type, allocator, hooks>::MoveElementsFrom(Vector& other)
+	{
+		assert(m_Size == 0);
+		if (m_Capacity < other.m_Size)
+		{
+			if (m_pData)
+			{
+				alloc_traits::deallocate(m_Allocator, m_pData, m_Capacity);
+			}
+			m_Capacity = RoundCapacity(other.m_Size);
+			m_pData = alloc_traits::allocate(m_Allocator, m_Capacity);
+		}
+		for (uint32_t i{}; i < other.m_Size; ++i)
+		{
+			alloc_traits::construct(m_Allocator, m_pData + i, std::move(other.m_pData[i]));
+		}
+		m_Size = other.m_Size;
+		other.Clear();
+	}
+
+	template<typename generator>
+	consteval auto ToArray(generator)
+	{
+		constexpr uint32_t size = generator{}().Size();
+		using valueType = std::remove_cvref_t<decltype(generator{}()[0])>;
+
+		std::array<valueType, size> out{};
+		const auto vec = generator{}();
+		for (uint32_t i{}; i < size; ++i)
+		{
+			out[i] = vec[i];
+		}
+		return out;
+	}
+
 	template<typename type>
-	inline type& Iterator<type>::operator*()
+	constexpr type& Iterator<type>::operator*()
 	{
 		return *(this->m_pValue);
 	}
 
 	template<typename type>
-	inline type& Iterator<type>::operator->()
+	constexpr type& Iterator<type>::operator->()
 	{
 		return *(this->m_pValue);
 	}
 
 	template<typename type>
-	inline Iterator<type> Iterator<type>::operator+(int32_t rhs)
+	constexpr Iterator<type> Iterator<type>::operator+(int32_t rhs)
 	{
 		return Iterator(this->m_pValue + rhs);
 	}
 
 	template<typename type>
-	inline  Iterator<type> Iterator<type>::operator-(int32_t rhs)
+	constexpr Iterator<type> Iterator<type>::operator-(int32_t rhs)
 	{
 		return Iterator(this->m_pValue - rhs);
 	}
 
 
 	template<typename type>
-	inline  Iterator<type>& Iterator<type>::operator++()
+	constexpr Iterator<type>& Iterator<type>::operator++()
 	{
 		++(this->m_pValue);
 		return *this;
 	}
 
 	template<typename type>
-	inline  Iterator<type> Iterator<type>::operator++(int)
+	constexpr Iterator<type> Iterator<type>::operator++(int)
 	{
 		Iterator temp = *this;
 		++(this->m_pValue);
@@ -654,14 +971,14 @@ namespace Container
 	}
 
 	template<typename type>
-	inline  Iterator<type>& Iterator<type>::operator--()
+	constexpr Iterator<type>& Iterator<type>::operator--()
 	{
 		--(this->m_pValue);
 		return *this;
 	}
 
 	template<typename type>
-	inline  Iterator<type> Iterator<type>::operator--(int)
+	constexpr Iterator<type> Iterator<type>::operator--(int)
 	{
 		Iterator temp = *this;
 		--(this->m_pValue);
@@ -669,70 +986,70 @@ namespace Container
 	}
 
 	template<typename type>
-	inline  Iterator<type>& Iterator<type>::operator+=(int32_t rhs)
+	constexpr Iterator<type>& Iterator<type>::operator+=(int32_t rhs)
 	{
 		this->m_pValue += rhs;
 		return *this;
 	}
 
 	template<typename type>
-	inline ConstIterator<type>::ConstIterator(type* pVal)
+	constexpr ConstIterator<type>::ConstIterator(type* pVal)
 		: m_pValue{pVal}
 	{
 	}
 
 	template<typename type>
-	inline  Iterator<type>& Iterator<type>::operator-=(int32_t rhs)
+	constexpr Iterator<type>& Iterator<type>::operator-=(int32_t rhs)
 	{
 		this->m_pValue -= rhs;
 		return *this;
 	}
 
 	template<typename type>
-	inline bool Iterator<type>::operator==(const Iterator& rhs) const
+	constexpr bool Iterator<type>::operator==(const Iterator& rhs) const
 	{
 		return this->m_pValue == rhs.m_pValue;
 	}
 
 	template<typename type>
-	inline bool Iterator<type>::operator!=(const Iterator& rhs) const
+	constexpr bool Iterator<type>::operator!=(const Iterator& rhs) const
 	{
 		return this->m_pValue != rhs.m_pValue;
 	}
 
 	template<typename type>
-	inline const type& ConstIterator<type>::operator*() const
+	constexpr const type& ConstIterator<type>::operator*() const
 	{
 		return *m_pValue;
 	}
 
 	template<typename type>
-	inline const type& ConstIterator<type>::operator->() const
+	constexpr const type& ConstIterator<type>::operator->() const
 	{
 		return *m_pValue;
 	}
 
 	template<typename type>
-	inline ConstIterator<type>& ConstIterator<type>::operator++()
+	constexpr ConstIterator<type>& ConstIterator<type>::operator++()
 	{
 		++m_pValue;
 		return *this;
 	}
 
 	template<typename type>
-	inline  ConstIterator<type> ConstIterator<type>::operator+(int32_t rhs)
+	constexpr ConstIterator<type> ConstIterator<type>::operator+(int32_t rhs)
 	{
 		return ConstIterator{m_pValue + rhs};
 	}
 
 	template<typename type>
-	inline  ConstIterator<type> ConstIterator<type>::operator-(int32_t rhs)
+	constexpr ConstIterator<type> ConstIterator<type>::operator-(int32_t rhs)
 	{
 		return ConstIterator{ m_pValue - rhs };
 	}
 
 	template<typename type>
-	inline  ConstIterator<type> ConstIterator<type>::operator++(int)
+	constexpr ConstIterator<type> ConstIterator<type>::operator++(int)
 	{
 		ConstIterator temp = *this;
 		++m_pValue;
@@ -740,14 +1057,14 @@ namespace Container
 	}
 
 	template<typename type>
-	inline  ConstIterator<type>& ConstIterator<type>::operator--()
+	constexpr ConstIterator<type>& ConstIterator<type>::operator--()
 	{
 		--m_pValue;
 		return *this;
 	}
 
 	template<typename type>
-	inline  ConstIterator<type> ConstIterator<type>::operator--(int)
+	constexpr ConstIterator<type> ConstIterator<type>::operator--(int)
 	{
 		ConstIterator temp = *this;
 		--m_pValue;
@@ -755,28 +1072,36 @@ namespace Container
 	}
 
 	template<typename type>
-	inline  ConstIterator<type>& ConstIterator<type>::operator+=(int32_t rhs)
+	constexpr ConstIterator<type>& ConstIterator<type>::operator+=(int32_t rhs)
 	{
 		m_pValue += rhs;
 		return *this;
 	}
 
 	template<typename type>
-	inline  ConstIterator<type>& ConstIterator<type>::operator-=(int32_t rhs)
+	constexpr ConstIterator<type>& ConstIterator<type>::operator-=(int32_t rhs)
 	{
 		m_pValue -= rhs;
 		return *this;
 	}
 
 	template<typename type>
-	inline bool ConstIterator<type>::operator==(const ConstIterator& rhs) const
+	constexpr bool ConstIterator<type>::operator==(const ConstIterator& rhs) const
 	{
 		return m_pValue == rhs.m_pValue;
 	}
 
 	template<typename type>
-	inline bool ConstIterator<type>::operator!=(const ConstIterator& rhs) const
+	constexpr bool ConstIterator<type>::operator!=(const ConstIterator& rhs) const
 	{
 		return m_pValue != rhs.m_pValue;
 	}
-}
\ No newline at end of file
+
+	namespace pmr
+	{
+		// Vector on a std::pmr::memory_resource. The allocator gets passed on to elements that take one, so a
+		// Vector<Vector<T>> and everything in it ends up in the same resource
+		template<typename type>
+		using Vector = Container::Vector<type, std::pmr::polymorphic_allocator<type>>;
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Container
+{
+	// Hooks policies get called by Vector on everything that moves a lot of memory at once
+	// Reallocate and shrink report the element count and both capacities, the shifts report where the elements were
+	// inserted or erased and how many. bytesMoved is what got copied or memmoved, 0 when the allocator grew the buffer in place
+	// The callbacks are static so the policy doesn't add to the size of Vector
+
+	// The default, every call compiles away
+	struct NoHooks
+	{
+		static constexpr void OnReallocate(uint32_t, uint32_t, uint32_t, size_t) {}
+		static constexpr void OnShrink(uint32_t, uint32_t, uint32_t, size_t) {}
+		static constexpr void OnInsertShift(uint32_t, uint32_t, size_t) {}
+		static constexpr void OnEraseShift(uint32_t, uint32_t, size_t) {}
+	};
+
+	enum class VectorEventType : uint8_t
+	{
+		Reallocate,
+		Shrink,
+		InsertShift,
+		EraseShift
+	};
+
+	struct VectorEvent
+	{
+		int64_t timestamp; // steady_clock ticks
+		size_t bytesMoved;
+		// Reallocate and Shrink: size, old capacity, new capacity
+		// InsertShift and EraseShift: position, element count, unused
+		uint32_t values[3];
+		VectorEventType type;
+	};
+
+	// Ring buffer of the last Capacity events of one thread, the oldest get overwritten
+	// Only the owning thread writes and reads it, so recording is a couple of stores without any locking. Count is
+	// atomic so a profiler can poll how busy a thread is, dump the events themselves from the thread that had the spike
+	class TraceBuffer final
+	{
+	public:
+#pragma region Deleted Functions
+		TraceBuffer(const TraceBuffer& other) = delete;
+		TraceBuffer& operator=(const TraceBuffer& other) = delete;
+#pragma endregion
+		static constexpr uint32_t Capacity = 4096;
+
+		// the buffer of the calling thread
+		_NODISCARD static TraceBuffer& Local();
+
+		void Record(VectorEventType type, uint32_t first, uint32_t second, uint32_t third, size_t bytesMoved);
+		// Copies up to maxCount of the newest events to pOut, oldest first, and returns how many it copied
+		uint32_t CopyRecent(VectorEvent* pOut, uint32_t maxCount) const;
+		// every event recorded so far, including the overwritten ones
+		_NODISCARD uint64_t Count() const;
+		void Clear();
+
+	private:
+		TraceBuffer() = default;
+
+		VectorEvent m_Events[Capacity]{};
+		std::atomic<uint64_t> m_Count{ 0 };
+	};
+
+	// Writes every event into the TraceBuffer of the thread it happened on
+	struct TraceHooks
+	{
+		static void OnReallocate(uint32_t size, uint32_t oldCapacity, uint32_t newCapacity, size_t bytesMoved);
+		static void OnShrink(uint32_t size, uint32_t oldCapacity, uint32_t newCapacity, size_t bytesMoved);
+		static void OnInsertShift(uint32_t position, uint32_t count, size_t bytesMoved);
+		static void OnEraseShift(uint32_t position, uint32_t count, size_t bytesMoved);
+	};
+
+#pragma region TraceBuffer
+	inline TraceBuffer& TraceBuffer::Local()
+	{
+		thread_local TraceBuffer buffer{};
+		return buffer;
+	}
+
+	inline void TraceBuffer::Record(VectorEventType type, uint32_t first, uint32_t second, uint32_t third, size_t bytesMoved)
+	{
+		const uint64_t count = m_Count.load(std::memory_order_relaxed);
+		VectorEvent& event = m_Events[count % Capacity];
+		event.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+		event.bytesMoved = bytesMoved;
+		event.values[0] = first;
+		event.values[1] = second;
+		event.values[2] = third;
+		event.type = type;
+		m_Count.store(count + 1, std::memory_order_release);
+	}
+
+	inline uint32_t TraceBuffer::CopyRecent(VectorEvent* pOut, uint32_t maxCount) const
+	{
+		const uint64_t count = m_Count.load(std::memory_order_acquire);
+		const uint64_t available = count < Capacity ? count : Capacity;
+		const uint32_t copyCount = static_cast<uint32_t>(available < maxCount ? available : maxCount);
+		for (uint64_t i = count - copyCount; i < count; ++i)
+		{
+			*pOut++ = m_Events[i % Capacity];
+		}
+		return copyCount;
+	}
+
+	inline uint64_t TraceBuffer::Count() const
+	{
+		return m_Count.load(std::memory_order_relaxed);
+	}
+
+	inline void TraceBuffer::Clear()
+	{
+		m_Count.store(0, std::memory_order_relaxed);
+	}
+#pragma endregion
+
+#pragma region TraceHooks
+	inline void TraceHooks::OnReallocate(uint32_t size, uint32_t oldCapacity, uint32_t newCapacity, size_t bytesMoved)
+	{
+		TraceBuffer::Local().Record(VectorEventType::Reallocate, size, oldCapacity, newCapacity, bytesMoved);
+	}
+
+	inline void TraceHooks::OnShrink(uint32_t size, uint32_t oldCapacity, uint32_t newCapacity, size_t bytesMoved)
+	{
+		TraceBuffer::Local().Record(VectorEventType::Shrink, size, oldCapacity, newCapacity, bytesMoved);
+	}
+
+	inline void TraceHooks::OnInsertShift(uint32_t position, uint32_t count, size_t bytesMoved)
+	{
+		TraceBuffer::Local().Record(VectorEventType::InsertShift, position, count, 0, bytesMoved);
+	}
+
+	inline void TraceHooks::OnEraseShift(uint32_t position, uint32_t count, size_t bytesMoved)
+	{
+		TraceBuffer::Local().Record(VectorEventType::EraseShift, position, count, 0, bytesMoved);
+	}
+#pragma endregion
+}
@@ -2,20 +2,54 @@
 //#define Benchmarking
 
 #ifdef Testing
+#define CONTAINER_TELEMETRY 1 // the telemetry tests need the counters
 #define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
 #include "catch.hpp"
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
+#include <iomanip>
+#include "BenchmarkCompare.h"
+#include "LatencyHistogram.h"
 #endif // Testing
 #ifdef Benchmarking
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <atomic>
+#include <shared_mutex>
+#include <iomanip>
+#include <fstream>
+#include "Benchmark.h"
+#include "LatencyHistogram.h"
 #endif // Benchmarking
 
 
 #include "Vector.h"
+#include "BitVector.h"
+#include "FlatMap.h"
+#include "FlatSet.h"
+#include "StaticSearchIndex.h"
+#include "UnorderedMap.h"
+#include "RobinHoodMap.h"
+#include "RealTimeVector.h"
+#include "ConcurrentUnorderedMap.h"
+#include "List.h"
+#include "Allocator.h"
+#include "PageAllocator.h"
+#include "MemoryCopy.h"
+#include "Algorithm.h"
+#include "CpuDispatch.h"
+#include "Telemetry.h"
 #include <stdlib.h>
+#include <bit>
 #include <chrono>
 #include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 
 #ifdef Testing
 #pragma region Vector Tests
@@ -342,168 +376,3521 @@ TEST_CASE("Vector Modifier tests")
 	REQUIRE(pInts1 != vec1.Data());
 	REQUIRE(pInts2 == vec1.Data());
 	REQUIRE(pInts2 != vec2.Data());
-	
 
+	// Short strings live in a buffer inside the string itself, so they can't be moved around as bytes
+	Container::Vector<std::string> shortStrings{};
+	for (int i{}; i < 20; ++i)
+	{
+		shortStrings.PushBack(std::to_string(i));
+	}
+	shortStrings.Insert(shortStrings.CBegin(), "front");
+	shortStrings.Erase(shortStrings.CBegin() + 1, shortStrings.CBegin() + 3);
+	shortStrings.ShrinkToFit();
+	REQUIRE(shortStrings.Size() == 19);
+	REQUIRE(shortStrings[0] == "front");
+	REQUIRE(shortStrings[1] == "2");
+	REQUIRE(shortStrings[18] == "19");
+
+	// Pushing one of our own elements into a full vector, the reallocation frees the buffer it lives in
+	Container::Vector<std::string> selfPush{};
+	selfPush.PushBack("an element that doesn't fit in the small string buffer");
+	while (selfPush.Size() < selfPush.Capacity())
+	{
+		selfPush.PushBack(selfPush[0]);
+	}
+	selfPush.PushBack(selfPush[0]);
+	REQUIRE(selfPush.Back() == selfPush[0]);
+	while (selfPush.Size() < selfPush.Capacity())
+	{
+		selfPush.PushBack(selfPush[0]);
+	}
+	const uint32_t selfPushSize = selfPush.Size();
+	selfPush.PushBack(std::move(selfPush[1]));
+	REQUIRE(selfPush.Size() == selfPushSize + 1);
+	REQUIRE(selfPush.Back() == selfPush[0]);
+
+
+
+}
+
+constexpr Container::Vector<int> MakeSquares()
+{
+	Container::Vector<int> squares{};
+	for (int i{}; i < 16; ++i)
+	{
+		squares.PushBack(i * i);
+	}
+	return squares;
+}
+
+constexpr int ConstexprModifiers()
+{
+	// exercises every path that moves elements around during constant evaluation
+	Container::Vector<int> vec{ 2 };
+	for (int i{}; i < 10; ++i)
+	{
+		vec.EmplaceBack(i);
+	}
+	vec.Insert(vec.CBegin(), 100);
+	vec.Insert(vec.CBegin() + 1, 2, 50);
+	vec.Erase(vec.CBegin() + 3);
+	vec.Erase(vec.CBegin() + 5, vec.CEnd() - 1);
+	vec.Resize(8);
+	vec.ShrinkToFit();
+	Container::Vector<int> copy{ vec };
+	vec.Clear();
+
+	int sum{};
+	for (uint32_t i{}; i < copy.Size(); ++i)
+	{
+		sum += copy[i];
+	}
+	return sum + static_cast<int>(copy.Size()) * 1000 + (vec.Empty() ? 1 : 0);
+}
+
+TEST_CASE("Vector constexpr tests")
+{
+	// 100, 50, 50, 1, 2, 9 followed by 2 value initialized ints
+	static_assert(ConstexprModifiers() == 8000 + 212 + 1);
+	REQUIRE(ConstexprModifiers() == 8213);
+
+	constexpr auto squares = Container::ToArray([]() { return MakeSquares(); });
+	static_assert(squares.size() == 16);
+	static_assert(squares[15] == 225);
+
+	constexpr auto table = Container::ToArray([]()
+		{
+			Container::Vector<uint8_t> bitCounts{};
+			for (uint32_t i{}; i < 256; ++i)
+			{
+				bitCounts.PushBack(static_cast<uint8_t>(std::popcount(i)));
+			}
+			return bitCounts;
+		});
+	static_assert(table.size() == 256);
+	static_assert(table[255] == 8 && table[0x11] == 2);
+
+	const Container::Vector<int> runtimeSquares = MakeSquares();
+	bool sameValues = true;
+	for (uint32_t i{}; i < runtimeSquares.Size(); ++i)
+	{
+		sameValues = sameValues && runtimeSquares[i] == squares[i];
+	}
+	REQUIRE(sameValues);
+}
+
+#pragma endregion
+
+#pragma region BitVector Tests
+TEST_CASE("BitVector tests")
+{
+	const uint32_t size{ 200 };
+	Container::BitVector<> bits{ size };
+	REQUIRE(bits.Size() == size);
+	REQUIRE(bits.WordCount() == 4);
+	REQUIRE(bits.Count() == 0);
+	REQUIRE(bits.FindFirstSet() == Container::BitVector<>::NoBit);
+
+	// Single bit modifiers
+	bits.Set(3);
+	bits.Set(64);
+	bits.Set(199);
+	REQUIRE(bits.Test(3));
+	REQUIRE(bits[64]);
+	REQUIRE(!bits[65]);
+	REQUIRE(bits.Count() == 3);
+	bits.Flip(3);
+	REQUIRE(!bits[3]);
+	bits.Flip(3);
+	bits.Reset(64);
+	REQUIRE(!bits[64]);
+	bits.Set(64, true);
+	bits.Set(65, false);
+	REQUIRE(bits[64]);
+	REQUIRE(!bits[65]);
+
+	// Find functions
+	REQUIRE(bits.FindFirstSet() == 3);
+	REQUIRE(bits.FindNextSet(3) == 64);
+	REQUIRE(bits.FindNextSet(64) == 199);
+	REQUIRE(bits.FindNextSet(199) == Container::BitVector<>::NoBit);
+	uint32_t visited{};
+	for (uint32_t i{ bits.FindFirstSet() }; i != Container::BitVector<>::NoBit; i = bits.FindNextSet(i))
+	{
+		++visited;
+	}
+	REQUIRE(visited == bits.Count());
+
+	// Range and whole vector modifiers, the bits past the size should never show up in Count
+	bits.ResetAll();
+	bits.SetRange(10, 140);
+	REQUIRE(bits.Count() == 130);
+	REQUIRE(!bits[9]);
+	REQUIRE(bits[10]);
+	REQUIRE(bits[139]);
+	REQUIRE(!bits[140]);
+	bits.ResetRange(20, 30);
+	REQUIRE(bits.Count() == 120);
+	bits.FlipRange(0, size);
+	REQUIRE(bits.Count() == size - 120);
+	bits.FlipAll();
+	REQUIRE(bits.Count() == 120);
+	bits.SetAll();
+	REQUIRE(bits.Count() == size);
+	REQUIRE(bits.All());
+
+	// Push/pop back
+	Container::BitVector<> pushed{};
+	REQUIRE(pushed.Empty());
+	for (uint32_t i{}; i < 130; ++i)
+	{
+		pushed.PushBack(i % 3 == 0);
+	}
+	REQUIRE(pushed.Size() == 130);
+	REQUIRE(pushed.Count() == 44);
+	bool rightVals = true;
+	for (uint32_t i{}; i < 130; ++i)
+	{
+		rightVals = rightVals && pushed[i] == (i % 3 == 0);
+	}
+	REQUIRE(rightVals);
+	for (uint32_t i{}; i < 66; ++i)
+	{
+		pushed.PopBack();
+	}
+	REQUIRE(pushed.Size() == 64);
+	REQUIRE(pushed.WordCount() == 1);
+	REQUIRE(pushed.Count() == 22);
+
+	// Resize
+	pushed.Resize(100, true);
+	REQUIRE(pushed.Count() == 22 + 36);
+	pushed.Resize(10);
+	REQUIRE(pushed.Count() == 4);
+
+	// Bulk operations, odd word count so both the SIMD and the scalar tail get used
+	Container::BitVector<> lhs{ 300 };
+	Container::BitVector<> rhs{ 300 };
+	for (uint32_t i{}; i < 300; ++i)
+	{
+		lhs.Set(i, i % 2 == 0);
+		rhs.Set(i, i % 3 == 0);
+	}
+	Container::BitVector<> andBits{ lhs };
+	andBits &= rhs;
+	REQUIRE(andBits.Count() == 50);
+	Container::BitVector<> orBits{ lhs };
+	orBits |= rhs;
+	REQUIRE(orBits.Count() == 200);
+	Container::BitVector<> xorBits{ lhs };
+	xorBits ^= rhs;
+	REQUIRE(xorBits.Count() == 150);
+	Container::BitVector<> andNotBits{ lhs };
+	andNotBits.AndNot(rhs);
+	REQUIRE(andNotBits.Count() == 100);
+	REQUIRE(andNotBits[2]);
+	REQUIRE(!andNotBits[6]);
+	REQUIRE(andBits != orBits);
+	xorBits ^= rhs;
+	REQUIRE(xorBits == lhs);
+}
+#pragma endregion
+
+#pragma region Flat Container Tests
+TEST_CASE("FlatSet tests")
+{
+	Container::FlatSet<int> set{};
+	REQUIRE(set.Empty());
+	REQUIRE(set.Insert(5));
+	REQUIRE(set.Insert(1));
+	REQUIRE(set.Insert(9));
+	REQUIRE(!set.Insert(5));
+	REQUIRE(set.Size() == 3);
+	REQUIRE(set[0] == 1);
+	REQUIRE(set[2] == 9);
+	REQUIRE(set.Contains(9));
+	REQUIRE(!set.Contains(4));
+	REQUIRE(set.Find(4) == Container::FlatSet<int>::NoIndex);
+	REQUIRE(set.LowerBound(4) == 1);
+
+	// Hinted inserts, both a right and a wrong hint should end up sorted
+	REQUIRE(set.Insert(set.Size(), 20));
+	REQUIRE(set.Insert(0, 7));
+	REQUIRE(set.Size() == 5);
+	bool sorted = true;
+	for (uint32_t i{ 1 }; i < set.Size(); ++i)
+	{
+		sorted = sorted && set[i - 1] < set[i];
+	}
+	REQUIRE(sorted);
+
+	// Bulk insert with duplicates of new and existing keys
+	const int unsorted[]{ 40, 3, 9, 3, 30, 1, 2 };
+	set.InsertUnsorted(std::begin(unsorted), std::end(unsorted));
+	const int expected[]{ 1, 2, 3, 5, 7, 9, 20, 30, 40 };
+	REQUIRE(set.Size() == 9);
+	bool rightVals = true;
+	for (uint32_t i{}; i < set.Size(); ++i)
+	{
+		rightVals = rightVals && set[i] == expected[i];
+	}
+	REQUIRE(rightVals);
+
+	REQUIRE(set.Erase(7));
+	REQUIRE(!set.Erase(7));
+	REQUIRE(set.Size() == 8);
+	REQUIRE(!set.Contains(7));
+}
+
+TEST_CASE("FlatMap tests")
+{
+	Container::FlatMap<int, std::string> map{};
+	REQUIRE(map.Insert(3, "three"));
+	REQUIRE(map.Insert(1, "one"));
+	REQUIRE(!map.Insert(3, "drie"));
+	REQUIRE(map.Size() == 2);
+	REQUIRE(map.At(3) == "three");
+	REQUIRE(map.Find(2) == nullptr);
+	REQUIRE(*map.Find(1) == "one");
+	map[2] = "two";
+	REQUIRE(map.Size() == 3);
+	REQUIRE(map.KeyAt(1) == 2);
+	REQUIRE(map.ValueAt(1) == "two");
+
+	// Sorted input through hints never has to search
+	Container::FlatMap<int, int> squares{};
+	for (int i{}; i < 100; ++i)
+	{
+		squares.Insert(squares.Size(), i, i * i);
+	}
+	REQUIRE(squares.Size() == 100);
+	REQUIRE(squares.At(12) == 144);
+	REQUIRE(squares.Insert(50, 1000, 0)); // wrong hint
+	REQUIRE(squares.KeyAt(100) == 1000);
+
+	// Bulk insert, old values and the first duplicate win
+	std::pair<int, std::string> pairs[]{ { 10, "ten" }, { 0, "zero" }, { 3, "not three" }, { 10, "not ten" }, { 5, "five" } };
+	map.InsertUnsorted(std::begin(pairs), std::end(pairs));
+	const int expectedKeys[]{ 0, 1, 2, 3, 5, 10 };
+	REQUIRE(map.Size() == 6);
+	bool rightKeys = true;
+	for (uint32_t i{}; i < map.Size(); ++i)
+	{
+		rightKeys = rightKeys && map.KeyAt(i) == expectedKeys[i];
+	}
+	REQUIRE(rightKeys);
+	REQUIRE(map.At(3) == "three");
+	REQUIRE(map.At(10) == "ten");
+	REQUIRE(map.Keys().Size() == map.Values().Size());
+
+	REQUIRE(map.Erase(0));
+	REQUIRE(!map.Contains(0));
+	REQUIRE(map.At(1) == "one");
+	REQUIRE(map.Size() == 5);
+}
+#pragma endregion
+
+#pragma region StaticSearchIndex Tests
+TEST_CASE("StaticSearchIndex tests")
+{
+	Container::StaticSearchIndex<uint64_t> emptyIndex{};
+	REQUIRE(emptyIndex.Empty());
+	REQUIRE(emptyIndex.LowerBound(5) == 0);
+	REQUIRE(!emptyIndex.Contains(5));
+
+	// Every size up to a few full tree levels, with gaps between the keys so misses can be checked too
+	bool allRight = true;
+	for (uint32_t size{ 1 }; size < 70; ++size)
+	{
+		Container::Vector<uint64_t> sorted{ size };
+		for (uint32_t i{}; i < size; ++i)
+		{
+			sorted.PushBack(10 + uint64_t{ i } * 2);
+		}
+		const Container::StaticSearchIndex<uint64_t> index{ sorted };
+		allRight = allRight && index.Size() == size;
+		for (uint32_t i{}; i < size; ++i)
+		{
+			allRight = allRight && index.Find(sorted[i]) == i;
+			allRight = allRight && index.LowerBound(sorted[i]) == i;
+			allRight = allRight && index.LowerBound(sorted[i] - 1) == i;
+			allRight = allRight && !index.Contains(sorted[i] + 1);
+		}
+		allRight = allRight && index.LowerBound(0) == 0;
+		allRight = allRight && index.LowerBound(sorted.Back() + 1) == size;
+	}
+	REQUIRE(allRight);
+
+	// Duplicates should resolve to the first one, like std::lower_bound
+	const uint64_t withDuplicates[]{ 1, 3, 3, 3, 7, 7, 9 };
+	Container::StaticSearchIndex<uint64_t> duplicateIndex{ withDuplicates, 7 };
+	REQUIRE(duplicateIndex.LowerBound(3) == 1);
+	REQUIRE(duplicateIndex.Find(7) == 4);
+	REQUIRE(duplicateIndex.LowerBound(8) == 6);
+	REQUIRE(duplicateIndex.Find(8) == Container::StaticSearchIndex<uint64_t>::NoIndex);
+
+	Container::StaticSearchIndex<uint64_t> movedIndex{ std::move(duplicateIndex) };
+	REQUIRE(movedIndex.Find(9) == 6);
+}
+#pragma endregion
+
+#pragma region UnorderedMap Tests
+TEST_CASE("UnorderedMap tests")
+{
+	Container::UnorderedMap<int, int> map{};
+	REQUIRE(map.Empty());
+	REQUIRE(map.Find(5) == map.End());
+	REQUIRE(!map.Contains(5));
+	REQUIRE(!map.Erase(5));
+
+	REQUIRE(map.Insert({ 5, 50 }).second);
+	REQUIRE(!map.Insert({ 5, 51 }).second);
+	REQUIRE(map.At(5) == 50);
+	map[7] = 70;
+	REQUIRE(map.Size() == 2);
+	REQUIRE(map.Find(7)->second == 70);
+	REQUIRE(map.TryEmplace(7, 71).first->second == 70);
+
+	// Enough elements for several rehashes, every other one erased again leaves tombstones behind
+	Container::UnorderedMap<int, int> bigMap{};
+	for (int i{}; i < 10000; ++i)
+	{
+		bigMap[i] = i * 2;
+	}
+	REQUIRE(bigMap.Size() == 10000);
+	REQUIRE(bigMap.LoadFactor() <= bigMap.MaxLoadFactor());
+	bool allRight = true;
+	for (int i{}; i < 10000; i += 2)
+	{
+		allRight = allRight && bigMap.Erase(i);
+	}
+	allRight = allRight && bigMap.Size() == 5000;
+	for (int i{}; i < 10000; ++i)
+	{
+		allRight = allRight && bigMap.Contains(i) == (i % 2 == 1);
+	}
+	REQUIRE(allRight);
+
+	// Iterating should visit every element exactly once
+	int64_t sum{};
+	uint32_t count{};
+	for (auto it = bigMap.Begin(); it != bigMap.End(); ++it)
+	{
+		sum += it->second;
+		++count;
+	}
+	REQUIRE(count == 5000);
+	REQUIRE(sum == int64_t{ 2 } * 25000000);
+
+	// Churn on a small table reuses tombstones instead of growing forever
+	Container::UnorderedMap<int, int> churnMap{};
+	churnMap.Reserve(8);
+	const uint32_t capacity = churnMap.Capacity();
+	for (int i{}; i < 100000; ++i)
+	{
+		churnMap[i] = i;
+		if (i >= 8)
+		{
+			churnMap.Erase(i - 8);
+		}
+	}
+	REQUIRE(churnMap.Size() == 8);
+	REQUIRE(churnMap.Capacity() == capacity);
+	REQUIRE(churnMap.At(99999) == 99999);
+
+	Container::UnorderedMap<std::string, std::string> stringMap{};
+	stringMap["one"] = "een";
+	stringMap["two"] = "twee";
+	stringMap.Rehash(256);
+	REQUIRE(stringMap.Capacity() == 256);
+	REQUIRE(stringMap.At("two") == "twee");
+	Container::UnorderedMap<std::string, std::string> copiedMap{ stringMap };
+	copiedMap.Erase(copiedMap.Find("one"));
+	REQUIRE(copiedMap.Size() == 1);
+	REQUIRE(stringMap.Size() == 2);
+	Container::UnorderedMap<std::string, std::string> movedMap{};
+	movedMap = std::move(stringMap);
+	REQUIRE(movedMap.At("one") == "een");
+	REQUIRE(stringMap.Empty());
+	movedMap.Clear();
+	REQUIRE(movedMap.Empty());
+	REQUIRE(!movedMap.Contains("one"));
+
+	// The value comes out of a slot the growing insert frees
+	Container::UnorderedMap<int, std::string> aliasMap{};
+	aliasMap.TryEmplace(0, "a string that doesn't fit in the small buffer");
+	uint32_t aliasCapacity = aliasMap.Capacity();
+	int nextKey{ 1 };
+	while (aliasMap.Capacity() == aliasCapacity)
+	{
+		aliasMap.TryEmplace(nextKey, aliasMap.At(0));
+		++nextKey;
+	}
+	REQUIRE(aliasMap.At(nextKey - 1) == aliasMap.At(0));
+	aliasCapacity = aliasMap.Capacity();
+	while (aliasMap.Capacity() == aliasCapacity)
+	{
+		aliasMap.Insert(*aliasMap.Find(0));
+		aliasMap.Insert({ nextKey, aliasMap.At(nextKey - 1) });
+		++nextKey;
+	}
+	REQUIRE(aliasMap.At(nextKey - 1) == aliasMap.At(0));
+
+	// polymorphic allocators don't propagate, so moving between resources moves the elements and swapping needs the same resource
+	using PmrMap = Container::UnorderedMap<int, int, std::hash<int>, std::equal_to<int>, std::pmr::polymorphic_allocator<std::pair<int, int>>>;
+	alignas(std::max_align_t) std::byte firstBuffer[16 * 1024];
+	alignas(std::max_align_t) std::byte secondBuffer[16 * 1024];
+	std::pmr::monotonic_buffer_resource firstResource{ firstBuffer, sizeof(firstBuffer), std::pmr::null_memory_resource() };
+	std::pmr::monotonic_buffer_resource secondResource{ secondBuffer, sizeof(secondBuffer), std::pmr::null_memory_resource() };
+	static_assert(std::is_nothrow_move_assignable_v<Container::UnorderedMap<int, int>>);
+	static_assert(!std::is_nothrow_move_assignable_v<PmrMap>);
+	PmrMap firstMap{ &firstResource };
+	PmrMap secondMap{ &secondResource };
+	for (int i{}; i < 100; ++i)
+	{
+		firstMap.TryEmplace(i, i * 2);
+	}
+	secondMap = std::move(firstMap);
+	REQUIRE(firstMap.Empty());
+	REQUIRE(secondMap.Size() == 100);
+	REQUIRE(secondMap.At(99) == 198);
+	const void* pSlot = &*secondMap.Find(42);
+	REQUIRE((pSlot >= secondBuffer && pSlot < secondBuffer + sizeof(secondBuffer)));
+	PmrMap sameResourceMap{ &secondResource };
+	sameResourceMap.TryEmplace(1, 1);
+	sameResourceMap.Swap(secondMap);
+	REQUIRE(sameResourceMap.Size() == 100);
+	REQUIRE(secondMap.At(1) == 1);
+}
+#pragma endregion
+
+#pragma region RobinHoodMap Tests
+TEST_CASE("RobinHoodMap tests")
+{
+	Container::RobinHoodMap<int, int> map{};
+	REQUIRE(map.Empty());
+	REQUIRE(map.Find(5) == map.End());
+	REQUIRE(!map.Erase(5));
+	REQUIRE(map.Insert({ 5, 50 }).second);
+	REQUIRE(!map.Insert({ 5, 51 }).second);
+	map[7] = 70;
+	REQUIRE(map.Size() == 2);
+	REQUIRE(map.At(5) == 50);
+	REQUIRE(map.TryEmplace(7, 71).first->second == 70);
+
+	// Inserts that displace other elements should still return the new element
+	Container::RobinHoodMap<int, int> bigMap{};
+	bool allRight = true;
+	for (int i{}; i < 10000; ++i)
+	{
+		const auto result = bigMap.TryEmplace(i, i * 2);
+		allRight = allRight && result.second && result.first->first == i;
+	}
+	REQUIRE(allRight);
+	REQUIRE(bigMap.Size() == 10000);
+	REQUIRE(bigMap.LoadFactor() <= bigMap.MaxLoadFactor());
+	for (int i{}; i < 10000; i += 2)
+	{
+		allRight = allRight && bigMap.Erase(i);
+	}
+	allRight = allRight && bigMap.Size() == 5000;
+	for (int i{}; i < 10000; ++i)
+	{
+		allRight = allRight && bigMap.Contains(i) == (i % 2 == 1);
+	}
+	REQUIRE(allRight);
+
+	int64_t sum{};
+	uint32_t count{};
+	for (auto it = bigMap.CBegin(); it != bigMap.CEnd(); ++it)
+	{
+		sum += it->second;
+		++count;
+	}
+	REQUIRE(count == 5000);
+	REQUIRE(sum == int64_t{ 2 } * 25000000);
+
+	// Backward shift deletion leaves nothing behind, so churn never has to grow the table
+	Container::RobinHoodMap<int, int> churnMap{ 8 };
+	const uint32_t capacity = churnMap.Capacity();
+	for (int i{}; i < 100000; ++i)
+	{
+		churnMap[i] = i;
+		if (i >= 8)
+		{
+			churnMap.Erase(i - 8);
+		}
+	}
+	REQUIRE(churnMap.Size() == 8);
+	REQUIRE(churnMap.Capacity() == capacity);
+	REQUIRE(churnMap.At(99999) == 99999);
+	REQUIRE(!churnMap.Contains(99991));
+
+	Container::RobinHoodMap<std::string, std::string> stringMap{};
+	stringMap["one"] = "een";
+	stringMap["two"] = "twee";
+	Container::RobinHoodMap<std::string, std::string> copiedMap{ stringMap };
+	copiedMap.Erase(copiedMap.Find("one"));
+	REQUIRE(copiedMap.Size() == 1);
+	REQUIRE(stringMap.At("one") == "een");
+	Container::RobinHoodMap<std::string, std::string> movedMap{};
+	movedMap = std::move(stringMap);
+	REQUIRE(movedMap.At("two") == "twee");
+	REQUIRE(stringMap.Empty());
+	movedMap.Clear();
+	REQUIRE(!movedMap.Contains("two"));
+
+	// A stateful allocator gets passed on to the entries and stays through growing
+	using ArenaMap = Container::RobinHoodMap<int, int, std::hash<int>, std::equal_to<int>, Container::ArenaAllocator<std::pair<int, int>>>;
+	Container::Arena arena{};
+	Container::ArenaAllocator<std::pair<int, int>> arenaAllocator{ arena };
+	ArenaMap arenaMap{ arenaAllocator };
+	REQUIRE(arenaMap.GetAllocator() == arenaAllocator);
+	for (int i{}; i < 1000; ++i)
+	{
+		arenaMap.TryEmplace(i, i * 3);
+	}
+	REQUIRE(arenaMap.GetAllocator() == arenaAllocator);
+	REQUIRE(arenaMap.At(999) == 2997);
+	ArenaMap reservedMap{ 100, arenaAllocator };
+	REQUIRE(reservedMap.Capacity() >= 100);
+	REQUIRE(reservedMap.GetAllocator() == arenaAllocator);
+}
+#pragma endregion
+
+#pragma region ConcurrentUnorderedMap Tests
+TEST_CASE("ConcurrentUnorderedMap tests")
+{
+	Container::ConcurrentUnorderedMap<int, int> map{ 6 };
+	REQUIRE(map.ShardCount() == 8);
+	REQUIRE(map.Empty());
+	REQUIRE(map.Insert(1, 10));
+	REQUIRE(!map.Insert(1, 11));
+	REQUIRE(!map.InsertOrAssign(1, 12));
+	int found{};
+	REQUIRE(map.Find(1, found));
+	REQUIRE(found == 12);
+	REQUIRE(!map.Find(2, found));
+	REQUIRE(map.Upsert(2, 20, [](int& v) { v += 1; }));
+	REQUIRE(!map.Upsert(2, 20, [](int& v) { v += 1; }));
+	REQUIRE(map.Visit(2, [&found](const int& v) { found = v; }));
+	REQUIRE(found == 21);
+
+	int factoryCalls{};
+	REQUIRE(map.ComputeIfAbsent(3, [&factoryCalls]() { ++factoryCalls; return 30; }) == 30);
+	REQUIRE(map.ComputeIfAbsent(3, [&factoryCalls]() { ++factoryCalls; return 31; }) == 30);
+	REQUIRE(factoryCalls == 1);
+	REQUIRE(map.Size() == 3);
+	REQUIRE(map.Erase(3));
+	REQUIRE(!map.Contains(3));
+
+	// Threads counting into the same keys shouldn't lose any update
+	Container::ConcurrentUnorderedMap<int, int> counters{};
+	counters.Reserve(1000);
+	const int nrThreads = 8;
+	const int nrIncrements = 20000;
+	std::vector<std::thread> threads{};
+	for (int t{}; t < nrThreads; ++t)
+	{
+		threads.emplace_back([&counters, t]()
+			{
+				for (int i{}; i < nrIncrements; ++i)
+				{
+					counters.Upsert(i % 1000, 1, [](int& v) { ++v; });
+					counters.InsertOrAssign(100000 + t * nrIncrements + i, i);
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	bool allRight = counters.Size() == 1000 + nrThreads * nrIncrements;
+	for (int i{}; i < 1000; ++i)
+	{
+		int count{};
+		allRight = allRight && counters.Find(i, count) && count == nrThreads * nrIncrements / 1000;
+	}
+	REQUIRE(allRight);
+	counters.Clear();
+	REQUIRE(counters.Empty());
+}
+#pragma endregion
+
+#pragma region List Tests
+TEST_CASE("List tests")
+{
+	Container::List<int> list{};
+	REQUIRE(list.Empty());
+	list.PushBack(2);
+	list.PushBack(3);
+	list.PushFront(1);
+	REQUIRE(list.Size() == 3);
+	REQUIRE(list.Front() == 1);
+	REQUIRE(list.Back() == 3);
+
+	auto it = list.Begin();
+	++it;
+	it = list.Insert(it, 10);
+	REQUIRE(*it == 10);
+	it = list.Erase(it);
+	REQUIRE(*it == 2);
+	list.MoveToFront(it);
+	list.MoveToBack(list.Begin());
+	list.MoveToFront(list.Begin());
+	int expected[]{ 1, 3, 2 };
+	bool allRight = true;
+	int idx{};
+	for (auto value = list.CBegin(); value != list.CEnd(); ++value)
+	{
+		allRight = allRight && *value == expected[idx++];
+	}
+	REQUIRE(allRight);
+	REQUIRE(idx == 3);
+
+	// Erased nodes get reused, so a steady size list only allocates up front
+	Container::List<int> other{};
+	other.Reserve(4);
+	for (int i{}; i < 1000; ++i)
+	{
+		other.PushBack(i);
+		if (other.Size() > 4)
+		{
+			other.PopFront();
+		}
+	}
+	REQUIRE(other.Size() == 4);
+	REQUIRE(other.Front() == 996);
+
+	list.Splice(list.CEnd(), other);
+	REQUIRE(list.Size() == 7);
+	REQUIRE(other.Empty());
+	REQUIRE(list.Back() == 999);
+	other.Splice(other.CEnd(), list, list.CBegin());
+	REQUIRE(other.Front() == 1);
+	REQUIRE(list.Size() == 6);
+
+	Container::List<std::string> strings{};
+	strings.EmplaceBack(20, 'a');
+	strings.EmplaceFront("front");
+	Container::List<std::string> copied{ strings };
+	copied.PopBack();
+	REQUIRE(copied.Size() == 1);
+	REQUIRE(strings.Back() == std::string(20, 'a'));
+	Container::List<std::string> moved{ std::move(strings) };
+	REQUIRE(strings.Empty());
+	REQUIRE(moved.Front() == "front");
+	moved.Clear();
+	moved.ShrinkToFit();
+	REQUIRE(moved.Empty());
+	moved.PushBack("again");
+	REQUIRE(moved.Front() == "again");
+
+	// polymorphic allocators don't propagate, so moving between resources moves the elements instead of the nodes
+	using PmrList = Container::List<int, std::pmr::polymorphic_allocator<int>>;
+	alignas(std::max_align_t) std::byte firstBuffer[4 * 1024];
+	alignas(std::max_align_t) std::byte secondBuffer[4 * 1024];
+	std::pmr::monotonic_buffer_resource firstResource{ firstBuffer, sizeof(firstBuffer), std::pmr::null_memory_resource() };
+	std::pmr::monotonic_buffer_resource secondResource{ secondBuffer, sizeof(secondBuffer), std::pmr::null_memory_resource() };
+	PmrList firstList{ &firstResource };
+	PmrList secondList{ &secondResource };
+	for (int i{}; i < 10; ++i)
+	{
+		firstList.PushBack(i);
+	}
+	secondList = std::move(firstList);
+	REQUIRE(firstList.Empty());
+	REQUIRE(secondList.Size() == 10);
+	REQUIRE(secondList.Back() == 9);
+	const void* pNode = &secondList.Front();
+	REQUIRE((pNode >= secondBuffer && pNode < secondBuffer + sizeof(secondBuffer)));
+	firstList = secondList;
+	pNode = &firstList.Back();
+	REQUIRE((pNode >= firstBuffer && pNode < firstBuffer + sizeof(firstBuffer)));
+	PmrList sameResourceList{ &secondResource };
+	sameResourceList.PushBack(42);
+	sameResourceList.Swap(secondList);
+	REQUIRE(sameResourceList.Size() == 10);
+	REQUIRE(secondList.Front() == 42);
+
+	// Pool allocators propagate, the nodes go along with their pool
+	using PoolList = Container::List<std::string, Container::PoolAllocator<std::string>>;
+	PoolList firstPoolList{};
+	PoolList secondPoolList{};
+	firstPoolList.PushBack("first");
+	secondPoolList.PushBack("second");
+	secondPoolList.PushBack("third");
+	secondPoolList.PopBack(); // leaves a recycled node behind
+	firstPoolList.Swap(secondPoolList);
+	REQUIRE(firstPoolList.Front() == "second");
+	REQUIRE(secondPoolList.Front() == "first");
+	firstPoolList = secondPoolList;
+	REQUIRE(firstPoolList.Front() == "first");
+	secondPoolList = std::move(firstPoolList);
+	REQUIRE(secondPoolList.Size() == 1);
+	REQUIRE(firstPoolList.Empty());
+}
+
+namespace
+{
+	struct Job final : public Container::ListHook
+	{
+		explicit Job(int id) : id{ id } {}
+		int id;
+	};
+}
+
+TEST_CASE("IntrusiveList tests")
+{
+	Job jobs[]{ Job{ 0 }, Job{ 1 }, Job{ 2 }, Job{ 3 } };
+	Container::IntrusiveList<Job> queue{};
+	Container::IntrusiveList<Job> done{};
+	for (Job& job : jobs)
+	{
+		queue.PushBack(job);
+	}
+	REQUIRE(queue.Size() == 4);
+	REQUIRE(jobs[2].IsLinked());
+
+	queue.MoveToFront(jobs[3]);
+	queue.MoveToBack(jobs[0]);
+	REQUIRE(queue.Front().id == 3);
+	REQUIRE(queue.Back().id == 0);
+
+	done.Splice(done.CEnd(), queue, queue.IteratorTo(jobs[1]));
+	REQUIRE(done.Size() == 1);
+	REQUIRE(queue.Size() == 3);
+	REQUIRE(&queue.PopFront() == &jobs[3]);
+	REQUIRE(!jobs[3].IsLinked());
+
+	queue.Remove(jobs[2]);
+	done.Splice(done.CBegin(), queue);
+	REQUIRE(queue.Empty());
+	REQUIRE(done.Front().id == 0);
+	REQUIRE(done.Back().id == 1);
+
+	Container::IntrusiveList<Job> moved{ std::move(done) };
+	REQUIRE(moved.Size() == 2);
+	REQUIRE(done.Empty());
+	moved.Erase(moved.CBegin());
+	moved.Clear();
+	REQUIRE(!jobs[0].IsLinked());
+	REQUIRE(!jobs[1].IsLinked());
+}
+#pragma endregion
+
+#pragma region Allocator Tests
+TEST_CASE("PoolAllocator tests")
+{
+	static_assert(Container::IsAllocator<Container::PoolAllocator<int>, int>);
+	static_assert(Container::IsAllocator<std::allocator<int>, int>);
+	static_assert(!Container::IsAllocator<int, int>);
+
+	Container::PoolAllocator<uint64_t, 4096> allocator{};
+	uint64_t* pFirst = allocator.allocate(1);
+	uint64_t* pSecond = allocator.allocate(1);
+	REQUIRE(pFirst != pSecond);
+	REQUIRE(reinterpret_cast<uintptr_t>(pFirst) % alignof(uint64_t) == 0);
+	allocator.deallocate(pFirst, 1);
+	// the slot that was freed last gets handed out first
+	REQUIRE(allocator.allocate(1) == pFirst);
+	allocator.deallocate(pFirst, 1);
+	allocator.deallocate(pSecond, 1);
+	REQUIRE(allocator.State()->SlabCount() == 1);
+
+	// Rebinds share the pool, so memory can be returned through either of them
+	Container::PoolAllocator<std::pair<uint64_t, uint64_t>, 4096> rebound{ allocator };
+	REQUIRE(rebound == allocator);
+	REQUIRE(Container::PoolAllocator<uint64_t, 4096>{} != allocator);
+
+	Container::List<int, Container::PoolAllocator<int>> list{};
+	for (int i{}; i < 10000; ++i)
+	{
+		list.PushBack(i);
+	}
+	REQUIRE(list.Size() == 10000);
+	REQUIRE(list.Back() == 9999);
+
+	Container::Vector<int, Container::PoolAllocator<int>> vector{};
+	for (int i{}; i < 1000; ++i)
+	{
+		vector.PushBack(i);
+	}
+	REQUIRE(vector[999] == 999);
+
+	Container::UnorderedMap<int, std::string, std::hash<int>, std::equal_to<int>, Container::PoolAllocator<std::pair<int, std::string>>> map{};
+	map[1] = "one";
+	map[2] = "two";
+	REQUIRE(map.At(2) == "two");
+
+	std::list<std::string, Container::PoolAllocator<std::string>> stdList{};
+	stdList.push_back("pooled");
+	stdList.push_front("node");
+	REQUIRE(stdList.size() == 2);
+}
+
+TEST_CASE("ArenaAllocator tests")
+{
+	static_assert(Container::IsAllocator<Container::ArenaAllocator<int>, int>);
+
+	Container::Arena arena{ 4096 };
+	Container::ArenaAllocator<int> allocator{ arena };
+	REQUIRE(arena.BlockCount() == 0);
+
+	const Container::Arena::Marker start = arena.GetMarker();
+	int* pFirst = allocator.allocate(4);
+	int* pSecond = allocator.allocate(4);
+	REQUIRE(pSecond == pFirst + 4);
+	REQUIRE(arena.BlockCount() == 1);
+	REQUIRE(reinterpret_cast<uintptr_t>(allocator.allocate(1)) % alignof(int) == 0);
+	REQUIRE(reinterpret_cast<uintptr_t>(Container::ArenaAllocator<double>{ allocator }.allocate(1)) % alignof(double) == 0);
+
+	// Rewinding hands out the same memory again
+	arena.Rewind(start);
+	REQUIRE(allocator.allocate(4) == pFirst);
+	arena.Reset();
+
+	{
+		// The newest allocation grows in place, so pushing back never copies
+		Container::ArenaScope scope{ arena };
+		Container::Vector<int, Container::ArenaAllocator<int>> vector{ allocator };
+		const int* pData = vector.Data();
+		bool allRight = true;
+		for (int i{}; i < 512; ++i)
+		{
+			vector.PushBack(i);
+			allRight = allRight && vector.Data() == pData;
+		}
+		REQUIRE(allRight);
+		REQUIRE(vector.Capacity() >= 512);
+		REQUIRE(vector[511] == 511);
+
+		// Once something else is allocated after it the vector has to move
+		Container::Vector<int, Container::ArenaAllocator<int>> other{ allocator };
+		other.PushBack(1);
+		while (vector.Size() < vector.Capacity())
+		{
+			vector.PushBack(0);
+		}
+		vector.PushBack(0);
+		REQUIRE(vector.Data() != pData);
+		REQUIRE(vector[511] == 511);
+	}
+
+	// Going past a block chains a new one, and after a rewind the spare blocks get reused
+	const uint32_t blockCount = arena.BlockCount();
+	REQUIRE(blockCount > 1);
+	{
+		Container::ArenaScope scope{ arena };
+		(void)allocator.allocate(900);
+		(void)allocator.allocate(900);
+	}
+	REQUIRE(arena.BlockCount() == blockCount);
+	void* pBig = arena.Allocate(100000, 16);
+	REQUIRE(pBig != nullptr);
+	REQUIRE(arena.BlockCount() == blockCount + 1);
+}
+
+TEST_CASE("ThreadCachingAllocator tests")
+{
+	static_assert(Container::IsAllocator<Container::ThreadCachingAllocator<int>, int>);
+	static_assert(Container::ThreadCaching::ClassIndex(1) == 0);
+	static_assert(Container::ThreadCaching::ClassIndex(16) == 0);
+	static_assert(Container::ThreadCaching::ClassIndex(17) == 1);
+	static_assert(Container::ThreadCaching::ClassIndex(4096) == Container::ThreadCaching::ClassCount - 1);
+
+	Container::ThreadCachingAllocator<uint64_t> allocator{};
+	uint64_t* pFirst = allocator.allocate(3);
+	REQUIRE(reinterpret_cast<uintptr_t>(pFirst) % 16 == 0);
+	allocator.deallocate(pFirst, 3);
+	// the same size class hands the freed slot straight back
+	REQUIRE(allocator.allocate(4) == pFirst);
+	allocator.deallocate(pFirst, 4);
+	REQUIRE(Container::ThreadCachingAllocator<char>{ allocator } == allocator);
+
+	// too big for a slot
+	uint64_t* pBig = allocator.allocate(1000);
+	pBig[999] = 1;
+	allocator.deallocate(pBig, 1000);
+
+	// Memory allocated on one thread and freed on another
+	const uint32_t count = 5000;
+	std::vector<uint32_t*> allocated(count);
+	std::thread producer{ [&allocated]()
+		{
+			Container::ThreadCachingAllocator<uint32_t> threadAllocator{};
+			for (uint32_t i{}; i < allocated.size(); ++i)
+			{
+				allocated[i] = threadAllocator.allocate(1 + i % 64);
+				allocated[i][0] = i;
+			}
+		} };
+	producer.join();
+	bool allRight = true;
+	Container::ThreadCachingAllocator<uint32_t> mainAllocator{};
+	for (uint32_t i{}; i < count; ++i)
+	{
+		allRight = allRight && allocated[i][0] == i;
+		mainAllocator.deallocate(allocated[i], 1 + i % 64);
+	}
+	REQUIRE(allRight);
+
+	// Vectors growing on several threads at once
+	std::vector<std::thread> threads{};
+	std::atomic<uint32_t> failures{ 0 };
+	for (uint32_t threadIdx{}; threadIdx < 4; ++threadIdx)
+	{
+		threads.emplace_back([&failures, threadIdx]()
+			{
+				for (uint32_t round{}; round < 200; ++round)
+				{
+					Container::Vector<uint32_t, Container::ThreadCachingAllocator<uint32_t>> vector{};
+					for (uint32_t i{}; i < round; ++i)
+					{
+						vector.PushBack(i * threadIdx);
+					}
+					for (uint32_t i{}; i < round; ++i)
+					{
+						if (vector[i] != i * threadIdx)
+						{
+							failures.fetch_add(1);
+						}
+					}
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	REQUIRE(failures.load() == 0);
+	REQUIRE(Container::ThreadCaching::CentralPool::Get().SlabCount() > 0);
+
+	// A thread_local map only allocates after it is constructed, so the thread destroys the cache before the map.
+	// Its slots still have to get back to the central pool, otherwise every thread would need new slabs
+	const auto threadLocalMap = []()
+		{
+			std::thread{ []()
+				{
+					using ThreadLocalMap = Container::UnorderedMap<int, int, std::hash<int>, std::equal_to<int>, Container::ThreadCachingAllocator<std::pair<int, int>>>;
+					thread_local ThreadLocalMap map{};
+					for (int i{}; i < 400; ++i)
+					{
+						map.TryEmplace(i, i);
+					}
+				} }.join();
+		};
+	threadLocalMap();
+	const uint32_t slabCount = Container::ThreadCaching::CentralPool::Get().SlabCount();
+	for (uint32_t i{}; i < 40; ++i)
+	{
+		threadLocalMap();
+	}
+	REQUIRE(Container::ThreadCaching::CentralPool::Get().SlabCount() == slabCount);
+}
+
+TEST_CASE("Vector allocator awareness tests")
+{
+	using ArenaVector = Container::Vector<std::string, Container::ArenaAllocator<std::string>>;
+	Container::Arena firstArena{};
+	Container::Arena secondArena{};
+	Container::ArenaAllocator<std::string> firstAllocator{ firstArena };
+	Container::ArenaAllocator<std::string> secondAllocator{ secondArena };
+
+	ArenaVector source{ firstAllocator };
+	for (int i{}; i < 20; ++i)
+	{
+		source.PushBack(std::to_string(i) + " is a string that doesn't fit in the small buffer");
+	}
+
+	// Copies keep using the arena of the original
+	ArenaVector copy{ source };
+	REQUIRE(copy.GetAllocator() == firstAllocator);
+	REQUIRE(copy.Data() != source.Data());
+	REQUIRE(copy[19] == source[19]);
+
+	// The allocator extended constructors put the copy somewhere else
+	ArenaVector otherCopy{ source, secondAllocator };
+	REQUIRE(otherCopy.GetAllocator() == secondAllocator);
+	REQUIRE(otherCopy[5] == source[5]);
+
+	// Arena allocators don't propagate, so moving between arenas moves the elements instead of the buffer
+	ArenaVector moved{ secondAllocator };
+	moved = std::move(copy);
+	REQUIRE(moved.GetAllocator() == secondAllocator);
+	REQUIRE(moved.Size() == 20);
+	REQUIRE(moved[19] == source[19]);
+	REQUIRE(copy.Empty());
+
+	ArenaVector movedConstructed{ std::move(otherCopy), firstAllocator };
+	REQUIRE(movedConstructed.GetAllocator() == firstAllocator);
+	REQUIRE(movedConstructed[0] == source[0]);
+
+	// With equal allocators the buffer itself changes hands
+	const std::string* pSourceData = source.Data();
+	ArenaVector stolen{ std::move(source), firstAllocator };
+	REQUIRE(stolen.Data() == pSourceData);
+
+	// Pool allocators propagate on copy assignment and swap
+	using PoolVector = Container::Vector<int, Container::PoolAllocator<int>>;
+	PoolVector first{};
+	PoolVector second{};
+	first.PushBack(1);
+	second.PushBack(2);
+	second.PushBack(3);
+	REQUIRE(first.GetAllocator() != second.GetAllocator());
+	const Container::PoolAllocator<int> firstPool = first.GetAllocator();
+	const Container::PoolAllocator<int> secondPool = second.GetAllocator();
+	first.Swap(second);
+	REQUIRE(first.GetAllocator() == secondPool);
+	REQUIRE(second.GetAllocator() == firstPool);
+	REQUIRE(first.Size() == 2);
+	first = second;
+	REQUIRE(first.GetAllocator() == firstPool);
+	REQUIRE(first[0] == 1);
+
+	// Stateless allocators keep working the way they did
+	Container::Vector<int> plain(3, 7);
+	Container::Vector<int> plainCopy{};
+	plainCopy = plain;
+	plainCopy.Swap(plain);
+	REQUIRE(plain[2] == 7);
+}
+
+TEST_CASE("pmr Vector tests")
+{
+	static_assert(std::uses_allocator_v<Container::pmr::Vector<int>, std::pmr::polymorphic_allocator<Container::pmr::Vector<int>>>);
+
+	// Everything has to fit in the buffer, the upstream resource throws on any allocation
+	alignas(std::max_align_t) std::byte buffer[64 * 1024];
+	std::pmr::monotonic_buffer_resource resource{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+	// and nothing may sneak out through the default resource either
+	std::pmr::memory_resource* pOldDefault = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+	const auto inBuffer = [&buffer](const void* pData)
+		{
+			return pData >= buffer && pData < buffer + sizeof(buffer);
+		};
+
+	{
+		Container::pmr::Vector<Container::pmr::Vector<int>> outer{ &resource };
+		bool allRight = true;
+		for (int i{}; i < 16; ++i)
+		{
+			outer.EmplaceBack();
+			for (int j{}; j <= i; ++j)
+			{
+				outer.Back().PushBack(j);
+			}
+		}
+		// copies of whole inner vectors get the outer allocator too
+		outer.PushBack(outer[3]);
+		outer.Insert(outer.CBegin(), outer[15]);
+		outer.Resize(20);
+		for (uint32_t i{}; i < outer.Size(); ++i)
+		{
+			allRight = allRight && outer[i].GetAllocator().resource() == &resource && inBuffer(outer[i].Data());
+		}
+		REQUIRE(allRight);
+		REQUIRE(inBuffer(outer.Data()));
+		REQUIRE(outer[0].Size() == 16);
+		REQUIRE(outer[17].Size() == 4);
+		REQUIRE(outer[19].Empty());
+
+		// std::pmr containers pass their resource on to ours the same way
+		std::pmr::vector<Container::pmr::Vector<int>> stdOuter{ &resource };
+		stdOuter.emplace_back();
+		stdOuter.back().PushBack(42);
+		REQUIRE(stdOuter.back().GetAllocator().resource() == &resource);
+		REQUIRE(inBuffer(stdOuter.back().Data()));
+	}
+
+	std::pmr::set_default_resource(pOldDefault);
+}
+
+TEST_CASE("AlignedAllocator tests")
+{
+	static_assert(Container::IsAllocator<Container::AlignedAllocator<float>, float>);
+	static_assert(Container::AlignedAllocator<float>::RoundCapacity(1) == 16);
+	static_assert(Container::AlignedAllocator<float>::RoundCapacity(16) == 16);
+	static_assert(Container::AlignedAllocator<float>::RoundCapacity(17) == 32);
+	// 12 byte elements don't divide a cache line, the capacity still covers whole lines
+	static_assert(Container::AlignedAllocator<std::array<int, 3>>::RoundCapacity(1) == 5);
+	static_assert(Container::AlignedAllocator<double, 32>::Alignment == 32);
+
+	Container::Vector<float, Container::AlignedAllocator<float>> vector{};
+	REQUIRE(vector.Capacity() == 16);
+	bool allRight = true;
+	for (int i{}; i < 1000; ++i)
+	{
+		vector.PushBack(static_cast<float>(i));
+		allRight = allRight && reinterpret_cast<uintptr_t>(vector.Data()) % 64 == 0 && vector.Capacity() * sizeof(float) % 64 == 0;
+	}
+	REQUIRE(allRight);
+	REQUIRE(vector[999] == 999.f);
+
+	vector.Resize(70);
+	vector.ShrinkToFit();
+	REQUIRE(vector.Capacity() == 80);
+	REQUIRE(reinterpret_cast<uintptr_t>(vector.Data()) % 64 == 0);
+
+	Container::Vector<double, Container::AlignedAllocator<double, 32>> sized(5, 1.5);
+	REQUIRE(sized.Capacity() == 8);
+	REQUIRE(reinterpret_cast<uintptr_t>(sized.Data()) % 32 == 0);
+	Container::Vector<double, Container::AlignedAllocator<double, 32>> copy{ sized };
+	REQUIRE(reinterpret_cast<uintptr_t>(copy.Data()) % 32 == 0);
+	REQUIRE(copy[4] == 1.5);
+}
+
+struct TelemetryTestTag
+{
+	static constexpr const char* Name = "Telemetry test";
+};
+
+TEST_CASE("TelemetryAllocator tests")
+{
+	using TelemetryVector = Container::Vector<int, Container::TelemetryAllocator<int, TelemetryTestTag>>;
+	static_assert(Container::IsAllocator<Container::TelemetryAllocator<int, TelemetryTestTag>, int>);
+
+	{
+		TelemetryVector vector{};
+		for (int i{}; i < 100; ++i)
+		{
+			vector.PushBack(i);
+		}
+	}
+	Container::Telemetry::Stats stats = Container::Telemetry::Collect<TelemetryTestTag>();
+	REQUIRE(std::string{ stats.pName } == "Telemetry test");
+	// 4, 8, 16, 32, 64 and 128 elements
+	REQUIRE(stats.allocations == 6);
+	REQUIRE(stats.deallocations == 6);
+	REQUIRE(stats.allocatedBytes == 252 * sizeof(int));
+	REQUIRE(stats.liveBytes == 0);
+	// the 128 element buffer gets allocated while the 64 element one is still alive
+	REQUIRE(stats.peakLiveBytes == 192 * sizeof(int));
+	REQUIRE(stats.reallocations == 5);
+	REQUIRE(stats.reallocatedBytes == (4 + 8 + 16 + 32 + 64) * sizeof(int));
+	REQUIRE(stats.reallocationHistogram[std::bit_width(128 * sizeof(int)) - 1] == 1);
+	REQUIRE(stats.destroyedContainers == 1);
+	REQUIRE(stats.slackBytes == 28 * sizeof(int));
+
+	// Counters from other threads get added when collecting
+	std::thread worker{ []()
+		{
+			TelemetryVector vector(10, 1);
+		} };
+	worker.join();
+	stats = Container::Telemetry::Collect<TelemetryTestTag>();
+	REQUIRE(stats.allocations == 7);
+	REQUIRE(stats.destroyedContainers == 2);
+	REQUIRE(stats.liveBytes == 0);
+
+	std::ostringstream report{};
+	Container::Telemetry::Report(report);
+	REQUIRE(report.str().find("Telemetry test") != std::string::npos);
+}
+
+TEST_CASE("Vector hooks tests")
+{
+	static_assert(Container::IsVectorHooks<Container::NoHooks>);
+	static_assert(Container::IsVectorHooks<Container::TraceHooks>);
+	// the default policy doesn't take any room
+	static_assert(sizeof(Container::Vector<int>) == sizeof(Container::Vector<int, std::allocator<int>, Container::TraceHooks>));
+
+	Container::TraceBuffer& trace = Container::TraceBuffer::Local();
+	trace.Clear();
+	Container::VectorEvent events[Container::TraceBuffer::Capacity]{};
+
+	Container::Vector<int, std::allocator<int>, Container::TraceHooks> vector{};
+	for (int i{}; i < 5; ++i)
+	{
+		vector.PushBack(i);
+	}
+	REQUIRE(trace.Count() == 1);
+	REQUIRE(trace.CopyRecent(events, 16) == 1);
+	REQUIRE(events[0].type == Container::VectorEventType::Reallocate);
+	REQUIRE(events[0].values[0] == 4);
+	REQUIRE(events[0].values[1] == 4);
+	REQUIRE(events[0].values[2] == 8);
+	REQUIRE(events[0].bytesMoved == 4 * sizeof(int));
+
+	vector.Insert(vector.CBegin() + 1, 3u, 7);
+	vector.Erase(vector.CBegin(), vector.CBegin() + 2);
+	vector.ShrinkToFit();
+	// pushing at the end doesn't shift anything
+	vector.PushBack(9);
+	REQUIRE(trace.Count() == 5);
+	REQUIRE(trace.CopyRecent(events, 16) == 5);
+	REQUIRE(events[1].type == Container::VectorEventType::InsertShift);
+	REQUIRE(events[1].values[0] == 1);
+	REQUIRE(events[1].values[1] == 3);
+	REQUIRE(events[1].bytesMoved == 4 * sizeof(int));
+	REQUIRE(events[2].type == Container::VectorEventType::EraseShift);
+	REQUIRE(events[2].values[0] == 0);
+	REQUIRE(events[2].values[1] == 2);
+	REQUIRE(events[2].bytesMoved == 6 * sizeof(int));
+	REQUIRE(events[3].type == Container::VectorEventType::Shrink);
+	REQUIRE(events[3].values[2] == 6);
+	REQUIRE(events[4].type == Container::VectorEventType::Reallocate);
+	REQUIRE(events[3].timestamp <= events[4].timestamp);
+
+	// Only the newest events are kept
+	for (uint32_t i{}; i < Container::TraceBuffer::Capacity; ++i)
+	{
+		vector.Insert(vector.CBegin(), 1);
+		vector.Erase(vector.CBegin());
+	}
+	REQUIRE(trace.CopyRecent(events, Container::TraceBuffer::Capacity) == Container::TraceBuffer::Capacity);
+	REQUIRE(events[Container::TraceBuffer::Capacity - 1].type == Container::VectorEventType::EraseShift);
+	REQUIRE(events[Container::TraceBuffer::Capacity - 2].type == Container::VectorEventType::InsertShift);
+	trace.Clear();
+}
+
+TEST_CASE("Benchmark comparison tests")
+{
+	std::vector<double> baseline{};
+	std::vector<double> shifted{};
+	for (uint32_t i{ 1 }; i <= 10; ++i)
+	{
+		baseline.push_back(i);
+		shifted.push_back(i + 20.0);
+	}
+
+	// Every shifted sample is bigger than every baseline sample
+	const Benchmark::MannWhitneyResult different = Benchmark::MannWhitneyU(baseline, shifted);
+	REQUIRE(different.u == 100.0);
+	REQUIRE(different.pValue < 0.001);
+	const Benchmark::MannWhitneyResult same = Benchmark::MannWhitneyU(baseline, baseline);
+	REQUIRE(same.u == 50.0);
+	REQUIRE(same.pValue == 1.0);
+
+	const Benchmark::ShiftEstimate shift = Benchmark::HodgesLehmann(baseline, shifted, 0.95);
+	REQUIRE(shift.estimate == 20.0);
+	REQUIRE(shift.lower <= 20.0);
+	REQUIRE(shift.upper >= 20.0);
+	REQUIRE(shift.lower > 10.0);
+
+	// Results survive a round trip through the JSON file
+	Benchmark::Options options{};
+	options.sampleCount = 9;
+	options.minSampleMs = 0.1;
+	options.warmupMs = 0.0;
+	options.readCounters = false;
+	Benchmark::Runner runner{ options, nullptr };
+	runner.Run("Sum \"quoted\"", [](uint64_t iterations)
+		{
+			uint64_t sum{};
+			for (uint64_t i{}; i < iterations; ++i)
+			{
+				sum += i;
+				Benchmark::DoNotOptimize(sum);
+			}
+		});
+	std::stringstream json{};
+	json << std::setprecision(17);
+	runner.WriteJson(json);
+	std::vector<Benchmark::Result> results{};
+	std::string error{};
+	REQUIRE(Benchmark::ReadJson(json, results, error));
+	REQUIRE(results.size() == 1);
+	REQUIRE(results[0].name == "Sum \"quoted\"");
+	REQUIRE(results[0].samples == runner.Results()[0].samples);
+	REQUIRE(results[0].stats.median == runner.Results()[0].stats.median);
+
+	// Benchmarks get paired by name, only a clear slowdown is a regression
+	Benchmark::Result fast{ "fast", 1, baseline, Benchmark::Summarize(baseline), {} };
+	Benchmark::Result slow{ "fast", 1, shifted, Benchmark::Summarize(shifted), {} };
+	Benchmark::Result removed{ "removed", 1, baseline, Benchmark::Summarize(baseline), {} };
+	std::vector<Benchmark::Comparison> comparisons = Benchmark::Compare({ fast, removed }, { slow, results[0] });
+	REQUIRE(comparisons.size() == 3);
+	REQUIRE(comparisons[0].verdict == Benchmark::Verdict::Regressed);
+	REQUIRE(comparisons[0].change > 1.0);
+	REQUIRE(comparisons[0].changeLower > 0.0);
+	REQUIRE(comparisons[1].verdict == Benchmark::Verdict::Added);
+	REQUIRE(comparisons[2].verdict == Benchmark::Verdict::Removed);
+	comparisons = Benchmark::Compare({ slow }, { fast });
+	REQUIRE(comparisons[0].verdict == Benchmark::Verdict::Improved);
+	comparisons = Benchmark::Compare({ fast }, { fast });
+	REQUIRE(comparisons[0].verdict == Benchmark::Verdict::Unchanged);
+	comparisons = Benchmark::Compare({ removed, removed }, {});
+	REQUIRE(comparisons.size() == 1);
+	REQUIRE(comparisons[0].verdict == Benchmark::Verdict::Removed);
+
+	std::stringstream twice{ "{ \"benchmarks\": [ { \"name\": \"x\", \"samples_ns\": [ 1 ] }, { \"name\": \"x\", \"samples_ns\": [ 2 ] } ] }" };
+	REQUIRE(!Benchmark::ReadJson(twice, results, error));
+	REQUIRE(error.find("twice") != std::string::npos);
+	std::stringstream noSamples{ "{ \"benchmarks\": [ { \"name\": \"x\" } ] }" };
+	REQUIRE(!Benchmark::ReadJson(noSamples, results, error));
+	REQUIRE(!error.empty());
+	std::stringstream newerVersion{ "{ \"version\": 2, \"benchmarks\": [] }" };
+	REQUIRE(!Benchmark::ReadJson(newerVersion, results, error));
+}
+
+TEST_CASE("LatencyHistogram tests")
+{
+	Benchmark::LatencyHistogram histogram{};
+	REQUIRE(histogram.Count() == 0);
+	REQUIRE(histogram.Percentile(99.0) == 0.0);
+
+	// Small values get a bucket each
+	for (uint64_t value{ 1 }; value <= 100; ++value)
+	{
+		histogram.Record(value);
+	}
+	REQUIRE(histogram.Count() == 100);
+	REQUIRE(histogram.Min() == 1.0);
+	REQUIRE(histogram.Max() == 100.0);
+	REQUIRE(histogram.Percentile(50.0) == 50.0);
+	REQUIRE(histogram.Percentile(99.0) == 99.0);
+	REQUIRE(histogram.Percentile(100.0) == 100.0);
+	REQUIRE(std::abs(histogram.Mean() - 50.5) < 0.001);
+
+	// Big values are within the precision of the sub buckets, and two outliers in 100000 show up in the far tail only
+	histogram.Reset();
+	for (uint32_t i{}; i < 99998; ++i)
+	{
+		histogram.Record(1000000 + i);
+	}
+	histogram.Record(UINT64_C(50000000000));
+	histogram.Record(UINT64_C(50000000000));
+	const double relativeError = 1.0 / (Benchmark::LatencyHistogram::SubBucketCount / 2);
+	REQUIRE(std::abs(histogram.Percentile(50.0) - 1050000.0) / 1050000.0 <= relativeError);
+	REQUIRE(histogram.Percentile(99.99) < 1100000.0 * (1.0 + relativeError));
+	REQUIRE(histogram.Percentile(99.999) == 50000000000.0);
+	REQUIRE(histogram.Max() == 50000000000.0);
+
+	Benchmark::LatencyHistogram other{};
+	other.Record(3);
+	other.Record(UINT64_MAX);
+	histogram.Merge(other);
+	REQUIRE(histogram.Count() == 100002);
+	REQUIRE(histogram.Min() == 3.0);
+	REQUIRE(histogram.Percentile(100.0) == static_cast<double>(UINT64_MAX));
+
+	// Ticks get converted to ns when reading
+	Benchmark::LatencyHistogram scaled{ 0.5 };
+	scaled.Record(200);
+	REQUIRE(scaled.Max() == 100.0);
+	REQUIRE(scaled.Percentile(50.0) == 100.0);
+
+	std::stringstream distribution{};
+	histogram.WriteDistribution(distribution);
+	REQUIRE(distribution.str().find("Total count    =       100002") != std::string::npos);
+	// the stream gets its own format back, whatever prints after the table isn't cut off
+	REQUIRE(distribution.precision() == 6);
+	REQUIRE((distribution.flags() & std::ios_base::floatfield) == std::ios_base::fmtflags{});
+}
+
+TEST_CASE("RealTimeVector tests")
+{
+	Container::RealTimeVector<uint32_t> vector{};
+	REQUIRE(vector.Empty());
+	REQUIRE(!vector.IsMigrating());
+
+	// Every element is readable at every point of a migration
+	bool allRight = true;
+	bool sawMigration = false;
+	for (uint32_t i{}; i < 5000; ++i)
+	{
+		vector.PushBack(i);
+		sawMigration = sawMigration || vector.IsMigrating();
+		allRight = allRight && vector.Back() == i && vector.Front() == 0;
+		if (i % 97 == 0)
+		{
+			for (uint32_t j{}; j <= i; ++j)
+			{
+				allRight = allRight && vector[j] == j;
+			}
+		}
+	}
+	REQUIRE(allRight);
+	REQUIRE(sawMigration);
+	REQUIRE(vector.Size() == 5000);
+	// the old elements are gone before the new buffer fills up, so a grow never waits for a migration
+	REQUIRE(vector.PendingMigration() <= vector.Capacity() - vector.Size());
+
+	// Popping into the part that is still in the old buffer
+	while (!vector.IsMigrating())
+	{
+		vector.PushBack(vector.Size());
+	}
+	const uint32_t pending = vector.PendingMigration();
+	const uint32_t size = vector.Size();
+	for (uint32_t i{}; i < size - 10; ++i)
+	{
+		vector.PopBack();
+	}
+	REQUIRE(vector.PendingMigration() < pending);
+	REQUIRE(vector.Size() == 10);
+	for (uint32_t i{}; i < 10; ++i)
+	{
+		allRight = allRight && vector[i] == i;
+	}
+	REQUIRE(allRight);
+
+	// Data finishes the migration and gives one contiguous buffer
+	while (!vector.IsMigrating())
+	{
+		vector.PushBack(vector.Size());
+	}
+	const uint32_t* pData = vector.Data();
+	REQUIRE(!vector.IsMigrating());
+	for (uint32_t i{}; i < vector.Size(); ++i)
+	{
+		allRight = allRight && pData[i] == i;
+	}
+	REQUIRE(allRight);
+
+	// Elements that own memory, copied and moved in the middle of a migration
+	Container::RealTimeVector<std::string> strings{};
+	for (uint32_t i{}; i < 300; ++i)
+	{
+		strings.PushBack(std::string(40, static_cast<char>('a' + i % 26)));
+	}
+	while (strings.Size() < strings.Capacity())
+	{
+		strings.PushBack(strings.Back());
+	}
+	strings.EmplaceBack(strings[0]); // a reference into the buffer that is about to become the old one
+	REQUIRE(strings.IsMigrating());
+	REQUIRE(strings.Back() == strings[0]);
+	const uint32_t stringCount = strings.Size();
+	Container::RealTimeVector<std::string> copy{ strings };
+	REQUIRE(copy.Size() == strings.Size());
+	REQUIRE(!copy.IsMigrating());
+	for (uint32_t i{}; i < copy.Size(); ++i)
+	{
+		allRight = allRight && copy[i] == strings[i];
+	}
+	REQUIRE(allRight);
+	Container::RealTimeVector<std::string> moved{ std::move(strings) };
+	REQUIRE(strings.Empty());
+	REQUIRE(moved[299] == std::string(40, static_cast<char>('a' + 299 % 26)));
+	strings = copy;
+	REQUIRE(strings.Size() == stringCount);
+	copy = std::move(moved);
+	REQUIRE(copy.Size() == stringCount);
+	copy.Clear();
+	REQUIRE(copy.Empty());
+
+	// short strings point into themselves, so they have to be moved one by one
+	Container::RealTimeVector<std::string> shortStrings{};
+	for (int i{}; i < 64 || shortStrings.Size() < shortStrings.Capacity(); ++i)
+	{
+		shortStrings.PushBack(std::to_string(i));
+	}
+	shortStrings.PushBack("last");
+	REQUIRE(shortStrings.IsMigrating());
+	REQUIRE(shortStrings[0] == "0");
+	REQUIRE(shortStrings[63] == "63");
+	shortStrings.Reserve(shortStrings.Capacity() * 2);
+	REQUIRE(!shortStrings.IsMigrating());
+	REQUIRE(shortStrings[50] == "50");
+	REQUIRE(shortStrings.Back() == "last");
+
+	// polymorphic allocators don't propagate, so moving between resources moves the elements instead of the buffers
+	using PmrRealTimeVector = Container::RealTimeVector<int, std::pmr::polymorphic_allocator<int>>;
+	alignas(std::max_align_t) std::byte firstBuffer[16 * 1024];
+	alignas(std::max_align_t) std::byte secondBuffer[16 * 1024];
+	std::pmr::monotonic_buffer_resource firstResource{ firstBuffer, sizeof(firstBuffer), std::pmr::null_memory_resource() };
+	std::pmr::monotonic_buffer_resource secondResource{ secondBuffer, sizeof(secondBuffer), std::pmr::null_memory_resource() };
+	PmrRealTimeVector firstInts{ &firstResource };
+	PmrRealTimeVector secondInts{ &secondResource };
+	for (int i{}; i < 128 || firstInts.Size() < firstInts.Capacity(); ++i) // more than one MigrationStep, so a migration is left running
+	{
+		firstInts.PushBack(i);
+	}
+	firstInts.PushBack(99);
+	REQUIRE(firstInts.IsMigrating());
+	const uint32_t intCount = firstInts.Size();
+	secondInts = std::move(firstInts);
+	REQUIRE(firstInts.Empty());
+	REQUIRE(secondInts.Size() == intCount);
+	REQUIRE(secondInts[intCount - 1] == 99);
+	REQUIRE(secondInts[1] == 1);
+	const void* pInt = &secondInts[0];
+	REQUIRE((pInt >= secondBuffer && pInt < secondBuffer + sizeof(secondBuffer)));
+	firstInts = secondInts;
+	pInt = &firstInts[50];
+	REQUIRE((pInt >= firstBuffer && pInt < firstBuffer + sizeof(firstBuffer)));
+	PmrRealTimeVector sameResourceInts{ &secondResource };
+	sameResourceInts.PushBack(42);
+	sameResourceInts.Swap(secondInts);
+	REQUIRE(sameResourceInts.Size() == intCount);
+	REQUIRE(secondInts[0] == 42);
+	REQUIRE(!copy.IsMigrating());
+
+	// Reserving up front means there is nothing to migrate
+	Container::RealTimeVector<uint32_t> reserved{};
+	reserved.Reserve(1000);
+	for (uint32_t i{}; i < 1000; ++i)
+	{
+		reserved.PushBack(i);
+		allRight = allRight && !reserved.IsMigrating();
+	}
+	REQUIRE(allRight);
+	REQUIRE(reserved.Capacity() == 1000);
+}
+
+TEST_CASE("PageAllocator tests")
+{
+	using Container::PageOptions;
+	REQUIRE(Container::HasOption(PageOptions::Prefault | PageOptions::Lock, PageOptions::Lock));
+	REQUIRE(!Container::HasOption(PageOptions::Prefault | PageOptions::Lock, PageOptions::HugePages));
+
+	// Every combination of options gives memory that works like any other, small buffers come from the heap
+	const PageOptions optionSets[]{ PageOptions::None, PageOptions::Prefault, PageOptions::HugePages,
+		PageOptions::Prefault | PageOptions::HugePages, PageOptions::Lock };
+	bool allRight = true;
+	for (PageOptions options : optionSets)
+	{
+		Container::PageAllocator<uint64_t> allocator{ options };
+		Container::Vector<uint64_t, Container::PageAllocator<uint64_t>> vector{ allocator };
+		REQUIRE(vector.GetAllocator().Options() == options);
+		const uint32_t count = 3 * Container::HugePageSize / sizeof(uint64_t) + 17;
+		vector.Reserve(count);
+		REQUIRE(vector.Capacity() >= count);
+		for (uint32_t i{}; i < count; ++i)
+		{
+			vector.PushBack(i * 3);
+		}
+		for (uint32_t i{}; i < count; ++i)
+		{
+			allRight = allRight && vector[i] == i * 3;
+		}
+		REQUIRE(reinterpret_cast<uintptr_t>(vector.Data()) % Container::PageSize() == 0);
+#if defined(__linux__)
+		// huge pages only get used in 2 MB aligned ranges
+		if (Container::HasOption(options, PageOptions::HugePages))
+		{
+			REQUIRE(reinterpret_cast<uintptr_t>(vector.Data()) % Container::HugePageSize == 0);
+		}
+#endif
+		vector.ShrinkToFit();
+		vector.Resize(10);
+		vector.ShrinkToFit();
+		REQUIRE(vector[9] == 27);
+	}
+	REQUIRE(allRight);
+
+	// Rebinding keeps the options
+	Container::PageAllocator<char> bytes{ PageOptions::Prefault };
+	Container::PageAllocator<double> doubles{ bytes };
+	REQUIRE(doubles.Options() == PageOptions::Prefault);
+	REQUIRE(doubles == bytes);
+
+	// Prefaulting keeps what is already in the buffer, on one or more threads
+	std::vector<uint8_t> buffer(Container::PageSize() * 100 + 3);
+	for (size_t i{}; i < buffer.size(); ++i)
+	{
+		buffer[i] = static_cast<uint8_t>(i * 7);
+	}
+	Container::PrefaultPages(buffer.data(), buffer.size(), 1);
+	Container::PrefaultPages(buffer.data() + 1, buffer.size() - 1, 4);
+	for (size_t i{}; i < buffer.size(); ++i)
+	{
+		allRight = allRight && buffer[i] == static_cast<uint8_t>(i * 7);
+	}
+	REQUIRE(allRight);
+	REQUIRE(Container::MinorPageFaults() != 0);
+}
+
+TEST_CASE("MemoryCopy tests")
+{
+	// Every size class, with every misalignment of source and destination within a cache line
+	const size_t nonTemporal = Container::NonTemporalThreshold();
+	std::vector<size_t> sizes{};
+	for (size_t size{}; size <= 300; ++size)
+	{
+		sizes.push_back(size);
+	}
+	for (size_t size : { size_t{ 1000 }, Container::RepMovsbThreshold - 1, Container::RepMovsbThreshold, size_t{ 100000 }, nonTemporal + 4099 })
+	{
+		sizes.push_back(size);
+	}
+
+	std::mt19937 generator{ 7 };
+	std::vector<uint8_t> source(nonTemporal + 4099 + 256);
+	for (uint8_t& byte : source)
+	{
+		byte = static_cast<uint8_t>(generator());
+	}
+	std::vector<uint8_t> dest(source.size());
+	bool copiesRight = true;
+	for (size_t size : sizes)
+	{
+		const size_t misalignments = size < nonTemporal ? 64 : 3;
+		for (size_t srcOffset{}; srcOffset < misalignments; srcOffset += 7)
+		{
+			for (size_t destOffset{}; destOffset < misalignments; destOffset += 5)
+			{
+				std::fill(dest.begin(), dest.begin() + size + 128, uint8_t{ 0xCD });
+				Container::CopyBytes(dest.data() + destOffset, source.data() + srcOffset, size);
+				copiesRight = copiesRight && std::memcmp(dest.data() + destOffset, source.data() + srcOffset, size) == 0;
+				// nothing written around the destination
+				copiesRight = copiesRight && (destOffset == 0 || dest[destOffset - 1] == 0xCD) && dest[destOffset + size] == 0xCD;
+			}
+		}
+	}
+	REQUIRE(copiesRight);
+
+	// Overlapping moves in both directions, against memmove
+	bool movesRight = true;
+	std::vector<uint8_t> buffer(300000);
+	std::vector<uint8_t> expected(buffer.size());
+	for (size_t size : { size_t{ 1 }, size_t{ 15 }, size_t{ 33 }, size_t{ 64 }, size_t{ 65 }, size_t{ 129 }, size_t{ 300 }, size_t{ 4095 }, size_t{ 5000 }, size_t{ 100000 } })
+	{
+		for (size_t shift : { size_t{ 1 }, size_t{ 7 }, size_t{ 32 }, size_t{ 100 }, size_t{ 4000 } })
+		{
+			for (bool up : { false, true })
+			{
+				std::copy(source.begin(), source.begin() + buffer.size(), buffer.begin());
+				expected = buffer;
+				uint8_t* pSrc = buffer.data() + 64 + (up ? 0 : shift);
+				uint8_t* pDest = buffer.data() + 64 + (up ? shift : 0);
+				Container::MoveBytes(pDest, pSrc, size);
+				std::memmove(expected.data() + (pDest - buffer.data()), expected.data() + (pSrc - buffer.data()), size);
+				movesRight = movesRight && buffer == expected;
+			}
+		}
+	}
+	REQUIRE(movesRight);
+
+	// the features are looked up once and stay the same
+	const Container::CpuFeatures& features = Container::GetCpuFeatures();
+	REQUIRE(&features == &Container::GetCpuFeatures());
+	REQUIRE((!features.avx512 || features.avx2));
+}
+
+template<typename element>
+bool FindKernelsAgree(Container::SimdTier tier)
+{
+	// the wanted value at every position of every length, and once nowhere
+	bool allRight = true;
+	std::vector<element> values(300);
+	for (size_t i{}; i < values.size(); ++i)
+	{
+		values[i] = static_cast<element>(i % 7 + 1);
+	}
+	const element wanted = static_cast<element>(0xA5A5A5A5A5A5A5A5ull);
+	const uint64_t pattern = Container::Detail::RepeatPattern(wanted);
+	const Container::Detail::FindKernel kernel = Container::Detail::FindKernels<element>[static_cast<uint32_t>(tier)];
+	for (size_t count{}; count < 200; ++count)
+	{
+		allRight = allRight && kernel(values.data() + 1, pattern, count) == count;
+		for (size_t position{}; position < count; ++position)
+		{
+			values[1 + position] = wanted;
+			allRight = allRight && kernel(values.data() + 1, pattern, count) == position;
+			values[1 + position] = static_cast<element>(position % 7 + 1);
+		}
+	}
+	return allRight;
+}
+
+TEST_CASE("CPU dispatch tests")
+{
+	using Container::SimdTier;
+	SimdTier tier{};
+	REQUIRE(Container::ParseTier("avx2", tier));
+	REQUIRE(tier == SimdTier::Avx2);
+	REQUIRE(Container::ParseTier("scalar", tier));
+	REQUIRE(tier == SimdTier::Scalar);
+	REQUIRE(!Container::ParseTier("avx3", tier));
+	REQUIRE(static_cast<uint32_t>(Container::ActiveTier()) <= static_cast<uint32_t>(Container::SupportedTier()));
+
+	// Every kernel of every tier this CPU can run gives the same results as the scalar one
+	std::mt19937 generator{ 11 };
+	std::vector<uint8_t> source(1024);
+	for (uint8_t& byte : source)
+	{
+		byte = static_cast<uint8_t>(generator());
+	}
+	for (uint32_t tierIndex{}; tierIndex <= static_cast<uint32_t>(Container::SupportedTier()); ++tierIndex)
+	{
+		const SimdTier current = static_cast<SimdTier>(tierIndex);
+		bool fillRight = true;
+		bool equalRight = true;
+		bool copyRight = true;
+		for (size_t bytes{}; bytes < 400; bytes += 8)
+		{
+			for (size_t offset{}; offset < 8; ++offset)
+			{
+				std::vector<uint8_t> filled(bytes + 32, 0xCD);
+				std::vector<uint8_t> expected(bytes + 32, 0xCD);
+				Container::Detail::FillKernels[tierIndex](filled.data() + offset, 0x0102030405060708ull, bytes);
+				Container::Detail::FillScalar(expected.data() + offset, 0x0102030405060708ull, bytes);
+				fillRight = fillRight && filled == expected;
+
+				std::vector<uint8_t> copy(source.begin() + offset, source.begin() + offset + bytes + 1);
+				const Container::Detail::EqualKernel equal = Container::Detail::EqualKernels[tierIndex];
+				equalRight = equalRight && equal(copy.data(), source.data() + offset, bytes);
+				if (bytes > 0)
+				{
+					// one differing bit anywhere has to be found
+					const size_t position = generator() % bytes;
+					copy[position] ^= 0x10;
+					equalRight = equalRight && !equal(copy.data(), source.data() + offset, bytes);
+					copy[position] ^= 0x10;
+				}
+
+				// the copy kernels only get what CopyBytes doesn't do inline
+				if (bytes > Container::TinyCopyBytes)
+				{
+					std::vector<uint8_t> copied(bytes + 32, 0);
+					Container::Detail::CopyKernels[tierIndex](reinterpret_cast<char*>(copied.data()) + offset, reinterpret_cast<const char*>(source.data()), bytes);
+					copyRight = copyRight && std::memcmp(copied.data() + offset, source.data(), bytes) == 0;
+				}
+			}
+		}
+		INFO("tier " << Container::SimdTierNames[tierIndex]);
+		REQUIRE(fillRight);
+		REQUIRE(equalRight);
+		REQUIRE(copyRight);
+		REQUIRE(FindKernelsAgree<uint8_t>(current));
+		REQUIRE(FindKernelsAgree<uint16_t>(current));
+		REQUIRE(FindKernelsAgree<uint32_t>(current));
+		REQUIRE(FindKernelsAgree<uint64_t>(current));
+	}
+
+	// The algorithms on top of the kernels
+	Container::Vector<uint16_t> shorts(37, 0xBEEF);
+	REQUIRE(Container::Find(shorts.Data(), shorts.Size(), uint16_t{ 0xBEEF }) == 0);
+	shorts.Insert(shorts.Begin() + 5, 3, uint16_t{ 0xBEEF });
+	REQUIRE(shorts.Size() == 40);
+	shorts[30] = 7;
+	REQUIRE(Container::Find(shorts.Data(), shorts.Size(), uint16_t{ 7 }) == 30);
+	REQUIRE(Container::Find(shorts.Data(), shorts.Size(), uint16_t{ 8 }) == 40);
+	Container::Vector<uint16_t> otherShorts{ shorts };
+	REQUIRE(Container::Equal(shorts.Data(), otherShorts.Data(), shorts.Size()));
+	otherShorts[39] = 0;
+	REQUIRE(!Container::Equal(shorts.Data(), otherShorts.Data(), shorts.Size()));
+
+	// doubles compare with ==, not bit for bit
+	const double zeros[]{ 0.0, 1.5 };
+	const double negativeZeros[]{ -0.0, 1.5 };
+	REQUIRE(Container::Equal(zeros, negativeZeros, 2));
+	REQUIRE(Container::Find(negativeZeros, 2, 0.0) == 0);
+
+	Container::BitVector<> bits(1000);
+	Container::BitVector<> otherBits(1000);
+	bits.Set(999);
+	REQUIRE(bits != otherBits);
+	otherBits.Set(999);
+	REQUIRE(bits == otherBits);
+}
+#pragma endregion
+#endif // Testing
+
+#ifdef Benchmarking
+void PushBackBench(Benchmark::Runner& runner);
+void PushBackLatencyBench();
+void ResizeBench(Benchmark::Runner& runner);
+void BitVectorBench(Benchmark::Runner& runner);
+void FlatMapBench();
+void StaticSearchIndexBench();
+void UnorderedMapBench();
+void HashMapChurnBench();
+void ConcurrentMapBench();
+void ListBench();
+void PoolAllocatorBench();
+void ArenaBench();
+void ThreadCachingAllocatorBench();
+void AlignedVectorBench();
+void VectorMatrixBench();
+void PageAllocatorBench();
+void MemoryCopyBench(Benchmark::Runner& runner);
+void SimdDispatchBench(Benchmark::Runner& runner);
+
+class Timer
+{
+
+public:
+	Timer()
+		: m_StartPoint{}
+	{
+
+	}
+
+	~Timer()
+	{
+	}
+
+	void Start()
+	{
+		m_StartPoint = std::chrono::high_resolution_clock::now();
+	}
+
+	double Stop()
+	{
+		auto endTimePoint = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(endTimePoint - m_StartPoint).count();
+	}
+private:
+
+	std::chrono::time_point<std::chrono::high_resolution_clock> m_StartPoint;
+};
+
+#pragma region  Pushback Benchmarking
+void PushBackBench(Benchmark::Runner& runner)
+{
+	// constructing and reserving is part of the timed work for both vectors
+	const int nrPushes = 1000;
+	runner.Run("PushBack/Container::Vector<int>/1000 reserved", [](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				Container::Vector<int> vec{};
+				vec.Reserve(nrPushes);
+				for (int i = 0; i < nrPushes; ++i)
+				{
+					vec.PushBack(i);
+				}
+				Benchmark::DoNotOptimize(vec.Data());
+				Benchmark::ClobberMemory();
+			}
+		});
+
+	runner.Run("PushBack/std::vector<int>/1000 reserved", [](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				std::vector<int> vec{};
+				vec.reserve(nrPushes);
+				for (int i = 0; i < nrPushes; ++i)
+				{
+					vec.push_back(i);
+				}
+				Benchmark::DoNotOptimize(vec.data());
+				Benchmark::ClobberMemory();
+			}
+		});
+}
+
+// Times every single push into a histogram instead of the whole loop, so the few pushes that reallocate end up in the
+// tail instead of getting averaged away. Every round starts from an empty vector and grows it through all its reallocations
+template<typename vector, typename pushBack>
+Benchmark::LatencyHistogram PushBackLatency(uint32_t roundCount, uint32_t pushCount, pushBack push)
+{
+	Benchmark::LatencyHistogram histogram{ Benchmark::CycleClock::NsPerTick() };
+	for (uint32_t round{}; round < roundCount; ++round)
+	{
+		vector vec{};
+		for (uint32_t i{}; i < pushCount; ++i)
+		{
+			const uint64_t start = Benchmark::CycleClock::Now();
+			push(vec, i);
+			histogram.Record(Benchmark::CycleClock::Now() - start);
+		}
+		Benchmark::DoNotOptimize(vec);
+	}
+	return histogram;
+}
+
+void WriteLatencyHistogram(const Benchmark::LatencyHistogram& histogram, const std::string& fileName)
+{
+	std::ofstream file{ fileName };
+	if (!file)
+	{
+		std::cout << "Couldn't write " << fileName << std::endl;
+		return;
+	}
+	histogram.WriteDistribution(file);
+}
+
+void PushBackLatencyBench() // worst case frame time: how long the slowest single PushBack takes
+{
+	std::cout << "*** PushBack latency test ***\n";
+
+	const uint32_t roundCount = 20;
+	const uint32_t pushCount = 4000000; // the last reallocation copies 8 MB
+
+	// two clock reads back to back, every measurement below includes this
+	Benchmark::LatencyHistogram overhead{ Benchmark::CycleClock::NsPerTick() };
+	for (uint32_t i{}; i < pushCount; ++i)
+	{
+		const uint64_t start = Benchmark::CycleClock::Now();
+		overhead.Record(Benchmark::CycleClock::Now() - start);
+	}
+
+	const Benchmark::LatencyHistogram ours = PushBackLatency<Container::Vector<int>>(roundCount, pushCount,
+		[](Container::Vector<int>& vec, uint32_t i) { vec.PushBack(static_cast<int>(i)); });
+	const Benchmark::LatencyHistogram theirs = PushBackLatency<std::vector<int>>(roundCount, pushCount,
+		[](std::vector<int>& vec, uint32_t i) { vec.push_back(static_cast<int>(i)); });
+	const Benchmark::LatencyHistogram realTime = PushBackLatency<Container::RealTimeVector<int>>(roundCount, pushCount,
+		[](Container::RealTimeVector<int>& vec, uint32_t i) { vec.PushBack(static_cast<int>(i)); });
+
+	std::cout << roundCount << " rounds of " << pushCount << " pushes into an empty vector\n";
+	std::cout << "\tclock overhead:     ";
+	overhead.PrintSummary(std::cout);
+	std::cout << "\tContainer::Vector:  ";
+	ours.PrintSummary(std::cout);
+	std::cout << "\tstd::vector:        ";
+	theirs.PrintSummary(std::cout);
+	std::cout << "\tRealTimeVector:     ";
+	realTime.PrintSummary(std::cout);
+	WriteLatencyHistogram(ours, "pushback_latency_Vector.hgrm");
+	WriteLatencyHistogram(theirs, "pushback_latency_std_vector.hgrm");
+	WriteLatencyHistogram(realTime, "pushback_latency_RealTimeVector.hgrm");
+}
+#pragma endregion
+
+#pragma region Resize benchmark
+void ResizeBench(Benchmark::Runner& runner) // to check how fast the reallocate functions are comparered to std::vector
+{
+	const uint32_t size = 100000;
+
+	Container::Vector<int> myVec{};
+	myVec.PushBack(0);
+	runner.Run("Resize/Container::Vector<int>/Reserve 100000 + ShrinkToFit", [&myVec](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				myVec.Reserve(size);
+				myVec.ShrinkToFit();
+				Benchmark::DoNotOptimize(myVec.Data());
+			}
+		});
+
+	std::vector<int> stlVec{};
+	stlVec.push_back(0);
+	runner.Run("Resize/std::vector<int>/reserve 100000 + shrink_to_fit", [&stlVec](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				stlVec.reserve(size);
+				stlVec.shrink_to_fit();
+				Benchmark::DoNotOptimize(stlVec.data());
+			}
+		});
+
+	// Results on my reallocation are generally slightly slower than std::vector
+	// I think the reallocation isn't actually faster but the shrink to fit in std::vector checks if the vector is empty
+	// and deletes all data instead of reallocating 
+	// When I try to do the same test with 1 element in the vector mine is faster
+	// I am considering copying what STL does but it seems like an edge case and 
+	// will cause branching in all other cases which can actually be a performance loss
+}
+#pragma endregion
+
+#pragma region BitVector benchmark
+void BitVectorBench(Benchmark::Runner& runner) // counting and combining flags, Vector<bool> spends a byte per flag
+{
+	const uint32_t size = 1 << 22;
+
+	Container::Vector<bool> byteFlags{ size, false };
+	Container::Vector<bool> byteMask{ size, false };
+	Container::BitVector<> bitFlags{ size };
+	Container::BitVector<> bitMask{ size };
+	for (uint32_t i{}; i < size; ++i)
+	{
+		const bool flag = (i * 2654435761u) % 7 < 3;
+		const bool mask = i % 5 != 0;
+		byteFlags[i] = flag;
+		byteMask[i] = mask;
+		bitFlags.Set(i, flag);
+		bitMask.Set(i, mask);
+	}
+
+	uint32_t byteCount{};
+	runner.Run("BitVector/Vector<bool>/and + count 4M flags", [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				for (uint32_t i{}; i < size; ++i)
+				{
+					byteFlags[i] = byteFlags[i] && byteMask[i];
+				}
+				for (uint32_t i{}; i < size; ++i)
+				{
+					byteCount += byteFlags[i];
+				}
+				Benchmark::DoNotOptimize(byteCount);
+			}
+		});
+
+	uint32_t bitCount{};
+	runner.Run("BitVector/BitVector/and + count 4M flags", [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				bitFlags &= bitMask;
+				bitCount += bitFlags.Count();
+				Benchmark::DoNotOptimize(bitCount);
+			}
+		});
+	// both ran a different amount of iterations, so the flags get compared instead of the running counts
+	uint32_t byteFlagCount{};
+	for (uint32_t i{}; i < size; ++i)
+	{
+		byteFlagCount += byteFlags[i];
+	}
+	std::cout << "Counts match:\t" << (byteFlagCount == bitFlags.Count()) << std::endl;
+}
+#pragma endregion
+
+#pragma region Flat map benchmark
+void FlatMapBench() // lookups and iteration against the node based std maps for small to big dictionaries
+{
+	std::cout << "*** FlatMap test ***\n";
+
+	const uint32_t sizes[]{ 8, 64, 512, 4096, 32768, 262144, 1000000 };
+	const uint32_t nrLookups = 1 << 20;
+	Timer timer{};
+	std::mt19937 rng{ 42 };
+
+	for (uint32_t size : sizes)
+	{
+		std::vector<uint32_t> keys(size);
+		for (uint32_t& key : keys)
+		{
+			key = static_cast<uint32_t>(rng());
+		}
+		std::vector<uint32_t> lookups(nrLookups);
+		for (uint32_t& lookup : lookups)
+		{
+			lookup = keys[rng() % size];
+		}
+
+		Container::FlatMap<uint32_t, uint32_t> flatMap{};
+		std::map<uint32_t, uint32_t> treeMap{};
+		std::unordered_map<uint32_t, uint32_t> hashMap{};
+		std::vector<std::pair<uint32_t, uint32_t>> pairs{};
+		for (uint32_t i{}; i < size; ++i)
+		{
+			pairs.emplace_back(keys[i], i);
+			treeMap.emplace(keys[i], i);
+			hashMap.emplace(keys[i], i);
+		}
+		flatMap.InsertUnsorted(pairs.begin(), pairs.end());
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint32_t lookup : lookups)
+		{
+			checksum += *flatMap.Find(lookup);
+		}
+		const double flatLookup = timer.Stop();
+
+		timer.Start();
+		for (uint32_t lookup : lookups)
+		{
+			checksum += treeMap.find(lookup)->second;
+		}
+		const double treeLookup = timer.Stop();
+
+		timer.Start();
+		for (uint32_t lookup : lookups)
+		{
+			checksum += hashMap.find(lookup)->second;
+		}
+		const double hashLookup = timer.Stop();
+
+		// iterate enough passes to touch roughly the same amount of elements for every size
+		const uint32_t passes = nrLookups / size + 1;
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			const uint32_t* pValues = flatMap.Values().Data();
+			for (uint32_t i{}; i < flatMap.Size(); ++i)
+			{
+				checksum += pValues[i];
+			}
+		}
+		const double flatIterate = timer.Stop();
+
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			for (const auto& pair : treeMap)
+			{
+				checksum += pair.second;
+			}
+		}
+		const double treeIterate = timer.Stop();
+
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			for (const auto& pair : hashMap)
+			{
+				checksum += pair.second;
+			}
+		}
+		const double hashIterate = timer.Stop();
+
+		std::cout << "Size " << size << " (" << nrLookups << " lookups, " << passes << " iteration passes)\n";
+		std::cout << "\tLookup ms\tFlatMap: " << flatLookup << "\tstd::map: " << treeLookup << "\tstd::unordered_map: " << hashLookup << std::endl;
+		std::cout << "\tIterate ms\tFlatMap: " << flatIterate << "\tstd::map: " << treeIterate << "\tstd::unordered_map: " << hashIterate << std::endl;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Static search index benchmark
+void StaticSearchIndexBench() // sorted array lookups from L1 resident sizes up to several GB
+{
+	std::cout << "*** StaticSearchIndex test ***\n";
+
+	// the biggest size needs about 2 GB for the sorted keys, 2 GB for the index keys and 1 GB for the positions
+	const uint32_t minSizeLog2 = 10;
+	const uint32_t maxSizeLog2 = 28;
+	const uint32_t nrLookups = 1 << 22;
+	Timer timer{};
+	std::mt19937_64 rng{ 42 };
+
+	for (uint32_t sizeLog2{ minSizeLog2 }; sizeLog2 <= maxSizeLog2; sizeLog2 += 2)
+	{
+		const uint32_t size = 1u << sizeLog2;
+		Container::Vector<uint64_t> sorted{ size };
+		uint64_t key{};
+		for (uint32_t i{}; i < size; ++i)
+		{
+			key += 1 + rng() % 16;
+			sorted.PushBack(key);
+		}
+		std::vector<uint64_t> lookups(nrLookups);
+		for (uint64_t& lookup : lookups)
+		{
+			lookup = rng() % (key + 1);
+		}
+
+		const Container::StaticSearchIndex<uint64_t> index{ sorted };
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint64_t lookup : lookups)
+		{
+			checksum += std::lower_bound(sorted.Data(), sorted.Data() + size, lookup) - sorted.Data();
+		}
+		const double stdTime = timer.Stop();
+
+		timer.Start();
+		for (uint64_t lookup : lookups)
+		{
+			checksum -= Container::LowerBound(sorted.Data(), size, lookup, std::less<uint64_t>{});
+		}
+		const double branchlessTime = timer.Stop();
+
+		timer.Start();
+		for (uint64_t lookup : lookups)
+		{
+			checksum += index.LowerBound(lookup);
+		}
+		const double eytzingerTime = timer.Stop();
+
+		std::cout << "Size 2^" << sizeLog2 << " (" << (uint64_t{ size } * sizeof(uint64_t) >> 10) << " KB)";
+		std::cout << "\tns per lookup\tstd::lower_bound: " << stdTime * 1e6 / nrLookups;
+		std::cout << "\tbranchless binary: " << branchlessTime * 1e6 / nrLookups;
+		std::cout << "\tEytzinger: " << eytzingerTime * 1e6 / nrLookups;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Unordered map benchmark
+void UnorderedMapBench() // hits, misses, inserts and erases against the chained std::unordered_map
+{
+	std::cout << "*** UnorderedMap test ***\n";
+
+	const uint32_t sizes[]{ 1024, 65536, 1 << 20, 1 << 23 };
+	const uint32_t nrLookups = 1 << 22;
+	Timer timer{};
+	std::mt19937_64 rng{ 42 };
+
+	for (uint32_t size : sizes)
+	{
+		// odd keys are in the maps, even keys never are
+		std::vector<uint64_t> keys(size);
+		for (uint64_t& key : keys)
+		{
+			key = rng() | 1;
+		}
+		std::vector<uint64_t> hits(nrLookups);
+		std::vector<uint64_t> misses(nrLookups);
+		for (uint32_t i{}; i < nrLookups; ++i)
+		{
+			hits[i] = keys[rng() % size];
+			misses[i] = rng() & ~uint64_t{ 1 };
+		}
+
+		Container::UnorderedMap<uint64_t, uint64_t> swissMap{};
+		std::unordered_map<uint64_t, uint64_t> stdMap{};
+
+		timer.Start();
+		for (uint32_t i{}; i < size; ++i)
+		{
+			swissMap[keys[i]] = i;
+		}
+		const double swissInsert = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < size; ++i)
+		{
+			stdMap[keys[i]] = i;
+		}
+		const double stdInsert = timer.Stop();
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint64_t hit : hits)
+		{
+			checksum += swissMap.Find(hit)->second;
+		}
+		const double swissHit = timer.Stop();
+
+		timer.Start();
+		for (uint64_t hit : hits)
+		{
+			checksum += stdMap.find(hit)->second;
+		}
+		const double stdHit = timer.Stop();
+
+		timer.Start();
+		for (uint64_t miss : misses)
+		{
+			checksum += swissMap.Contains(miss);
+		}
+		const double swissMiss = timer.Stop();
+
+		timer.Start();
+		for (uint64_t miss : misses)
+		{
+			checksum += stdMap.count(miss);
+		}
+		const double stdMiss = timer.Stop();
+
+		timer.Start();
+		for (uint64_t key : keys)
+		{
+			checksum += swissMap.Erase(key);
+		}
+		const double swissErase = timer.Stop();
+
+		timer.Start();
+		for (uint64_t key : keys)
+		{
+			checksum += stdMap.erase(key);
+		}
+		const double stdErase = timer.Stop();
+
+		std::cout << "Size " << size << " (" << nrLookups << " lookups)\n";
+		std::cout << "\tInsert ms\tUnorderedMap: " << swissInsert << "\tstd::unordered_map: " << stdInsert << std::endl;
+		std::cout << "\tHit ms\t\tUnorderedMap: " << swissHit << "\tstd::unordered_map: " << stdHit << std::endl;
+		std::cout << "\tMiss ms\t\tUnorderedMap: " << swissMiss << "\tstd::unordered_map: " << stdMiss << std::endl;
+		std::cout << "\tErase ms\tUnorderedMap: " << swissErase << "\tstd::unordered_map: " << stdErase << std::endl;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Hash map churn benchmark
+void HashMapChurnBench() // steady size with one insert and one erase per step, tombstones pile up in the Swiss table
+{
+	std::cout << "*** Hash map churn test ***\n";
+
+	const uint32_t sizes[]{ 1024, 65536, 1 << 20 };
+	const uint32_t nrSteps = 1 << 22;
+	Timer timer{};
+	std::mt19937_64 rng{ 42 };
+
+	for (uint32_t size : sizes)
+	{
+		// step i erases the key inserted size steps earlier, every key is random so the erases land all over the table
+		std::vector<uint64_t> keys(size + nrSteps);
+		for (uint64_t& key : keys)
+		{
+			key = rng();
+		}
+
+		Container::RobinHoodMap<uint64_t, uint64_t> robinHoodMap{};
+		Container::UnorderedMap<uint64_t, uint64_t> swissMap{};
+		std::unordered_map<uint64_t, uint64_t> stdMap{};
+		for (uint32_t i{}; i < size; ++i)
+		{
+			robinHoodMap[keys[i]] = i;
+			swissMap[keys[i]] = i;
+			stdMap[keys[i]] = i;
+		}
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			robinHoodMap[keys[size + i]] = i;
+			checksum += robinHoodMap.Erase(keys[i]);
+		}
+		const double robinHoodTime = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			swissMap[keys[size + i]] = i;
+			checksum += swissMap.Erase(keys[i]);
+		}
+		const double swissTime = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			stdMap[keys[size + i]] = i;
+			checksum += stdMap.erase(keys[i]);
+		}
+		const double stdTime = timer.Stop();
+
+		// lookups after the churn show how much the leftover tombstones slow down probing
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			checksum += robinHoodMap.Contains(keys[i]) + robinHoodMap.Contains(keys[nrSteps + i % size]);
+		}
+		const double robinHoodLookup = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			checksum += swissMap.Contains(keys[i]) + swissMap.Contains(keys[nrSteps + i % size]);
+		}
+		const double swissLookup = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrSteps; ++i)
+		{
+			checksum += stdMap.count(keys[i]) + stdMap.count(keys[nrSteps + i % size]);
+		}
+		const double stdLookup = timer.Stop();
+
+		std::cout << "Size " << size << " (" << nrSteps << " insert/erase steps)\n";
+		std::cout << "\tChurn ms\tRobinHoodMap: " << robinHoodTime << "\tUnorderedMap: " << swissTime << "\tstd::unordered_map: " << stdTime << std::endl;
+		std::cout << "\tLookup ms\tRobinHoodMap: " << robinHoodLookup << "\tUnorderedMap: " << swissLookup << "\tstd::unordered_map: " << stdLookup << std::endl;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Concurrent map benchmark
+void ConcurrentMapBench() // throughput from 1 to 64 threads, sharded locks against one lock around the whole map
+{
+	std::cout << "*** ConcurrentUnorderedMap test ***\n";
+
+	const uint32_t nrKeys = 1 << 20;
+	const uint32_t opsPerThread = 1 << 19;
+	const uint32_t threadCounts[]{ 1, 2, 4, 8, 16, 32, 64 };
+	// percentage of the operations that write, half of those insert or update and the other half erase
+	const uint32_t writePercentages[]{ 5, 50 };
+	Timer timer{};
+
+	for (uint32_t writePercentage : writePercentages)
+	{
+		std::cout << (writePercentage < 50 ? "Read mostly" : "Write heavy") << " (" << writePercentage << "% writes)\n";
+		for (uint32_t nrThreads : threadCounts)
+		{
+			Container::ConcurrentUnorderedMap<uint64_t, uint64_t> shardedMap{ 256 };
+			Container::UnorderedMap<uint64_t, uint64_t> lockedMap{};
+			std::shared_mutex globalMutex{};
+			shardedMap.Reserve(nrKeys);
+			lockedMap.Reserve(nrKeys);
+			for (uint64_t k{}; k < nrKeys; k += 2)
+			{
+				shardedMap.Insert(k, k);
+				lockedMap[k] = k;
+			}
+
+			std::atomic<uint64_t> checksum{};
+			const auto runThreads = [&](auto operation)
+			{
+				std::vector<std::thread> threads{};
+				timer.Start();
+				for (uint32_t t{}; t < nrThreads; ++t)
+				{
+					threads.emplace_back([&, t]()
+						{
+							std::mt19937_64 rng{ t };
+							uint64_t localSum{};
+							for (uint32_t i{}; i < opsPerThread; ++i)
+							{
+								const uint64_t random = rng();
+								localSum += operation(random % nrKeys, static_cast<uint32_t>(random >> 32) % 100);
+							}
+							checksum += localSum;
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				return timer.Stop();
+			};
+
+			const double shardedTime = runThreads([&](uint64_t k, uint32_t roll) -> uint64_t
+				{
+					if (roll < writePercentage / 2)
+					{
+						return shardedMap.Erase(k);
+					}
+					if (roll < writePercentage)
+					{
+						return shardedMap.Upsert(k, k, [](uint64_t& v) { ++v; });
+					}
+					uint64_t v{};
+					return shardedMap.Find(k, v) ? v : 0;
+				});
+
+			const double lockedTime = runThreads([&](uint64_t k, uint32_t roll) -> uint64_t
+				{
+					if (roll < writePercentage / 2)
+					{
+						std::unique_lock lock{ globalMutex };
+						return lockedMap.Erase(k);
+					}
+					if (roll < writePercentage)
+					{
+						std::unique_lock lock{ globalMutex };
+						const auto result = lockedMap.TryEmplace(k, k);
+						if (!result.second)
+						{
+							++result.first->second;
+						}
+						return result.second;
+					}
+					std::shared_lock lock{ globalMutex };
+					const auto it = lockedMap.Find(k);
+					return it != lockedMap.End() ? it->second : 0;
+				});
+
+			const double totalOps = static_cast<double>(nrThreads) * opsPerThread;
+			std::cout << "\t" << nrThreads << " threads\tMops/s\tsharded: " << totalOps / shardedTime * 0.001;
+			std::cout << "\tglobal lock: " << totalOps / lockedTime * 0.001 << "\tChecksum: " << checksum << std::endl;
+		}
+	}
+}
+#pragma endregion
+
+#pragma region List benchmark
+namespace
+{
+	struct CacheEntry final : public Container::ListHook
+	{
+		uint64_t key;
+		uint64_t payload;
+	};
+}
+
+void ListBench() // an LRU that moves every hit to the front and recycles the back, and plain iteration
+{
+	std::cout << "*** List test ***\n";
+
+	const uint32_t sizes[]{ 1024, 65536, 1 << 20 };
+	const uint32_t nrAccesses = 1 << 22;
+	Timer timer{};
+	std::mt19937 rng{ 42 };
+
+	for (uint32_t size : sizes)
+	{
+		std::vector<uint32_t> accesses(nrAccesses);
+		for (uint32_t& access : accesses)
+		{
+			access = rng() % size;
+		}
+
+		// LRU: hits move to the front, every 4th access evicts the back and inserts a new front node
+		Container::List<uint64_t> list{};
+		std::list<uint64_t> stdList{};
+		std::vector<Container::List<uint64_t>::iterator> listNodes{};
+		std::vector<std::list<uint64_t>::iterator> stdNodes{};
+		std::vector<CacheEntry> entries(size);
+		Container::IntrusiveList<CacheEntry> intrusiveList{};
+		for (uint32_t i{}; i < size; ++i)
+		{
+			list.PushBack(i);
+			listNodes.push_back(--list.End());
+			stdList.push_back(i);
+			stdNodes.push_back(--stdList.end());
+			entries[i].key = i;
+			intrusiveList.PushBack(entries[i]);
+		}
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint32_t i{}; i < nrAccesses; ++i)
+		{
+			list.MoveToFront(listNodes[accesses[i]]);
+			if ((i & 3) == 0)
+			{
+				// the value is the slot of the entry, the evicted slot gets reused for a new node at the front
+				const uint64_t slot = list.Back();
+				list.PopBack();
+				list.PushFront(slot);
+				listNodes[slot] = list.Begin();
+				checksum += slot;
+			}
+		}
+		const double listLru = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrAccesses; ++i)
+		{
+			stdList.splice(stdList.begin(), stdList, stdNodes[accesses[i]]);
+			if ((i & 3) == 0)
+			{
+				const uint64_t slot = stdList.back();
+				stdList.pop_back();
+				stdList.push_front(slot);
+				stdNodes[slot] = stdList.begin();
+				checksum += slot;
+			}
+		}
+		const double stdLru = timer.Stop();
+
+		timer.Start();
+		for (uint32_t i{}; i < nrAccesses; ++i)
+		{
+			intrusiveList.MoveToFront(entries[accesses[i]]);
+			if ((i & 3) == 0)
+			{
+				// the entries are the slots, so there is nothing to allocate
+				CacheEntry& evicted = intrusiveList.PopBack();
+				intrusiveList.PushFront(evicted);
+				checksum += evicted.key;
+			}
+		}
+		const double intrusiveLru = timer.Stop();
+
+		// iterating the lists after all those moves, the nodes are scattered over the heap by now
+		const uint32_t passes = nrAccesses / size;
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			for (auto it = list.CBegin(); it != list.CEnd(); ++it)
+			{
+				checksum += *it;
+			}
+		}
+		const double listIterate = timer.Stop();
+
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			for (uint64_t value : stdList)
+			{
+				checksum += value;
+			}
+		}
+		const double stdIterate = timer.Stop();
+
+		timer.Start();
+		for (uint32_t pass{}; pass < passes; ++pass)
+		{
+			for (auto it = intrusiveList.CBegin(); it != intrusiveList.CEnd(); ++it)
+			{
+				checksum += it->key;
+			}
+		}
+		const double intrusiveIterate = timer.Stop();
+		intrusiveList.Clear();
 
+		std::cout << "Size " << size << " (" << nrAccesses << " accesses, " << passes << " iteration passes)\n";
+		std::cout << "\tLRU ms\t\tList: " << listLru << "\tstd::list: " << stdLru << "\tIntrusiveList: " << intrusiveLru << std::endl;
+		std::cout << "\tIterate ms\tList: " << listIterate << "\tstd::list: " << stdIterate << "\tIntrusiveList: " << intrusiveIterate << std::endl;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
 }
+#pragma endregion
+
+#pragma region Pool allocator benchmark
+void PoolAllocatorBench() // building and tearing down node based containers with and without the slab pool
+{
+	std::cout << "*** PoolAllocator test ***\n";
+
+	const uint32_t sizes[]{ 1024, 65536, 1 << 20 };
+	const uint32_t nodesPerSize = 1 << 22;
+	Timer timer{};
+	std::mt19937 rng{ 42 };
+
+	for (uint32_t size : sizes)
+	{
+		const uint32_t rounds = nodesPerSize / size;
+		std::vector<uint32_t> keys(size);
+		for (uint32_t& key : keys)
+		{
+			key = static_cast<uint32_t>(rng());
+		}
+
+		uint64_t checksum{};
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			std::map<uint32_t, uint32_t> map{};
+			for (uint32_t key : keys)
+			{
+				map.emplace(key, round);
+			}
+			checksum += map.size();
+		}
+		const double mapDefault = timer.Stop();
+
+		// one pool for all rounds, like a long lived container that gets refilled
+		Container::PoolAllocator<std::pair<const uint32_t, uint32_t>> mapAllocator{};
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			std::map<uint32_t, uint32_t, std::less<uint32_t>, Container::PoolAllocator<std::pair<const uint32_t, uint32_t>>> map{ mapAllocator };
+			for (uint32_t key : keys)
+			{
+				map.emplace(key, round);
+			}
+			checksum += map.size();
+		}
+		const double mapPool = timer.Stop();
+
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			std::list<uint32_t> list{};
+			for (uint32_t key : keys)
+			{
+				list.push_back(key);
+			}
+			checksum += list.size();
+		}
+		const double listDefault = timer.Stop();
+
+		Container::PoolAllocator<uint32_t> listAllocator{};
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			std::list<uint32_t, Container::PoolAllocator<uint32_t>> list{ listAllocator };
+			for (uint32_t key : keys)
+			{
+				list.push_back(key);
+			}
+			checksum += list.size();
+		}
+		const double listPool = timer.Stop();
+
+		// a fresh Container::List every round, so its own free list can't help
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			Container::List<uint32_t> list{};
+			for (uint32_t key : keys)
+			{
+				list.PushBack(key);
+			}
+			checksum += list.Size();
+		}
+		const double containerListDefault = timer.Stop();
+
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			Container::List<uint32_t, Container::PoolAllocator<uint32_t>> list{ listAllocator };
+			for (uint32_t key : keys)
+			{
+				list.PushBack(key);
+			}
+			checksum += list.Size();
+		}
+		const double containerListPool = timer.Stop();
 
+		std::cout << "Size " << size << " (" << rounds << " rounds)\n";
+		std::cout << "\tstd::map ms\tstd::allocator: " << mapDefault << "\tPoolAllocator: " << mapPool << std::endl;
+		std::cout << "\tstd::list ms\tstd::allocator: " << listDefault << "\tPoolAllocator: " << listPool << std::endl;
+		std::cout << "\tList ms\t\tstd::allocator: " << containerListDefault << "\tPoolAllocator: " << containerListPool << std::endl;
+		std::cout << "\tChecksum: " << checksum << std::endl;
+	}
+}
 #pragma endregion
-#endif // Testing
 
-#ifdef Benchmarking
-void PushBackBench();
-void ResizeBench();
-double CalcAverage(double* pTimes, const int count, double& totalTimeOut);
+#pragma region Arena allocator benchmark
+void ArenaBench() // request handlers that build a few temporary vectors and throw them away at the end
+{
+	std::cout << "*** ArenaAllocator test ***\n";
 
-class Timer
+	const uint32_t requestCount = 200000;
+	const uint32_t vectorsPerRequest = 24;
+	Timer timer{};
+	std::mt19937 rng{ 42 };
+	std::vector<uint32_t> lengths(vectorsPerRequest);
+	for (uint32_t& length : lengths)
+	{
+		length = 8 + rng() % 120;
+	}
+
+	uint64_t checksum{};
+	timer.Start();
+	for (uint32_t request{}; request < requestCount; ++request)
+	{
+		for (uint32_t length : lengths)
+		{
+			Container::Vector<uint32_t> vector{};
+			for (uint32_t i{}; i < length; ++i)
+			{
+				vector.PushBack(i ^ request);
+			}
+			checksum += vector.Back();
+		}
+	}
+	const double heapTime = timer.Stop();
+
+	Container::Arena arena{};
+	Container::ArenaAllocator<uint32_t> allocator{ arena };
+	timer.Start();
+	for (uint32_t request{}; request < requestCount; ++request)
+	{
+		Container::ArenaScope scope{ arena };
+		for (uint32_t length : lengths)
+		{
+			Container::Vector<uint32_t, Container::ArenaAllocator<uint32_t>> vector{ allocator };
+			for (uint32_t i{}; i < length; ++i)
+			{
+				vector.PushBack(i ^ request);
+			}
+			checksum += vector.Back();
+		}
+	}
+	const double arenaTime = timer.Stop();
+
+	std::cout << requestCount << " requests with " << vectorsPerRequest << " temporary vectors each\n";
+	std::cout << "\tstd::allocator ms: " << heapTime << "\tArenaAllocator ms: " << arenaTime << std::endl;
+	std::cout << "\tArena blocks: " << arena.BlockCount() << "\tChecksum: " << checksum << std::endl;
+}
+#pragma endregion
+
+#pragma region Thread caching allocator benchmark
+template<typename allocator>
+double ThreadedVectorChurn(uint32_t threadCount, uint32_t vectorsPerThread, uint64_t& checksumOut)
 {
+	std::atomic<uint64_t> checksum{ 0 };
+	std::vector<std::thread> threads{};
+	threads.reserve(threadCount);
+	Timer timer{};
+	timer.Start();
+	for (uint32_t threadIdx{}; threadIdx < threadCount; ++threadIdx)
+	{
+		threads.emplace_back([&checksum, vectorsPerThread, threadIdx]()
+			{
+				uint64_t localSum{};
+				for (uint32_t vectorIdx{}; vectorIdx < vectorsPerThread; ++vectorIdx)
+				{
+					Container::Vector<uint32_t, allocator> vector{};
+					const uint32_t length = 1 + (vectorIdx * 7 + threadIdx) % 48;
+					for (uint32_t i{}; i < length; ++i)
+					{
+						vector.PushBack(i);
+					}
+					localSum += vector.Back();
+				}
+				checksum.fetch_add(localSum, std::memory_order_relaxed);
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	const double time = timer.Stop();
+	checksumOut += checksum.load();
+	return time;
+}
 
-public:
-	Timer()
-		: m_StartPoint{}
+void ThreadCachingAllocatorBench() // lots of small vectors built and destroyed on every thread
+{
+	std::cout << "*** ThreadCachingAllocator test ***\n";
+
+	const uint32_t totalVectors = 1 << 21;
+	const uint32_t threadCounts[]{ 1, 2, 4, 8, 16, 32, 64 };
+	uint64_t checksum{};
+
+	for (uint32_t threadCount : threadCounts)
 	{
+		// the total amount of work stays the same, so perfect scaling divides the time by the amount of cores
+		const uint32_t vectorsPerThread = totalVectors / threadCount;
+		const double defaultTime = ThreadedVectorChurn<std::allocator<uint32_t>>(threadCount, vectorsPerThread, checksum);
+		const double cachingTime = ThreadedVectorChurn<Container::ThreadCachingAllocator<uint32_t>>(threadCount, vectorsPerThread, checksum);
+		std::cout << threadCount << " threads, " << vectorsPerThread << " vectors each\n";
+		std::cout << "\tstd::allocator ms: " << defaultTime << " (" << totalVectors / defaultTime / 1000.0 << " M vectors/s)"
+			<< "\tThreadCachingAllocator ms: " << cachingTime << " (" << totalVectors / cachingTime / 1000.0 << " M vectors/s)" << std::endl;
+	}
+	std::cout << "\tSlabs: " << Container::ThreadCaching::CentralPool::Get().SlabCount() << "\tChecksum: " << checksum << std::endl;
+}
+#pragma endregion
 
+#pragma region Aligned vector benchmark
+// y = a * x + y over count floats, the aligned version may only be given 32 byte aligned pointers
+template<bool aligned>
+void Saxpy(float a, const float* pX, float* pY, uint32_t count)
+{
+	uint32_t i{};
+#if CONTAINER_AVX
+	const __m256 factor = _mm256_set1_ps(a);
+	for (; i + 8 <= count; i += 8)
+	{
+		if constexpr (aligned)
+		{
+			_mm256_store_ps(pY + i, _mm256_add_ps(_mm256_mul_ps(factor, _mm256_load_ps(pX + i)), _mm256_load_ps(pY + i)));
+		}
+		else
+		{
+			_mm256_storeu_ps(pY + i, _mm256_add_ps(_mm256_mul_ps(factor, _mm256_loadu_ps(pX + i)), _mm256_loadu_ps(pY + i)));
+		}
+	}
+#elif CONTAINER_SSE2
+	const __m128 factor = _mm_set1_ps(a);
+	for (; i + 4 <= count; i += 4)
+	{
+		if constexpr (aligned)
+		{
+			_mm_store_ps(pY + i, _mm_add_ps(_mm_mul_ps(factor, _mm_load_ps(pX + i)), _mm_load_ps(pY + i)));
+		}
+		else
+		{
+			_mm_storeu_ps(pY + i, _mm_add_ps(_mm_mul_ps(factor, _mm_loadu_ps(pX + i)), _mm_loadu_ps(pY + i)));
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		pY[i] = a * pX[i] + pY[i];
 	}
+}
 
-	~Timer()
+void AlignedVectorBench() // the same SIMD kernel on cache line aligned vectors and on data that straddles cache lines
+{
+	std::cout << "*** AlignedAllocator test ***\n";
+
+	// from L1 sized to memory sized, the split loads only really show while the data is in cache
+	const uint32_t sizes[]{ 2048, 32768, 1 << 22 };
+	const uint64_t floatsPerSize = 1ull << 31;
+	Timer timer{};
+
+	for (uint32_t size : sizes)
 	{
+		const uint32_t rounds = static_cast<uint32_t>(floatsPerSize / size);
+
+		Container::Vector<float, Container::AlignedAllocator<float>> alignedX(size, 1.f);
+		Container::Vector<float, Container::AlignedAllocator<float>> alignedY(size, 0.f);
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			Saxpy<true>(0.5f, alignedX.Data(), alignedY.Data(), size);
+		}
+		const double alignedTime = timer.Stop();
+
+		// operator new only guarantees 16 bytes, starting one float in makes part of the loads and stores cross a cache line
+		Container::Vector<float> unalignedX(size + 1, 1.f);
+		Container::Vector<float> unalignedY(size + 1, 0.f);
+		timer.Start();
+		for (uint32_t round{}; round < rounds; ++round)
+		{
+			Saxpy<false>(0.5f, unalignedX.Data() + 1, unalignedY.Data() + 1, size);
+		}
+		const double unalignedTime = timer.Stop();
+
+		const double gigaFloats = static_cast<double>(rounds) * size / 1e9;
+		std::cout << "Size " << size << " floats (" << rounds << " rounds)\n";
+		std::cout << "\taligned ms: " << alignedTime << " (" << gigaFloats / alignedTime * 1000.0 << " GFloat/s)"
+			<< "\tunaligned ms: " << unalignedTime << " (" << gigaFloats / unalignedTime * 1000.0 << " GFloat/s)" << std::endl;
+		std::cout << "\tChecksum: " << alignedY[size - 1] + unalignedY[size] << std::endl;
 	}
+}
+#pragma endregion
 
-	void Start()
+
+#pragma region Vector matrix benchmark
+// 64 bytes of plain data, both vectors can relocate it with a memcpy
+struct MatrixPod
+{
+	MatrixPod() = default;
+	explicit MatrixPod(uint32_t value)
+		: values{ value }
 	{
-		m_StartPoint = std::chrono::high_resolution_clock::now();
 	}
 
-	double Stop()
+	uint64_t values[8];
+};
+
+// Owns a heap buffer, a copy allocates and copies it while a move only takes the pointer
+// Vector needs copyable elements, so this stands in for a move only type. Its move is noexcept, so std::vector moves it
+// when it grows or shifts, where Vector memcpys it
+class MatrixHeavy
+{
+public:
+	MatrixHeavy()
+		: MatrixHeavy(0)
 	{
-		auto endTimePoint = std::chrono::high_resolution_clock::now();
+	}
+
+	explicit MatrixHeavy(uint32_t value)
+		: m_pPayload{ std::make_unique<uint64_t[]>(PayloadCount) }
+	{
+		m_pPayload[0] = value;
+	}
+
+	MatrixHeavy(const MatrixHeavy& other)
+		: m_pPayload{}
+	{
+		CopyPayload(other);
+	}
+
+	MatrixHeavy(MatrixHeavy&& other) noexcept = default;
+
+	MatrixHeavy& operator=(const MatrixHeavy& other)
+	{
+		if (this != &other)
+		{
+			CopyPayload(other);
+		}
+		return *this;
+	}
+
+	MatrixHeavy& operator=(MatrixHeavy&& other) noexcept = default;
 
-		auto startTime = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartPoint).time_since_epoch().count();
-		auto endTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimePoint).time_since_epoch().count();
-		auto duration = endTime - startTime;
-		double ms = duration * 0.001;
-		return ms;
+	uint64_t Value() const
+	{
+		return m_pPayload ? m_pPayload[0] : 0;
 	}
+
 private:
+	void CopyPayload(const MatrixHeavy& other)
+	{
+		if (!other.m_pPayload)
+		{
+			m_pPayload.reset();
+			return;
+		}
+		if (!m_pPayload)
+		{
+			m_pPayload = std::make_unique<uint64_t[]>(PayloadCount);
+		}
+		std::copy(other.m_pPayload.get(), other.m_pPayload.get() + PayloadCount, m_pPayload.get());
+	}
 
-	std::chrono::time_point<std::chrono::high_resolution_clock> m_StartPoint;
+	static constexpr uint32_t PayloadCount = 8;
+	std::unique_ptr<uint64_t[]> m_pPayload;
 };
 
-#pragma region  Pushback Benchmarking
-void PushBackBench()
+template<typename type>
+type MakeMatrixElement(uint32_t i)
+{
+	if constexpr (std::is_same_v<type, std::string>)
+	{
+		return std::string(32, static_cast<char>('a' + i % 26)); // too long for the small string buffer
+	}
+	else
+	{
+		return type(i);
+	}
+}
+
+template<typename type>
+uint64_t MatrixChecksum(const type& element)
 {
+	if constexpr (std::is_same_v<type, std::string>)
+	{
+		return element.size() + static_cast<uint8_t>(element.empty() ? 0 : element[0]);
+	}
+	else if constexpr (std::is_same_v<type, MatrixPod>)
+	{
+		return element.values[0];
+	}
+	else if constexpr (std::is_same_v<type, MatrixHeavy>)
+	{
+		return element.Value();
+	}
+	else
 	{
-		std::cout << "*** Push back test ***\n";
-		const int nrTests = 10000;
-		const int nrPushes = 1000;
+		return static_cast<uint64_t>(element);
+	}
+}
 
+// Gives both vectors the same interface, so every cell runs the exact same code
+template<typename vector>
+struct MatrixOps;
 
-		Timer timer{};
-		double* pMyVecTimes = new double[nrTests]();
-		for (int test = 0; test < nrTests; ++test)
+template<typename type>
+struct MatrixOps<Container::Vector<type>>
+{
+	using vector = Container::Vector<type>;
+	static constexpr const char* Name = "Container::Vector";
+
+	static void PushBack(vector& vec, const type& value) { vec.PushBack(value); }
+	template<typename... args>
+	static void EmplaceBack(vector& vec, args&&... arguments) { vec.EmplaceBack(std::forward<args>(arguments)...); }
+	static void Insert(vector& vec, uint32_t index, const type& value) { vec.Insert(vec.CBegin() + static_cast<int32_t>(index), value); }
+	static void Erase(vector& vec, uint32_t index) { vec.Erase(vec.CBegin() + static_cast<int32_t>(index)); }
+	static void PopBack(vector& vec) { vec.PopBack(); }
+	static void Resize(vector& vec, uint32_t size) { vec.Resize(size); }
+	static const type* Data(const vector& vec) { return vec.Data(); }
+	static uint64_t Iterate(vector& vec)
+	{
+		uint64_t sum{};
+		for (auto it = vec.Begin(); it != vec.End(); ++it)
 		{
-			Container::Vector<int> vec{  };
-			vec.Reserve(nrPushes);
-			timer.Start();
-			for (int i = 0; i < nrPushes; ++i)
-			{
-				vec.PushBack(i);
-			}
-			pMyVecTimes[test] = timer.Stop();
+			sum += MatrixChecksum(*it);
+		}
+		return sum;
+	}
+};
+
+template<typename type>
+struct MatrixOps<std::vector<type>>
+{
+	using vector = std::vector<type>;
+	static constexpr const char* Name = "std::vector";
+
+	static void PushBack(vector& vec, const type& value) { vec.push_back(value); }
+	template<typename... args>
+	static void EmplaceBack(vector& vec, args&&... arguments) { vec.emplace_back(std::forward<args>(arguments)...); }
+	static void Insert(vector& vec, uint32_t index, const type& value) { vec.insert(vec.cbegin() + index, value); }
+	static void Erase(vector& vec, uint32_t index) { vec.erase(vec.cbegin() + index); }
+	static void PopBack(vector& vec) { vec.pop_back(); }
+	static void Resize(vector& vec, uint32_t size) { vec.resize(size); }
+	static const type* Data(const vector& vec) { return vec.data(); }
+	static uint64_t Iterate(vector& vec)
+	{
+		uint64_t sum{};
+		for (auto it = vec.begin(); it != vec.end(); ++it)
+		{
+			sum += MatrixChecksum(*it);
 		}
-		double myTotalTime{};
-		std::cout << "My Vector average:\t" << CalcAverage(pMyVecTimes, nrTests, myTotalTime) << std::endl;
-		std::cout << "My Vector total time:\t" << myTotalTime << std::endl;
+		return sum;
+	}
+};
+
+enum class MatrixOp : uint32_t
+{
+	PushBack,
+	EmplaceBack,
+	InsertFront,
+	InsertMiddle,
+	InsertBack,
+	EraseMiddle,
+	Copy,
+	Move,
+	Resize,
+	Iterate,
+	Count
+};
 
-		double* pStlVecTimes = new double[nrTests]();
+constexpr uint32_t MatrixOpCount = static_cast<uint32_t>(MatrixOp::Count);
+constexpr const char* MatrixOpNames[MatrixOpCount]{ "PushBack", "EmplaceBack", "Insert front", "Insert middle", "Insert back",
+	"Erase middle", "Copy", "Move", "Resize", "Iterate" };
+constexpr uint32_t MatrixSizes[]{ 10, 1000, 100000, 10000000 };
+constexpr uint32_t MatrixSizeCount = static_cast<uint32_t>(std::size(MatrixSizes));
+
+// Runs every operation on a vector of size elements and stores the median ns per iteration of each
+// PushBack, EmplaceBack, Copy and Resize build (and destroy) a whole vector of size elements per iteration
+// The inserts and the erase change one element per iteration, and pop or push one at the back so the size stays the same
+template<typename vector, typename type>
+void RunMatrixCells(Benchmark::Runner& runner, const char* typeName, const std::vector<type>& values, double (&medians)[MatrixOpCount])
+{
+	using ops = MatrixOps<vector>;
+	const uint32_t size = static_cast<uint32_t>(values.size());
+	const std::string suffix = std::string{ "/" } + ops::Name + "<" + typeName + ">/" + std::to_string(size);
+	vector prepared{};
+	for (const type& value : values)
+	{
+		ops::PushBack(prepared, value);
+	}
+	const type value = MakeMatrixElement<type>(size);
 
-		for (int test = 0; test < nrTests; ++test)
+	auto run = [&](MatrixOp op, auto body)
+		{
+			medians[static_cast<uint32_t>(op)] = runner.Run(MatrixOpNames[static_cast<uint32_t>(op)] + suffix, body).stats.median;
+		};
+	auto shift = [&](uint32_t index)
+		{
+			return [&prepared, &value, index](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						ops::Insert(prepared, index, value);
+						ops::PopBack(prepared);
+					}
+					Benchmark::DoNotOptimize(ops::Data(prepared));
+				};
+		};
+
+	run(MatrixOp::PushBack, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				vector vec{};
+				for (uint32_t i{}; i < size; ++i)
+				{
+					ops::PushBack(vec, values[i]);
+				}
+				Benchmark::DoNotOptimize(ops::Data(vec));
+			}
+		});
+	run(MatrixOp::EmplaceBack, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				vector vec{};
+				for (uint32_t i{}; i < size; ++i)
+				{
+					if constexpr (std::is_same_v<type, std::string>)
+					{
+						ops::EmplaceBack(vec, size_t{ 32 }, static_cast<char>('a' + i % 26));
+					}
+					else
+					{
+						ops::EmplaceBack(vec, i);
+					}
+				}
+				Benchmark::DoNotOptimize(ops::Data(vec));
+			}
+		});
+	run(MatrixOp::InsertFront, shift(0));
+	run(MatrixOp::InsertMiddle, shift(size / 2));
+	run(MatrixOp::InsertBack, shift(size));
+	run(MatrixOp::EraseMiddle, [&](uint64_t iterations)
 		{
-			std::vector<int> vec{ };
-			vec.reserve(nrPushes);
-			timer.Start();
-			for (int i = 0; i < nrPushes; ++i)
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
 			{
-				vec.push_back(i);
+				ops::Erase(prepared, size / 2);
+				ops::PushBack(prepared, value);
 			}
-			pStlVecTimes[test] = timer.Stop();
+			Benchmark::DoNotOptimize(ops::Data(prepared));
+		});
+	run(MatrixOp::Copy, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				vector copy{ prepared };
+				Benchmark::DoNotOptimize(ops::Data(copy));
+			}
+		});
+	run(MatrixOp::Move, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				vector moved{ std::move(prepared) };
+				Benchmark::DoNotOptimize(ops::Data(moved));
+				prepared = std::move(moved);
+			}
+		});
+	run(MatrixOp::Resize, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				vector vec{};
+				ops::Resize(vec, size);
+				Benchmark::DoNotOptimize(ops::Data(vec));
+			}
+		});
+	run(MatrixOp::Iterate, [&](uint64_t iterations)
+		{
+			for (uint64_t iteration{}; iteration < iterations; ++iteration)
+			{
+				Benchmark::DoNotOptimize(ops::Iterate(prepared));
+			}
+		});
+}
+
+// Prints std::vector time / Vector time for every operation and size, above 1 means Vector is faster
+void PrintMatrixTable(const char* typeName, const double (&ours)[MatrixSizeCount][MatrixOpCount], const double (&theirs)[MatrixSizeCount][MatrixOpCount])
+{
+	const Benchmark::StreamFormatGuard formatGuard{ std::cout };
+	std::cout << "\nstd::vector / Container::Vector median time, element type " << typeName << "\n";
+	std::cout << std::left << std::setw(16) << "operation" << std::right;
+	for (uint32_t size : MatrixSizes)
+	{
+		std::cout << std::setw(12) << size;
+	}
+	std::cout << "\n" << std::fixed << std::setprecision(2);
+	for (uint32_t op{}; op < MatrixOpCount; ++op)
+	{
+		std::cout << std::left << std::setw(16) << MatrixOpNames[op] << std::right;
+		for (uint32_t sizeIdx{}; sizeIdx < MatrixSizeCount; ++sizeIdx)
+		{
+			std::cout << std::setw(11) << theirs[sizeIdx][op] / ours[sizeIdx][op] << "x";
+		}
+		std::cout << "\n";
+	}
+	std::cout << std::endl;
+}
+
+template<typename type>
+void MatrixTypeBench(Benchmark::Runner& runner, const char* typeName)
+{
+	double ours[MatrixSizeCount][MatrixOpCount]{};
+	double theirs[MatrixSizeCount][MatrixOpCount]{};
+	for (uint32_t sizeIdx{}; sizeIdx < MatrixSizeCount; ++sizeIdx)
+	{
+		std::vector<type> values{};
+		values.reserve(MatrixSizes[sizeIdx]);
+		for (uint32_t i{}; i < MatrixSizes[sizeIdx]; ++i)
+		{
+			values.push_back(MakeMatrixElement<type>(i));
 		}
+		RunMatrixCells<Container::Vector<type>>(runner, typeName, values, ours[sizeIdx]);
+		RunMatrixCells<std::vector<type>>(runner, typeName, values, theirs[sizeIdx]);
+	}
+	PrintMatrixTable(typeName, ours, theirs);
+}
 
-		double stlTotalTime{};
-		std::cout << "STL vector average:\t" << CalcAverage(pStlVecTimes, nrTests, stlTotalTime) << std::endl;
-		std::cout << "STL Vector total time:\t" << stlTotalTime << std::endl;
+void VectorMatrixBench() // every Vector operation for every element type and size against std::vector
+{
+	std::cout << "*** Vector matrix test ***\n";
+
+	// a few hundred cells and some of them take a second per iteration, so fewer and shorter samples than the other benchmarks
+	Benchmark::Options options{};
+	options.sampleCount = 7;
+	options.minSampleMs = 5;
+	options.warmupMs = 5;
+	Benchmark::Runner runner{ options };
+	MatrixTypeBench<int>(runner, "int");
+	MatrixTypeBench<MatrixPod>(runner, "64 byte POD");
+	MatrixTypeBench<std::string>(runner, "std::string");
+	MatrixTypeBench<MatrixHeavy>(runner, "heavy");
+
+	if (!runner.WriteFiles("benchmark_matrix"))
+	{
+		std::cout << "Couldn't write the matrix results" << std::endl;
 	}
 }
 #pragma endregion
 
-#pragma region Resize benchmark
-void ResizeBench() // to check how fast the reallocate functions are comparered to std::vector
+template<typename allocator>
+void PageReserveFill(const char* name, const allocator& alloc, uint32_t count)
+{
+	Timer timer{};
+	Container::Vector<uint64_t, allocator> vector{ alloc };
+	int64_t faults = Container::MinorPageFaults();
+	timer.Start();
+	vector.Reserve(count);
+	const double reserveTime = timer.Stop();
+	const int64_t reserveFaults = Container::MinorPageFaults() - faults;
+
+	faults = Container::MinorPageFaults();
+	timer.Start();
+	for (uint32_t i{}; i < count; ++i)
+	{
+		vector.PushBack(i);
+	}
+	const double fillTime = timer.Stop();
+	const int64_t fillFaults = Container::MinorPageFaults() - faults;
+
+	uint64_t checksum{};
+	for (uint32_t i{}; i < count; i += 4096)
+	{
+		checksum += vector[i];
+	}
+	const Benchmark::StreamFormatGuard formatGuard{ std::cout };
+	std::cout << "\t" << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+		<< "reserve " << std::setw(7) << reserveTime << " ms " << std::setw(8) << reserveFaults << " faults   "
+		<< "fill " << std::setw(7) << fillTime << " ms " << std::setw(8) << fillFaults << " faults   (" << checksum % 10 << ")\n";
+}
+
+void PageAllocatorBench() // where the page faults of a huge buffer land: in Reserve or in the first writes
 {
-	std::cout << "*** Resize test ***\n";
+	std::cout << "*** PageAllocator test ***\n";
+
+	const uint32_t count = 64 * 1024 * 1024; // 512 MB of uint64_t
+	using Container::PageOptions;
+	using PageAllocator = Container::PageAllocator<uint64_t>;
+	std::cout << "Reserve and fill " << count * sizeof(uint64_t) / (1024 * 1024) << " MB, " << Container::PageSize() << " byte pages\n";
+	PageReserveFill("std::allocator", std::allocator<uint64_t>{}, count);
+	PageReserveFill("PageAllocator None", PageAllocator{ PageOptions::None }, count);
+	PageReserveFill("PageAllocator Prefault", PageAllocator{ PageOptions::Prefault }, count);
+	PageReserveFill("PageAllocator HugePages", PageAllocator{ PageOptions::HugePages }, count);
+	PageReserveFill("PageAllocator Prefault|Huge", PageAllocator{ PageOptions::Prefault | PageOptions::HugePages }, count);
+	PageReserveFill("PageAllocator Lock", PageAllocator{ PageOptions::Lock }, count);
+	std::cout << "\tallocations that couldn't be locked: " << PageAllocator::LockFailures() << "\n";
+}
+
+void MemoryCopyBench(Benchmark::Runner& runner) // every size class of CopyBytes and MoveBytes against the libc functions
+{
+	std::cout << "*** MemoryCopy test ***\n";
 
-	const int nrTests = 100000;
-	const int size = 100000;
-	double* pMyVecTimes = new double[nrTests]{};
+	const Container::CpuFeatures& features = Container::GetCpuFeatures();
+	std::cout << "AVX2 " << features.avx2 << ", ERMS " << features.erms << ", non-temporal from " << Container::NonTemporalThreshold() / 1024 << " KB\n";
 
+	// two sizes per class: tiny, AVX2 loop, rep movsb and streaming
+	const size_t sizes[]{ 8, 48, 256, 2048, 16384, 262144, 2 * Container::NonTemporalThreshold() };
+	std::vector<uint8_t> source(sizes[std::size(sizes) - 1] + 64, 1);
+	std::vector<uint8_t> dest(source.size(), 0);
+	double throughput[std::size(sizes)][4]{};
 
-	Timer timer{};
+	for (size_t sizeIndex{}; sizeIndex < std::size(sizes); ++sizeIndex)
 	{
-		Container::Vector<int> myVec{};
-		myVec.PushBack(0);
-		for (int i{}; i < nrTests; ++i)
+		// read back through a volatile, so the compiler can't turn memcpy with a known size into a few moves
+		volatile size_t opaqueSize = sizes[sizeIndex];
+		const size_t size = opaqueSize;
+		const std::string suffix = "/" + std::to_string(size) + " bytes";
+		uint8_t* pSrc = source.data();
+		uint8_t* pDest = dest.data();
+
+		const double times[4]{
+			runner.Run("MemoryCopy/CopyBytes" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						Container::CopyBytes(pDest, pSrc, size);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			runner.Run("MemoryCopy/memcpy" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						std::memcpy(pDest, pSrc, size);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			// shifting up by one element, like Insert does
+			runner.Run("MemoryCopy/MoveBytes overlapping" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						Container::MoveBytes(pDest + 8, pDest, size);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			runner.Run("MemoryCopy/memmove overlapping" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						std::memmove(pDest + 8, pDest, size);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median };
+		for (size_t i{}; i < 4; ++i)
 		{
-			timer.Start();
-			myVec.Reserve(size);
-			myVec.ShrinkToFit();
-			pMyVecTimes[i] = timer.Stop();
+			throughput[sizeIndex][i] = static_cast<double>(size) / times[i];
 		}
-		double myTotalTime{  };
-		std::cout << "My Vector average:\t" << CalcAverage(pMyVecTimes, nrTests, myTotalTime) << std::endl;
-		std::cout << "My Vector total time:\t" << myTotalTime << std::endl;
 	}
 
+	const Benchmark::StreamFormatGuard formatGuard{ std::cout };
+	std::cout << "\nGB/s" << std::setw(16) << "CopyBytes" << std::setw(12) << "memcpy" << std::setw(12) << "MoveBytes" << std::setw(12) << "memmove" << "\n"
+		<< std::fixed << std::setprecision(2);
+	for (size_t sizeIndex{}; sizeIndex < std::size(sizes); ++sizeIndex)
 	{
-		std::vector<int> stlVec{};
-		stlVec.push_back(0);
-		double* pStlVecTimes = new double[nrTests] {};
-		for (int i{}; i < nrTests; ++i)
+		std::cout << std::setw(10) << sizes[sizeIndex];
+		for (double value : throughput[sizeIndex])
 		{
-			timer.Start();
-			stlVec.reserve(size);
-			stlVec.shrink_to_fit();
-			pStlVecTimes[i] = timer.Stop();
+			std::cout << std::setw(12) << value;
 		}
-		double stdVecTotalTime{};
-		std::cout << "STL Vector average:\t" << CalcAverage(pStlVecTimes, nrTests, stdVecTotalTime) << std::endl;
-		std::cout << "STL Vector total time:\t" << stdVecTotalTime << std::endl;
+		std::cout << "\n";
 	}
-
-	// Results on my reallocation are generally slightly slower than std::vector
-	// I think the reallocation isn't actually faster but the shrink to fit in std::vector checks if the vector is empty
-	// and deletes all data instead of reallocating 
-	// When I try to do the same test with 1 element in the vector mine is faster
-	// I am considering copying what STL does but it seems like an edge case and 
-	// will cause branching in all other cases which can actually be a performance loss
 }
-#pragma endregion
 
-
-double CalcAverage(double* pTimes, const int count, double& totalTimeOut)
+void SimdDispatchBench(Benchmark::Runner& runner) // every kernel family on every tier the CPU supports, 16 KB stays in L1 so the kernels are measured and not the memory
 {
-	totalTimeOut = 0.0;
-	for (int i = 0; i < count; ++i)
+	std::cout << "*** SIMD dispatch test ***\n";
+	std::cout << "Supported tier " << Container::SimdTierNames[static_cast<uint32_t>(Container::SupportedTier())]
+		<< ", active tier " << Container::SimdTierNames[static_cast<uint32_t>(Container::ActiveTier())] << " (CONTAINER_SIMD_TIER lowers it)\n";
+
+	const size_t bytes = 16384;
+	const size_t count = bytes / sizeof(uint32_t);
+	std::vector<uint32_t> lhs(count, 1);
+	std::vector<uint32_t> rhs(count, 1);
+	// fill and copy write here, so lhs and rhs stay equal for compare
+	std::vector<uint32_t> scratch(count);
+	// the wanted value only at the end, so find reads everything
+	lhs[count - 1] = 2;
+	rhs[count - 1] = 2;
+	const uint64_t pattern = Container::Detail::RepeatPattern(uint32_t{ 2 });
+
+	const char* familyNames[]{ "fill", "find", "compare", "copy" };
+	double throughput[Container::SimdTierCount][std::size(familyNames)]{};
+	const uint32_t supported = static_cast<uint32_t>(Container::SupportedTier());
+	for (uint32_t tier{}; tier <= supported; ++tier)
 	{
-		totalTimeOut += pTimes[i];
+		const std::string suffix = std::string{ "/" } + Container::SimdTierNames[tier] + "/" + std::to_string(bytes) + " bytes";
+		const Container::Detail::FillKernel fill = Container::Detail::FillKernels[tier];
+		const Container::Detail::FindKernel find = Container::Detail::FindKernels<uint32_t>[tier];
+		const Container::Detail::EqualKernel equal = Container::Detail::EqualKernels[tier];
+		const Container::Detail::CopyKernel copy = Container::Detail::CopyKernels[tier];
+		uint32_t* pLhs = lhs.data();
+		uint32_t* pRhs = rhs.data();
+		uint32_t* pScratch = scratch.data();
+
+		const double times[]{
+			runner.Run("Dispatch/fill" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						fill(pScratch, pattern, bytes);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			runner.Run("Dispatch/find" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						Benchmark::DoNotOptimize(find(pLhs, pattern, count));
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			runner.Run("Dispatch/compare" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						Benchmark::DoNotOptimize(equal(pLhs, pRhs, bytes));
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median,
+			runner.Run("Dispatch/copy" + suffix, [=](uint64_t iterations)
+				{
+					for (uint64_t iteration{}; iteration < iterations; ++iteration)
+					{
+						copy(reinterpret_cast<char*>(pScratch), reinterpret_cast<const char*>(pLhs), bytes);
+						Benchmark::ClobberMemory();
+					}
+				}).stats.median };
+		for (size_t family{}; family < std::size(familyNames); ++family)
+		{
+			throughput[tier][family] = static_cast<double>(bytes) / times[family];
+		}
 	}
 
-	return totalTimeOut / count;
+	const Benchmark::StreamFormatGuard formatGuard{ std::cout };
+	std::cout << "\nGB/s    ";
+	for (const char* pFamily : familyNames)
+	{
+		std::cout << std::setw(10) << pFamily;
+	}
+	std::cout << "\n" << std::fixed << std::setprecision(1);
+	for (uint32_t tier{}; tier <= supported; ++tier)
+	{
+		std::cout << std::left << std::setw(8) << Container::SimdTierNames[tier] << std::right;
+		for (double value : throughput[tier])
+		{
+			std::cout << std::setw(10) << value;
+		}
+		std::cout << "\n";
+	}
 }
 
-
 int main()
 {
-	PushBackBench();
-	ResizeBench();
+	Benchmark::Runner runner{};
+	PushBackBench(runner);
+	PushBackLatencyBench();
+	ResizeBench(runner);
+	BitVectorBench(runner);
+	FlatMapBench();
+	StaticSearchIndexBench();
+	UnorderedMapBench();
+	HashMapChurnBench();
+	ConcurrentMapBench();
+	ListBench();
+	PoolAllocatorBench();
+	ArenaBench();
+	ThreadCachingAllocatorBench();
+	AlignedVectorBench();
+	VectorMatrixBench();
+	PageAllocatorBench();
+	MemoryCopyBench(runner);
+	SimdDispatchBench(runner);
+
+	if (!runner.WriteFiles("benchmark_results"))
+	{
+		std::cout << "Couldn't write benchmark_results.csv and benchmark_results.json" << std::endl;
+	}
 }
 
 #endif // Benchmarking